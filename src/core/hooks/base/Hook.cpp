@@ -32,35 +32,60 @@ bool Hook::saveOriginalBytes(void* address, size_t size)
     return true;
 }
 
-bool Hook::restoreOriginalBytes()
+bool Hook::writePatch(void* address, const void* code, size_t size)
 {
-    if (m_originalBytes.empty() || !m_targetAddress)
+    m_patch.clear();
+    m_patch.write(reinterpret_cast<uintptr_t>(address), code, size);
+    if (!m_patch.commit(*m_memory))
     {
+        setError(HookError::WriteMemory);
+        LogManager::instance().error(QString("Failed to write patch at 0x%1: %2")
+                                         .arg(QString::number(reinterpret_cast<uintptr_t>(address), 16))
+                                         .arg(QString::fromStdString(m_patch.error())),
+                                     "Hooks");
+        m_patch.clear();
         return false;
     }
 
-    DWORD oldProtect;
-    if (!setMemoryProtection(m_targetAddress, m_originalBytes.size(), PAGE_EXECUTE_READWRITE))
+    m_targetAddress = address;
+    m_originalBytes.resize(size);
+    m_patch.original(reinterpret_cast<uintptr_t>(address), m_originalBytes.data(), size);
+    return true;
+}
+
+bool Hook::restoreOriginalBytes()
+{
+    if (m_patch.isCommitted())
     {
-        return false;
+        if (!m_patch.rollback(*m_memory))
+        {
+            setError(HookError::WriteMemory);
+            LogManager::instance().error(QString("Failed to restore original bytes at 0x%1: %2")
+                                             .arg(QString::number(reinterpret_cast<uintptr_t>(m_targetAddress), 16))
+                                             .arg(QString::fromStdString(m_patch.error())),
+                                         "Hooks");
+            return false;
+        }
+        m_patch.clear();
+        return true;
     }
 
-    if (!m_memory->WriteMemory(
-            reinterpret_cast<uintptr_t>(m_targetAddress), m_originalBytes.data(), m_originalBytes.size()))
+    if (m_originalBytes.empty() || !m_targetAddress)
     {
-        setError(HookError::WriteMemory);
-        LogManager::instance().error(QString("Failed to restore original bytes at 0x%1")
-                                         .arg(QString::number(reinterpret_cast<uintptr_t>(m_targetAddress), 16)),
-                                     "Hooks");
-
-        // Восстанавливаем права доступа
-        setMemoryProtection(m_targetAddress, m_originalBytes.size(), oldProtect);
         return false;
     }
 
-    // Восстанавливаем права доступа
-    if (!setMemoryProtection(m_targetAddress, m_originalBytes.size(), oldProtect))
+    // Патч записан в обход writePatch(): сохранённые байты пишутся транзакцией,
+    // которая сама снимает и возвращает исходные права доступа
+    WriteTransaction restore;
+    restore.write(reinterpret_cast<uintptr_t>(m_targetAddress), m_originalBytes.data(), m_originalBytes.size());
+    if (!restore.commit(*m_memory))
     {
+        setError(HookError::WriteMemory);
+        LogManager::instance().error(QString("Failed to restore original bytes at 0x%1: %2")
+                                         .arg(QString::number(reinterpret_cast<uintptr_t>(m_targetAddress), 16))
+                                         .arg(QString::fromStdString(restore.error())),
+                                     "Hooks");
         return false;
     }
 
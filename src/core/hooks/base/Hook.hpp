@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "core/memory/MemoryManager.hpp"
+#include "core/memory/WriteTransaction.hpp"
 #include "Types.hpp"
 
 
@@ -54,8 +55,18 @@ class Hook
      */
     bool saveOriginalBytes(void* address, size_t size);
 
+    /**
+     * @brief Записывает патч одной транзакцией, запоминая оригинальные байты
+     * @param address Адрес патча (становится m_targetAddress)
+     * @param code Байты патча
+     * @param size Размер патча
+     * @details Права доступа снимаются и возвращаются транзакцией; при ошибке память не меняется
+     */
+    bool writePatch(void* address, const void* code, size_t size);
+
     /**
      * @brief Восстанавливает оригинальные байты
+     * @details Откатывает патч writePatch(); если патч записан иначе, пишет m_originalBytes
      */
     bool restoreOriginalBytes();
 
@@ -70,4 +81,5 @@ class Hook
     HookError                      m_lastError{HookError::None}; ///< Последняя ошибка
     void*                          m_targetAddress{nullptr};     ///< Целевой адрес
     std::vector<uint8_t>           m_originalBytes;              ///< Оригинальные байты
+    WriteTransaction               m_patch;                      ///< Записанный патч и его исходные байты
 };
\ No newline at end of file
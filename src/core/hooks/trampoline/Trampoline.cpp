@@ -1,5 +1,6 @@
 #include "Trampoline.hpp"
 
+#include "core/memory/WriteTransaction.hpp"
 #include "gui/log/LogManager.hpp"
 
 
@@ -15,8 +16,8 @@ bool Trampoline::allocate(size_t size)
     // Освобождаем старый трамплин если был
     free();
 
-    // Выделяем память с правами execute
-    m_address = m_memory->AllocateMemory(nullptr, size, PAGE_EXECUTE_READWRITE);
+    // Исполняемый кусок из арены: трамплины разных хуков делят один блок
+    m_address = reinterpret_cast<void*>(m_memory->AllocateCode(size));
     if (!m_address)
     {
         LogManager::instance().error(QString("Failed to allocate trampoline memory of size %1").arg(size), "Hooks");
@@ -35,7 +36,7 @@ void Trampoline::free()
 {
     if (m_address)
     {
-        m_memory->FreeMemory(m_address);
+        m_memory->FreeArenaMemory(reinterpret_cast<uintptr_t>(m_address));
         m_address = nullptr;
         m_size    = 0;
     }
@@ -48,10 +49,14 @@ bool Trampoline::write(const void* code, size_t size)
         return false;
     }
 
-    if (!m_memory->WriteMemory(reinterpret_cast<uintptr_t>(m_address), code, size))
+    // Страницы арены не доступны для записи: права снимает и возвращает транзакция
+    WriteTransaction transaction;
+    transaction.write(reinterpret_cast<uintptr_t>(m_address), code, size);
+    if (!transaction.commit(*m_memory))
     {
-        LogManager::instance().error(QString("Failed to write code to trampoline at 0x%1")
-                                         .arg(QString::number(reinterpret_cast<uintptr_t>(m_address), 16)),
+        LogManager::instance().error(QString("Failed to write code to trampoline at 0x%1: %2")
+                                         .arg(QString::number(reinterpret_cast<uintptr_t>(m_address), 16))
+                                         .arg(QString::fromStdString(transaction.error())),
                                      "Hooks");
         return false;
     }
@@ -25,6 +25,7 @@ class Trampoline
      * @brief Выделяет память под трамплин
      * @param size Необходимый размер
      * @return true если память выделена успешно
+     * @details Память берётся из исполняемого пула арены (MemoryManager::AllocateCode)
      */
     bool allocate(size_t size);
 
@@ -0,0 +1,174 @@
+#include "AsyncReader.hpp"
+
+#include <exception>
+
+#include <QDebug>
+
+#include "MemoryManager.hpp"
+
+
+void AsyncTask::promise_type::unhandled_exception()
+{
+    try
+    {
+        throw;
+    }
+    catch (const std::exception& e)
+    {
+        qDebug() << "Unhandled exception in async task:" << e.what();
+    }
+    catch (...)
+    {
+        qDebug() << "Unhandled unknown exception in async task";
+    }
+}
+
+
+AsyncReader::AsyncReader(std::unique_ptr<MemoryManager> memory, AsyncReaderOptions options)
+    : m_memory(std::move(memory)), m_options(options), m_thread(&AsyncReader::run, this)
+{
+}
+
+AsyncReader::~AsyncReader()
+{
+    stop();
+
+    // Ожидающие корутины доводятся до конца: новые операции после stop() завершаются сразу
+    while (dispatch() != 0)
+    {
+    }
+}
+
+bool AsyncReader::submit(AsyncReadOperation& operation)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_stopping)
+        {
+            operation.succeeded = 0;
+            for (ReadRequest& request : operation.requests)
+            {
+                request.succeeded = false;
+            }
+            return false;
+        }
+
+        m_pending.push_back(&operation);
+        m_pendingRequests += operation.requests.size();
+        m_stats.maxQueueDepth = std::max(m_stats.maxQueueDepth, m_pendingRequests);
+    }
+    m_queued.notify_one();
+    return true;
+}
+
+size_t AsyncReader::dispatch(std::chrono::milliseconds timeout)
+{
+    std::vector<AsyncReadOperation*> ready;
+    {
+        std::unique_lock lock(m_mutex);
+        if (m_completed.empty() && timeout.count() > 0)
+        {
+            m_ready.wait_for(lock, timeout, [this] { return !m_completed.empty(); });
+        }
+        ready.swap(m_completed);
+    }
+
+    // Возобновлённая корутина может сразу поставить следующую операцию - мьютекс уже отпущен
+    for (AsyncReadOperation* operation : ready)
+    {
+        operation->handle.resume();
+    }
+    return ready.size();
+}
+
+void AsyncReader::setWakeup(std::function<void()> wakeup)
+{
+    std::lock_guard lock(m_mutex);
+    m_wakeup = std::move(wakeup);
+}
+
+void AsyncReader::stop()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_queued.notify_one();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+AsyncReaderStats AsyncReader::stats() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+void AsyncReader::run()
+{
+    std::vector<AsyncReadOperation*> batch;
+    std::vector<ReadRequest>         requests;
+
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_queued.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+        if (m_pending.empty())
+        {
+            break; // stop() и очередь пуста
+        }
+
+        // Окно сбора: операции, пришедшие следом, попадут в тот же пакет
+        if (!m_stopping && m_options.window.count() > 0)
+        {
+            m_queued.wait_for(lock,
+                              m_options.window,
+                              [this] { return m_stopping || m_pendingRequests >= m_options.maxBatchSize; });
+        }
+
+        batch.swap(m_pending);
+        m_pendingRequests = 0;
+        lock.unlock();
+
+        requests.clear();
+        for (const AsyncReadOperation* operation : batch)
+        {
+            requests.insert(requests.end(), operation->requests.begin(), operation->requests.end());
+        }
+
+        const BatchReadStats batchStats = m_memory->ReadBatch(requests);
+
+        // Результаты раскладываются обратно по операциям (буферы уже заполнены ReadBatch)
+        size_t index = 0;
+        for (AsyncReadOperation* operation : batch)
+        {
+            operation->succeeded = 0;
+            for (ReadRequest& request : operation->requests)
+            {
+                request.succeeded = requests[index++].succeeded;
+                operation->succeeded += request.succeeded;
+            }
+        }
+
+        lock.lock();
+        m_stats.operations += batch.size();
+        m_stats.requests += requests.size();
+        m_stats.batches++;
+        m_stats.reads += batchStats.mergedReads;
+        m_stats.failedRequests += batchStats.failedRequests;
+        m_stats.bytesRead += batchStats.bytesRead;
+        m_completed.insert(m_completed.end(), batch.begin(), batch.end());
+        batch.clear();
+
+        const std::function<void()> wakeup = m_wakeup;
+        lock.unlock();
+        m_ready.notify_all();
+        if (wakeup)
+        {
+            wakeup();
+        }
+        lock.lock();
+    }
+}
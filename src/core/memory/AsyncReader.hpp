@@ -0,0 +1,254 @@
+/**
+ * @file AsyncReader.hpp
+ * @brief Асинхронное чтение памяти процесса: очередь, поток ввода-вывода и awaitable для C++20-корутин
+ * @details Пример (корутина в потоке GUI, возобновляется из dispatch()):
+ * @code
+ * AsyncTask refreshTarget(AsyncReader& reader, uintptr_t unit)
+ * {
+ *     ReadResult<uint64_t> target = co_await reader.readAsync<uint64_t>(unit + 0x48);
+ *     ReadResult<uint32_t> health = co_await reader.readAsync<uint32_t>(unit + 0x60);
+ *     ...
+ * }
+ * @endcode
+ */
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ReadBatch.hpp"
+#include "ReadResult.hpp"
+
+class MemoryManager;
+class AsyncReader;
+
+
+/**
+ * @brief Корутина без результата, запускаемая сразу и уничтожающая себя по завершении
+ * @details Исключение, вышедшее из корутины, записывается в лог и поглощается: корутина
+ * возобновляется из AsyncReader::dispatch(), и исключение не должно прерывать обработку остальных
+ */
+struct AsyncTask
+{
+    struct promise_type
+    {
+        AsyncTask          get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void               return_void() {}
+        void               unhandled_exception();
+    };
+};
+
+/**
+ * @brief Операция в очереди AsyncReader (хранится в awaitable, то есть в кадре корутины)
+ */
+struct AsyncReadOperation
+{
+    std::span<ReadRequest>  requests;     ///< Запросы операции
+    std::coroutine_handle<> handle;       ///< Ожидающая корутина
+    size_t                  succeeded{0}; ///< Успешные запросы (заполняется потоком чтения)
+};
+
+/**
+ * @brief Параметры AsyncReader
+ */
+struct AsyncReaderOptions
+{
+    std::chrono::microseconds window{200};       ///< Окно сбора запросов в один пакет (0 - без ожидания)
+    size_t                    maxBatchSize{512}; ///< Пакет отправляется сразу, как только набрано столько запросов
+};
+
+/**
+ * @brief Статистика AsyncReader
+ */
+struct AsyncReaderStats
+{
+    uint64_t operations{0};     ///< Выполненные операции (co_await)
+    uint64_t requests{0};       ///< Выполненные запросы
+    uint64_t batches{0};        ///< Вызовы ReadBatch
+    uint64_t reads{0};          ///< Фактические чтения после объединения
+    uint64_t failedRequests{0}; ///< Неудачные запросы
+    uint64_t bytesRead{0};      ///< Прочитано байт
+    size_t   maxQueueDepth{0};  ///< Наибольшее количество запросов в очереди
+};
+
+/**
+ * @brief Ожидание чтения значения типа T
+ * @details Результат co_await - ReadResult<T>. Объект ссылается сам на себя, поэтому не копируется
+ * и не перемещается: он живёт в кадре корутины до её возобновления.
+ */
+template <typename T>
+class ReadAwaitable
+{
+    static_assert(std::is_trivially_copyable_v<T>, "readAsync requires a trivially copyable type");
+
+  public:
+    ReadAwaitable(AsyncReader& reader, uintptr_t address) : m_reader(reader)
+    {
+        m_request.address     = address;
+        m_request.size        = sizeof(T);
+        m_request.destination = &m_value;
+        m_operation.requests  = std::span<ReadRequest>(&m_request, 1);
+    }
+
+    ReadAwaitable(const ReadAwaitable&)            = delete;
+    ReadAwaitable& operator=(const ReadAwaitable&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle);
+
+    ReadResult<T> await_resume() const
+    {
+        if (!m_request.succeeded)
+        {
+            return ReadError::Failed;
+        }
+        return m_value;
+    }
+
+  private:
+    AsyncReader&       m_reader;    ///< Очередь
+    T                  m_value{};   ///< Буфер значения
+    ReadRequest        m_request;   ///< Запрос
+    AsyncReadOperation m_operation; ///< Операция
+};
+
+/**
+ * @brief Ожидание пакета запросов
+ * @details Результат co_await - количество успешных запросов; буферы и поля succeeded запросов
+ * заполняются до возобновления. Запросы должны жить до возобновления корутины.
+ */
+class BatchAwaitable
+{
+  public:
+    BatchAwaitable(AsyncReader& reader, std::span<ReadRequest> requests) : m_reader(reader)
+    {
+        m_operation.requests = requests;
+    }
+
+    BatchAwaitable(const BatchAwaitable&)            = delete;
+    BatchAwaitable& operator=(const BatchAwaitable&) = delete;
+
+    bool   await_ready() const noexcept { return m_operation.requests.empty(); }
+    bool   await_suspend(std::coroutine_handle<> handle);
+    size_t await_resume() const { return m_operation.succeeded; }
+
+  private:
+    AsyncReader&       m_reader;    ///< Очередь
+    AsyncReadOperation m_operation; ///< Операция
+};
+
+/**
+ * @class AsyncReader
+ * @brief Очередь чтений с собственным потоком ввода-вывода
+ * @details Корутина, выполнившая co_await, ставит операцию в очередь и приостанавливается - вызывающий
+ * поток не ждёт системного вызова. Поток чтения забирает все операции, пришедшие за окно сбора
+ * (AsyncReaderOptions::window), и выполняет их одним MemoryManager::ReadBatch, так что соседние
+ * поля разных корутин читаются одним чтением. Готовые корутины не возобновляются в потоке чтения:
+ * их возобновляет dispatch() в потоке владельца (для Qt - в потоке GUI по сигналу из setWakeup()).
+ * AsyncReader владеет собственным менеджером памяти: MemoryManager не потокобезопасен, и поток
+ * чтения - единственный его пользователь.
+ * При уничтожении очередь дочитывается, а ожидающие корутины возобновляются; новые операции после
+ * stop() завершаются сразу с ошибкой.
+ */
+class AsyncReader
+{
+  public:
+    /**
+     * @brief Запускает поток чтения
+     * @param memory Менеджер памяти, используемый только потоком чтения
+     */
+    explicit AsyncReader(std::unique_ptr<MemoryManager> memory, AsyncReaderOptions options = {});
+    ~AsyncReader();
+
+    AsyncReader(const AsyncReader&)            = delete;
+    AsyncReader& operator=(const AsyncReader&) = delete;
+
+    /**
+     * @brief Чтение значения: co_await reader.readAsync<T>(address) -> ReadResult<T>
+     */
+    template <typename T>
+    ReadAwaitable<T> readAsync(uintptr_t address)
+    {
+        return ReadAwaitable<T>(*this, address);
+    }
+
+    /**
+     * @brief Пакет запросов: co_await reader.readBatchAsync(requests) -> количество успешных
+     */
+    BatchAwaitable readBatchAsync(std::span<ReadRequest> requests) { return BatchAwaitable(*this, requests); }
+
+    /**
+     * @brief Ставит операцию в очередь
+     * @return false после stop(): операция не поставлена, корутина не приостанавливается
+     */
+    bool submit(AsyncReadOperation& operation);
+
+    /**
+     * @brief Возобновляет корутины, чьи операции выполнены
+     * @param timeout Сколько ждать первой готовой операции, если готовых нет
+     * @return Количество возобновлённых корутин
+     */
+    size_t dispatch(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Задаёт функцию, вызываемую потоком чтения, когда появились готовые операции
+     * @details Например, QMetaObject::invokeMethod(owner, [...] { reader.dispatch(); }, Qt::QueuedConnection)
+     */
+    void setWakeup(std::function<void()> wakeup);
+
+    /**
+     * @brief Останавливает поток чтения, дочитав очередь
+     */
+    void stop();
+
+    /**
+     * @brief Статистика
+     */
+    AsyncReaderStats stats() const;
+
+  private:
+    /**
+     * @brief Цикл потока чтения
+     */
+    void run();
+
+    std::unique_ptr<MemoryManager> m_memory;  ///< Менеджер памяти потока чтения
+    AsyncReaderOptions             m_options; ///< Параметры
+
+    mutable std::mutex               m_mutex;              ///< Защищает поля ниже
+    std::condition_variable          m_queued;             ///< Пробуждение потока чтения
+    std::condition_variable          m_ready;              ///< Пробуждение dispatch()
+    std::vector<AsyncReadOperation*> m_pending;            ///< Очередь
+    size_t                           m_pendingRequests{0}; ///< Запросы в очереди
+    std::vector<AsyncReadOperation*> m_completed;          ///< Выполненные, ждущие dispatch()
+    std::function<void()>            m_wakeup;             ///< Уведомление о готовых операциях
+    bool                             m_stopping{false};    ///< stop() вызван
+    AsyncReaderStats                 m_stats;              ///< Статистика
+
+    std::thread m_thread; ///< Поток чтения (запускается последним)
+};
+
+template <typename T>
+bool ReadAwaitable<T>::await_suspend(std::coroutine_handle<> handle)
+{
+    m_operation.handle = handle;
+    return m_reader.submit(m_operation);
+}
+
+inline bool BatchAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    m_operation.handle = handle;
+    return m_reader.submit(m_operation);
+}
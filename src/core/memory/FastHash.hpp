@@ -0,0 +1,54 @@
+/**
+ * @file FastHash.hpp
+ * @brief Быстрый некриптографический 64-битный хэш
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+/**
+ * @brief Хэширует блок байтов (8 байт за шаг, перемешивание умножением)
+ * @param data Данные
+ * @param size Размер данных
+ * @param seed Начальное значение (позволяет хэшировать несколько блоков цепочкой)
+ * @return 64-битный хэш
+ * @details Используется для идентификации образов модулей, а не для защиты данных
+ */
+inline uint64_t fastHash64(const void* data, size_t size, uint64_t seed = 0)
+{
+    constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t    hash  = seed ^ (size * PRIME1);
+
+    auto mix = [](uint64_t h, uint64_t value)
+    {
+        h ^= value * PRIME2;
+        h = (h << 31) | (h >> 33);
+        return h * PRIME1;
+    };
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t value;
+        std::memcpy(&value, bytes + i, sizeof(value));
+        hash = mix(hash, value);
+    }
+
+    if (i < size)
+    {
+        uint64_t tail = 0;
+        std::memcpy(&tail, bytes + i, size - i);
+        hash = mix(hash, tail);
+    }
+
+    // Финальное перемешивание
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    return hash;
+}
@@ -1,8 +1,10 @@
 #include "MemoryManager.hpp"
 
-#include <TlHelp32.h>
+#include "FastHash.hpp"
+#include "SignatureCache.hpp"
 
 #include <algorithm>
+#include <cstring>
 
 #include <QDebug>
 
@@ -12,20 +14,22 @@
 using namespace std;
 
 
-#pragma region Initialization & Lifecycle
-MemoryManager::MemoryManager(DWORD pid) : processId(pid), baseAddress(0)
+namespace
 {
-    // Запрашиваем все необходимые права для работы с процессом
-    processHandle = OpenProcess(PROCESS_QUERY_INFORMATION | // Для получения информации о процессе
-                                    PROCESS_VM_READ |       // Для чтения памяти
-                                    PROCESS_VM_WRITE |      // Для записи в память
-                                    PROCESS_VM_OPERATION |  // Для VirtualAllocEx/VirtualFreeEx
-                                    PROCESS_CREATE_THREAD | // Для CreateRemoteThread
-                                    PROCESS_SUSPEND_RESUME, // Для управления потоками
-                                FALSE,
-                                pid);
+    /**
+     * @brief Хэш байтов и маски сигнатуры (часть ключа SignatureCache)
+     */
+    uint64_t patternHash(const BytePattern& pattern)
+    {
+        return fastHash64(pattern.mask(), pattern.size(), fastHash64(pattern.bytes(), pattern.size()));
+    }
+} // namespace
 
-    if (!processHandle)
+
+#pragma region Initialization & Lifecycle
+MemoryManager::MemoryManager(DWORD pid) : backend(std::in_place_type<ProcessBackend>, pid), processId(pid), baseAddress(0)
+{
+    if (!std::get<ProcessBackend>(backend).isOpen())
     {
         DWORD error = GetLastError();
         qDebug() << "Failed to open process" << pid << "with error:" << error;
@@ -33,29 +37,53 @@ MemoryManager::MemoryManager(DWORD pid) : processId(pid), baseAddress(0)
     }
 
     qDebug() << "Successfully opened process" << pid
-             << "with handle:" << QString::number(reinterpret_cast<quintptr>(processHandle), 16);
+             << "with handle:" << QString::number(reinterpret_cast<quintptr>(GetProcessHandle()), 16);
 
     // Получаем базовый адрес при создании
     UpdateBaseAddress();
 }
 
+MemoryManager::MemoryManager(MemoryBackend memoryBackend) : backend(std::move(memoryBackend)), baseAddress(0)
+{
+    processId = std::visit([](const auto& impl) { return impl.processId(); }, backend);
+
+    ModuleInfo info;
+    if (GetModuleInfo(L"run.exe", info))
+    {
+        baseAddress = info.base;
+    }
+    qDebug() << "Memory manager created over backend" << backend.index() << "for process" << processId
+             << "base address:" << QString::number(baseAddress, 16);
+}
+
 MemoryManager::~MemoryManager()
 {
-    if (processHandle)
+    // Отсоединение от процесса: блоки арены освобождаются одним проходом
+    ReleaseArena();
+}
+
+HANDLE MemoryManager::GetProcessHandle() const
+{
+#ifdef _WIN32
+    if (const auto* win32 = std::get_if<Win32Backend>(&backend))
     {
-        CloseHandle(processHandle);
-        processHandle = nullptr;
+        return win32->handle();
     }
+#endif
+    return nullptr;
 }
 
 // Move конструктор
 MemoryManager::MemoryManager(MemoryManager&& other) noexcept
-    : processHandle(other.processHandle), processId(other.processId), baseAddress(other.baseAddress)
+    : backend(std::move(other.backend)), processId(other.processId), baseAddress(other.baseAddress),
+      readCache(std::move(other.readCache)), readCacheEnabled(other.readCacheEnabled),
+      batchPlanner(std::move(other.batchPlanner)), lastBatchStats(other.lastBatchStats),
+      moduleHashes(std::move(other.moduleHashes)), moduleTable(std::move(other.moduleTable)),
+      arena(std::move(other.arena)), regionMap(std::move(other.regionMap)), readFailures(other.readFailures)
 {
-    // Обнуляем handle в другом объекте
-    other.processHandle = nullptr;
-    other.processId     = 0;
-    other.baseAddress   = 0;
+    // Handle процесса переехал вместе с бэкендом
+    other.processId   = 0;
+    other.baseAddress = 0;
 }
 
 // Move оператор присваивания
@@ -63,21 +91,26 @@ MemoryManager& MemoryManager::operator=(MemoryManager&& other) noexcept
 {
     if (this != &other)
     {
-        // Закрываем текущий handle если есть
-        if (processHandle)
-        {
-            CloseHandle(processHandle);
-        }
+        // Арена текущего процесса освобождается, пока его handle ещё открыт
+        ReleaseArena();
 
-        // Перемещаем данные
-        processHandle = other.processHandle;
-        processId     = other.processId;
-        baseAddress   = other.baseAddress;
+        // Перемещаем данные (текущий handle закрывается бэкендом)
+        backend          = std::move(other.backend);
+        processId        = other.processId;
+        baseAddress      = other.baseAddress;
+        readCache        = std::move(other.readCache);
+        readCacheEnabled = other.readCacheEnabled;
+        batchPlanner     = std::move(other.batchPlanner);
+        lastBatchStats   = other.lastBatchStats;
+        moduleHashes     = std::move(other.moduleHashes);
+        moduleTable      = std::move(other.moduleTable);
+        arena            = std::move(other.arena);
+        regionMap        = std::move(other.regionMap);
+        readFailures     = other.readFailures;
 
         // Обнуляем в другом объекте
-        other.processHandle = nullptr;
-        other.processId     = 0;
-        other.baseAddress   = 0;
+        other.processId   = 0;
+        other.baseAddress = 0;
     }
     return *this;
 }
@@ -101,33 +134,248 @@ uintptr_t MemoryManager::GetModuleBaseAddress(const wchar_t* moduleName)
     qDebug() << "Attempting to get module base address for" << QString::fromWCharArray(moduleName) << "in process"
              << processId;
 
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, processId);
-    if (snapshot == INVALID_HANDLE_VALUE)
+    ModuleInfo info;
+    if (!GetModuleInfo(moduleName, info))
+    {
+        qDebug() << "Module" << QString::fromWCharArray(moduleName) << "not found in process" << processId;
+        return 0;
+    }
+
+    qDebug() << "Found module" << QString::fromStdWString(info.name) << "at address:" << QString::number(info.base, 16);
+    return info.base;
+}
+
+std::vector<ModuleInfo> MemoryManager::GetModules() const
+{
+    if (!LoadModules())
+    {
+        return {};
+    }
+    return moduleTable.modules();
+}
+
+bool MemoryManager::GetModuleInfo(const wchar_t* moduleName, ModuleInfo& info)
+{
+    const bool fresh = !moduleTable.isLoaded();
+    if (!LoadModules())
     {
-        qDebug() << "Failed to create module snapshot. Error:" << GetLastError();
         ThrowLastError("Failed to create module snapshot");
     }
 
-    MODULEENTRY32W moduleEntry;
-    moduleEntry.dwSize = sizeof(moduleEntry);
+    const ModuleInfo* module = moduleTable.find(moduleName);
+    if (!module && !fresh && !moduleTable.isKnownMissing(moduleName))
+    {
+        // Модуль мог загрузиться после построения таблицы
+        if (!LoadModules(true))
+        {
+            ThrowLastError("Failed to create module snapshot");
+        }
+        module = moduleTable.find(moduleName);
+    }
+
+    if (!module)
+    {
+        moduleTable.markMissing(moduleName);
+        return false;
+    }
+    info = *module;
+    return true;
+}
+
+bool MemoryManager::RefreshModules()
+{
+    return LoadModules(true);
+}
+
+bool MemoryManager::LoadModules(bool refresh) const
+{
+    if (moduleTable.isLoaded() && !refresh)
+    {
+        return true;
+    }
+
+    std::vector<ModuleInfo> modules;
+    if (!std::visit([&modules](const auto& impl) { return impl.enumerateModules(modules); }, backend))
+    {
+        qDebug() << "Failed to enumerate modules of process" << processId << "Error:" << GetLastError();
+        return false;
+    }
+
+    qDebug() << "Module table of process" << processId << "built:" << modules.size() << "modules";
+    moduleTable.assign(std::move(modules));
+    return true;
+}
+
+const PeImage* MemoryManager::GetModuleImage(const wchar_t* moduleName)
+{
+    ModuleInfo module;
+    if (!GetModuleInfo(moduleName, module))
+    {
+        return nullptr;
+    }
+
+    const PeImage& image = GetImage(module);
+    return image.isValid() ? &image : nullptr;
+}
+
+const PeImage& MemoryManager::GetImage(const ModuleInfo& module)
+{
+    if (const PeImage* cached = moduleTable.image(module.base))
+    {
+        return *cached;
+    }
+
+    PeImage image;
+    if (image.parse(*this, module.base, module.size))
+    {
+        qDebug() << "Parsed PE image of" << QString::fromStdWString(module.name) << ":" << image.sections().size()
+                 << "sections," << image.exports().size() << "exports," << image.imports().size() << "imports in"
+                 << image.stats().reads << "reads";
+    }
+    if (!image.error().empty())
+    {
+        qDebug() << "PE image of" << QString::fromStdWString(module.name) << ":"
+                 << QString::fromStdString(image.error());
+    }
+    return moduleTable.storeImage(module.base, std::move(image));
+}
+
+uint64_t MemoryManager::GetModuleImageHash(const wchar_t* moduleName)
+{
+    ModuleInfo module;
+    if (!GetModuleInfo(moduleName, module))
+    {
+        return 0;
+    }
 
-    if (Module32FirstW(snapshot, &moduleEntry))
+    auto it = moduleHashes.find(module.base);
+    if (it != moduleHashes.end())
     {
-        do
+        return it->second;
+    }
+
+    const uint64_t hash = ComputeImageHash(module);
+    if (hash != 0)
+    {
+        moduleHashes.emplace(module.base, hash);
+        qDebug() << "Image hash of" << QString::fromStdWString(module.name) << "is" << QString::number(hash, 16);
+    }
+    return hash;
+}
+
+uint64_t MemoryManager::ComputeImageHash(const ModuleInfo& module)
+{
+    const PeImage& image = GetImage(module);
+    if (!image.isValid())
+    {
+        qDebug() << "Invalid PE headers at" << QString::number(module.base, 16);
+        return 0;
+    }
+
+    // Сборку определяют метка времени, точка входа, размер образа и таблица секций. Байты секций не хэшируются:
+    // это мегабайты чтения на каждую проверку, и хэш менялся бы от хуков, уже поставленных в .text
+    struct ImageKey
+    {
+        uint32_t timeDateStamp;
+        uint32_t entryPoint;
+        uint32_t size;
+        uint32_t sectionCount;
+    };
+    const ImageKey key{image.timeDateStamp(),
+                       static_cast<uint32_t>(image.entryPoint() ? image.entryPoint() - module.base : 0),
+                       static_cast<uint32_t>(module.size),
+                       static_cast<uint32_t>(image.sections().size())};
+    uint64_t       hash = fastHash64(&key, sizeof(key));
+
+    for (const PeSection& section : image.sections())
+    {
+        const uint32_t fields[] = {section.rva, section.virtualSize, section.characteristics};
+        hash                    = fastHash64(section.name.data(), section.name.size(), hash);
+        hash                    = fastHash64(fields, sizeof(fields), hash);
+    }
+
+    // 0 зарезервирован под "хэш неизвестен"
+    return hash ? hash : 1;
+}
+
+uintptr_t MemoryManager::ResolveSignature(const std::string& key, const BytePattern& pattern, const wchar_t* moduleName)
+{
+    const SignatureEntry entry{key, pattern};
+    return ResolveSignatures(std::span<const SignatureEntry>(&entry, 1), moduleName).front();
+}
+
+std::vector<uintptr_t> MemoryManager::ResolveSignatures(std::span<const SignatureEntry> signatures,
+                                                        const wchar_t*                  moduleName)
+{
+    std::vector<uintptr_t> results(signatures.size(), 0);
+
+    ModuleInfo module;
+    if (signatures.empty() || !GetModuleInfo(moduleName, module))
+    {
+        return results;
+    }
+
+    const uint64_t  imageHash = GetModuleImageHash(moduleName);
+    SignatureCache& cache     = SignatureCache::instance();
+
+    std::vector<uint64_t>    hashes(signatures.size());
+    std::vector<size_t>      missing;
+    std::vector<BytePattern> missingPatterns;
+    std::vector<uint8_t>     bytes;
+    for (size_t i = 0; i < signatures.size(); i++)
+    {
+        const BytePattern& pattern = signatures[i].pattern;
+        hashes[i]                  = patternHash(pattern);
+
+        uint32_t rva = 0;
+        if (imageHash != 0 && cache.lookup(imageHash, signatures[i].key, hashes[i], rva))
         {
-            if (_wcsicmp(moduleEntry.szModule, moduleName) == 0)
+            // Хэш образа не покрывает байты секций: смещение из кэша подтверждается сигнатурой в памяти
+            bytes.resize(pattern.size());
+            const uintptr_t address = module.base + rva;
+            if (rva + pattern.size() <= module.size && ReadRaw(address, bytes.data(), bytes.size()) &&
+                pattern.matches(bytes.data()))
             {
-                CloseHandle(snapshot);
-                qDebug() << "Found module" << QString::fromWCharArray(moduleEntry.szModule)
-                         << "at address:" << QString::number(reinterpret_cast<uintptr_t>(moduleEntry.modBaseAddr), 16);
-                return reinterpret_cast<uintptr_t>(moduleEntry.modBaseAddr);
+                results[i] = address;
+                continue;
             }
-        } while (Module32NextW(snapshot, &moduleEntry));
+
+            qDebug() << "Cached signature" << QString::fromStdString(signatures[i].key) << "does not match at"
+                     << QString::number(address, 16) << "in process" << processId << "- rescanning";
+            cache.remove(imageHash, signatures[i].key, hashes[i]);
+        }
+        missing.push_back(i);
+        missingPatterns.push_back(pattern);
+    }
+
+    if (missing.empty())
+    {
+        qDebug() << "All" << signatures.size() << "signatures resolved from cache for process" << processId;
+        return results;
+    }
+
+    // Все отсутствующие в кэше сигнатуры ищем одним проходом по образу
+    const MultiPatternScanner scanner(std::move(missingPatterns));
+    const auto                found = FindPatterns(scanner, module.base, module.base + module.size);
+
+    for (size_t i = 0; i < missing.size(); i++)
+    {
+        if (found[i] == 0)
+        {
+            qDebug() << "Signature" << QString::fromStdString(signatures[missing[i]].key) << "not found in process"
+                     << processId;
+            continue;
+        }
+
+        results[missing[i]] = found[i];
+        if (imageHash != 0)
+        {
+            cache.store(imageHash, signatures[missing[i]].key, hashes[missing[i]],
+                        static_cast<uint32_t>(found[i] - module.base));
+        }
     }
 
-    qDebug() << "Module" << QString::fromWCharArray(moduleName) << "not found in process" << processId;
-    CloseHandle(snapshot);
-    return 0;
+    return results;
 }
 
 uintptr_t MemoryManager::ResolveAddress(uintptr_t relativeAddress)
@@ -143,8 +391,7 @@ uintptr_t MemoryManager::ResolveAddress(uintptr_t relativeAddress)
 #pragma region Error Handling & Validation
 bool MemoryManager::IsValidAddress(uintptr_t address) const
 {
-    MEMORY_BASIC_INFORMATION mbi;
-    return VirtualQueryEx(processHandle, (LPCVOID)address, &mbi, sizeof(mbi)) != 0;
+    return QueryRegion(address) != nullptr;
 }
 
 void MemoryManager::ThrowLastError(const char* message) const
@@ -157,49 +404,183 @@ void MemoryManager::ThrowLastError(const char* message) const
 #pragma region Read Operations
 bool MemoryManager::ReadMemory(uintptr_t address, void* buffer, size_t size)
 {
-    SIZE_T bytesRead;
-    if (!ReadProcessMemory(processHandle, (LPCVOID)address, buffer, size, &bytesRead))
+    if (!ReadRaw(address, buffer, size))
     {
         qDebug() << "Failed to read memory at" << QString::number(address, 16) << "of size" << size
                  << "Error:" << GetLastError();
         return false;
     }
-    return bytesRead == size;
+    return true;
 }
 
-std::string MemoryManager::ReadString(uintptr_t address, size_t maxLength, bool isRelative)
+bool MemoryManager::ReadRaw(uintptr_t address, void* buffer, size_t size)
 {
-    uintptr_t         finalAddress = isRelative ? ResolveAddress(address) : address;
-    std::vector<char> buffer(maxLength + 1); // +1 для нуль-терминатора
+    if (!readCacheEnabled)
+    {
+        return ReadProcess(address, buffer, size);
+    }
 
-    if (!ReadMemory(finalAddress, buffer.data(), maxLength))
+    // Невалидный указатель, уже встречавшийся в этом тике, отклоняем без системного вызова.
+    // Без BeginTick() негативные записи не устаревали бы, поэтому до первого тика они не ведутся
+    const uint64_t epoch = readCache.epoch();
+    if (regionMap.isKnownUnreadable(address, epoch))
     {
-        ThrowLastError("Failed to read string");
+        SetLastError(ERROR_NOACCESS);
+        return false;
     }
 
-    // Находим нуль-терминатор
-    buffer[maxLength] = '\0'; // Гарантируем нуль-терминацию
-    size_t length     = 0;
-    while (length < maxLength && buffer[length] != '\0')
+    bool success = readCache.read(address,
+                                  buffer,
+                                  size,
+                                  [this](uintptr_t pageAddress, void* pageBuffer, size_t pageSize)
+                                  { return ReadProcess(pageAddress, pageBuffer, pageSize); });
+
+    // Страница целиком может не читаться, когда запрошенный диапазон доступен (регион кончается
+    // внутри страницы) - поэтому перед отказом читаем сам диапазон напрямую
+    if (!success)
     {
-        length++;
+        success = ReadProcess(address, buffer, size);
     }
 
-    return std::string(buffer.data(), length);
+    // Страницу запоминаем только если чтение её не покидало - иначе неизвестно, какая страница виновата
+    if (!success && size > 0 && IsTicking() && (address ^ (address + size - 1)) < RegionMap::PAGE_SIZE)
+    {
+        regionMap.markUnreadable(address, epoch);
+    }
+    return success;
+}
+
+ReadError MemoryManager::TryReadMemory(uintptr_t address, void* buffer, size_t size)
+{
+    // Нулевые 64 KiB никогда не отображены - типичный случай нулевого указателя плюс смещение
+    constexpr uintptr_t NULL_AREA_END = 0x10000;
+
+    ReadError error;
+    if (address < NULL_AREA_END)
+    {
+        error = ReadError::NullAddress;
+    }
+    else if (ReadRaw(address, buffer, size))
+    {
+        return ReadError::None;
+    }
+    else
+    {
+        switch (GetLastError())
+        {
+            case ERROR_PARTIAL_COPY:
+            case ERROR_NOACCESS:
+            case ERROR_INVALID_ADDRESS:
+                error = ReadError::InvalidAddress;
+                break;
+            case ERROR_ACCESS_DENIED:
+                error = ReadError::AccessDenied;
+                break;
+            default:
+                error = ReadError::Failed;
+                break;
+        }
+    }
+
+    readFailures.add(error);
+    return error;
+}
+
+const MemoryRegion* MemoryManager::QueryRegion(uintptr_t address) const
+{
+    return regionMap.find(address,
+                          readCache.epoch(),
+                          IsTicking(),
+                          [this](uintptr_t queryAddress, MemoryRegion& region)
+                          {
+                              return std::visit([&](const auto& impl) { return impl.query(queryAddress, region); },
+                                                backend);
+                          });
+}
+
+BatchReadStats MemoryManager::ReadBatch(std::span<ReadRequest> requests)
+{
+    BatchReadStats stats;
+    const auto&    reads = batchPlanner.plan(requests, stats);
+    const auto&    order = batchPlanner.order();
+
+    for (auto& request : requests)
+    {
+        request.succeeded = request.size == 0;
+    }
+
+    for (const auto& read : reads)
+    {
+        // Одиночный запрос читаем сразу в буфер вызывающего кода
+        if (read.first == read.last)
+        {
+            ReadRequest& request = requests[order[read.first]];
+            request.succeeded    = ReadRaw(request.address, request.destination, request.size);
+            continue;
+        }
+
+        auto& scratch = batchPlanner.scratch();
+        if (scratch.size() < read.size)
+        {
+            scratch.resize(read.size);
+        }
+
+        const bool merged = ReadRaw(read.address, scratch.data(), read.size);
+        for (size_t i = read.first; i <= read.last; i++)
+        {
+            ReadRequest& request = requests[order[i]];
+            if (merged)
+            {
+                memcpy(request.destination, scratch.data() + (request.address - read.address), request.size);
+                request.succeeded = true;
+            }
+            else
+            {
+                // Часть диапазона может быть недоступна - пробуем запросы по отдельности
+                request.succeeded = ReadRaw(request.address, request.destination, request.size);
+            }
+        }
+    }
+
+    for (const auto& request : requests)
+    {
+        if (!request.succeeded)
+        {
+            stats.failedRequests++;
+        }
+    }
+
+    lastBatchStats = stats;
+    return stats;
+}
+
+std::string MemoryManager::ReadString(uintptr_t address, size_t maxLength, bool isRelative)
+{
+    uintptr_t finalAddress = isRelative ? ResolveAddress(address) : address;
+
+    // Чтение сразу в строку: для имён (до 15 символов) без выделения памяти
+    std::string result(maxLength, '\0');
+    if (!ReadMemory(finalAddress, result.data(), maxLength))
+    {
+        ThrowLastError("Failed to read string");
+    }
+
+    // Обрезаем по нуль-терминатору
+    result.resize(std::strlen(result.c_str()));
+    return result;
 }
 #pragma endregion Read Operations
 
 #pragma region Write Operations
 bool MemoryManager::WriteMemory(uintptr_t address, const void* buffer, size_t size)
 {
-    SIZE_T bytesWritten;
-    if (!WriteProcessMemory(processHandle, (LPVOID)address, buffer, size, &bytesWritten))
+    if (!WriteProcess(address, buffer, size))
     {
         qDebug() << "Failed to write memory at" << QString::number(address, 16) << "of size" << size
                  << "Error:" << GetLastError();
         return false;
     }
-    return bytesWritten == size;
+    return true;
 }
 
 bool MemoryManager::WriteString(uintptr_t address, const std::string& str, bool isRelative)
@@ -213,6 +594,323 @@ bool MemoryManager::WriteString(uintptr_t address, const std::string& str, bool
 #pragma endregion Write Operations
 #pragma endregion Read / Write Operations
 
+#pragma region Pattern Scanning
+uintptr_t MemoryManager::FindPattern(const char* pattern, const char* mask)
+{
+    return FindPattern(BytePattern(pattern, mask));
+}
+
+uintptr_t MemoryManager::FindPattern(const BytePattern& pattern, uintptr_t start, uintptr_t end)
+{
+    if (pattern.empty())
+    {
+        return 0;
+    }
+
+    uintptr_t result = 0;
+    ForEachReadableChunk(start,
+                         end,
+                         pattern.size() - 1,
+                         [&](uintptr_t address, const uint8_t* data, size_t size)
+                         {
+                             const size_t offset = PatternScanner::find(data, size, pattern);
+                             if (offset == SIZE_MAX)
+                             {
+                                 return true;
+                             }
+                             result = address + offset;
+                             return false;
+                         });
+
+    if (result)
+    {
+        qDebug() << "Pattern found at" << QString::number(result, 16) << "in process" << processId;
+    }
+    else
+    {
+        qDebug() << "Pattern of size" << pattern.size() << "not found in process" << processId;
+    }
+    return result;
+}
+
+std::vector<uintptr_t> MemoryManager::FindAllPatterns(const BytePattern& pattern, uintptr_t start, uintptr_t end)
+{
+    std::vector<uintptr_t> result;
+    if (pattern.empty())
+    {
+        return result;
+    }
+
+    std::vector<size_t> offsets;
+    ForEachReadableChunk(start,
+                         end,
+                         pattern.size() - 1,
+                         [&](uintptr_t address, const uint8_t* data, size_t size)
+                         {
+                             offsets.clear();
+                             PatternScanner::findAll(data, size, pattern, offsets);
+                             for (size_t offset : offsets)
+                             {
+                                 // Защита от повторов на стыке перекрывающихся блоков
+                                 if (result.empty() || address + offset > result.back())
+                                 {
+                                     result.push_back(address + offset);
+                                 }
+                             }
+                             return true;
+                         });
+    return result;
+}
+
+std::vector<uintptr_t> MemoryManager::FindPatterns(const MultiPatternScanner& scanner, uintptr_t start, uintptr_t end)
+{
+    std::vector<uintptr_t> results(scanner.patternCount(), 0);
+    if (scanner.patternCount() == 0 || scanner.maxPatternSize() == 0)
+    {
+        return results;
+    }
+
+    size_t found = 0;
+    ForEachReadableChunk(start,
+                         end,
+                         scanner.maxPatternSize() - 1,
+                         [&](uintptr_t address, const uint8_t* data, size_t size)
+                         {
+                             found = scanner.scan(data, size, address, results);
+                             return found < scanner.patternCount();
+                         });
+
+    qDebug() << "Multi-pattern scan found" << found << "of" << scanner.patternCount() << "signatures in process"
+             << processId;
+    return results;
+}
+
+std::vector<uintptr_t> MemoryManager::FindPatternsInModule(const MultiPatternScanner& scanner,
+                                                           const wchar_t*             moduleName,
+                                                           std::string_view           section)
+{
+    ModuleInfo module;
+    if (!GetModuleInfo(moduleName, module))
+    {
+        qDebug() << "Module" << QString::fromWCharArray(moduleName) << "not found in process" << processId;
+        return std::vector<uintptr_t>(scanner.patternCount(), 0);
+    }
+
+    uintptr_t start = module.base;
+    uintptr_t end   = module.base + module.size;
+    if (!section.empty())
+    {
+        // Поиск только по секции (код - .text, строки и таблицы - .rdata)
+        const PeImage& image = GetImage(module);
+        if (!image.isValid() || !image.sectionRange(section, start, end))
+        {
+            qDebug() << "Section" << QString::fromUtf8(section.data(), static_cast<qsizetype>(section.size()))
+                     << "not found in module" << QString::fromWCharArray(moduleName);
+            return std::vector<uintptr_t>(scanner.patternCount(), 0);
+        }
+    }
+
+    return FindPatterns(scanner, start, end);
+}
+
+std::vector<uintptr_t> MemoryManager::FindPatternParallel(const BytePattern& pattern, const ParallelScanOptions& options)
+{
+    std::vector<uintptr_t> result;
+    if (pattern.empty())
+    {
+        return result;
+    }
+
+    const auto shards = PlanScanShards(options.start, options.end, pattern.size() - 1, options.shardSize);
+    std::vector<std::vector<uintptr_t>> shardResults(shards.size());
+
+    RunShardsParallel(shards,
+                      options.threads,
+                      !options.findAll,
+                      [&](size_t index, uintptr_t address, const uint8_t* data, size_t size)
+                      {
+                          if (!options.findAll)
+                          {
+                              const size_t offset = PatternScanner::find(data, size, pattern);
+                              if (offset == SIZE_MAX)
+                              {
+                                  return false;
+                              }
+                              shardResults[index].push_back(address + offset);
+                              return true;
+                          }
+
+                          std::vector<size_t> local;
+                          PatternScanner::findAll(data, size, pattern, local);
+                          for (size_t offset : local)
+                          {
+                              shardResults[index].push_back(address + offset);
+                          }
+                          return !local.empty();
+                      });
+
+    // Детерминированное слияние: шарды уже упорядочены по адресам
+    for (const auto& matches : shardResults)
+    {
+        result.insert(result.end(), matches.begin(), matches.end());
+        if (!options.findAll && !result.empty())
+        {
+            break;
+        }
+    }
+
+    qDebug() << "Parallel pattern scan over" << shards.size() << "shards found" << result.size()
+             << "matches in process" << processId;
+    return result;
+}
+
+std::vector<uintptr_t> MemoryManager::FindPatternsParallel(const MultiPatternScanner& scanner,
+                                                           const ParallelScanOptions& options)
+{
+    std::vector<uintptr_t> result(scanner.patternCount(), 0);
+    if (scanner.patternCount() == 0 || scanner.maxPatternSize() == 0)
+    {
+        return result;
+    }
+
+    const auto shards = PlanScanShards(options.start, options.end, scanner.maxPatternSize() - 1, options.shardSize);
+    std::vector<std::vector<uintptr_t>> shardResults(shards.size());
+
+    RunShardsParallel(shards,
+                      options.threads,
+                      false,
+                      [&](size_t index, uintptr_t address, const uint8_t* data, size_t size)
+                      {
+                          scanner.scan(data, size, address, shardResults[index]);
+                          return false;
+                      });
+
+    // Для каждой сигнатуры берём вхождение из самого младшего шарда
+    for (const auto& matches : shardResults)
+    {
+        for (size_t i = 0; i < matches.size(); i++)
+        {
+            if (result[i] == 0 && matches[i] != 0)
+            {
+                result[i] = matches[i];
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<MemoryManager::ScanShard> MemoryManager::PlanScanShards(uintptr_t start,
+                                                                    uintptr_t end,
+                                                                    size_t    overlap,
+                                                                    size_t    shardSize) const
+{
+    std::vector<ScanShard>    shards;
+    std::vector<MemoryRegion> regions = EnumerateRegions(start, end);
+    shardSize                         = std::max(shardSize, overlap + 1);
+
+    for (size_t i = 0; i < regions.size();)
+    {
+        // Смежные регионы объединяются, чтобы не терять вхождения на их границах
+        uintptr_t spanStart = std::max(regions[i].base, start);
+        uintptr_t spanEnd   = regions[i].end();
+        for (i++; i < regions.size() && regions[i].base == spanEnd; i++)
+        {
+            spanEnd = regions[i].end();
+        }
+        spanEnd = std::min(spanEnd, end);
+
+        for (uintptr_t address = spanStart; address < spanEnd; address += shardSize)
+        {
+            const size_t own      = std::min<size_t>(shardSize, spanEnd - address);
+            const size_t readSize = std::min<size_t>(own + overlap, spanEnd - address);
+            if (readSize <= overlap)
+            {
+                break;
+            }
+            shards.push_back(ScanShard{address, own, readSize});
+        }
+    }
+
+    return shards;
+}
+
+std::vector<MemoryRegion> MemoryManager::EnumerateRegions(uintptr_t start, uintptr_t end) const
+{
+    std::vector<MemoryRegion> regions;
+
+    // Бэкенд, перечисляющий регионы сам (LinuxBackend - один разбор /proc/<pid>/maps), не опрашивается по регионам
+    const bool enumerated = std::visit(
+        [&](const auto& impl)
+        {
+            if constexpr (requires { impl.enumerateRegions(start, end, regions); })
+            {
+                return impl.enumerateRegions(start, end, regions);
+            }
+            else
+            {
+                return false;
+            }
+        },
+        backend);
+    if (enumerated)
+    {
+        std::erase_if(regions,
+                      [](const MemoryRegion& candidate)
+                      { return candidate.state != MEM_COMMIT || !IsReadableProtection(candidate.protection); });
+        return regions;
+    }
+
+    MemoryRegion region;
+    uintptr_t    address = start;
+
+    auto query = [this, &region](uintptr_t queryAddress)
+    { return std::visit([&](const auto& impl) { return impl.query(queryAddress, region); }, backend); };
+
+    while (address < end && query(address))
+    {
+        const uintptr_t regionEnd = region.end();
+
+        if (region.state == MEM_COMMIT && IsReadableProtection(region.protection))
+        {
+            regions.push_back(region);
+        }
+
+        // Защита от зацикливания на переполнении адреса
+        if (regionEnd <= address)
+        {
+            break;
+        }
+        address = regionEnd;
+    }
+
+    return regions;
+}
+
+bool MemoryManager::IsReadableProtection(DWORD protection)
+{
+    return isReadableProtection(protection);
+}
+#pragma endregion Pattern Scanning
+
+#pragma region Read Cache
+void MemoryManager::EnableReadCache(bool enabled)
+{
+    if (readCacheEnabled == enabled)
+    {
+        return;
+    }
+
+    readCacheEnabled = enabled;
+    readCache.clear();
+    qDebug() << "Read cache" << (enabled ? "enabled" : "disabled") << "for process" << processId;
+}
+
+void MemoryManager::BeginTick()
+{
+    readCache.beginTick();
+}
+#pragma endregion Read Cache
+
 #pragma region Memory Operations
 void* MemoryManager::AllocateMemory(void* address, size_t size, DWORD protection)
 {
@@ -220,15 +918,18 @@ void* MemoryManager::AllocateMemory(void* address, size_t size, DWORD protection
              << QString::number(reinterpret_cast<quintptr>(address), 16) << "with protection"
              << QString::number(protection, 16);
 
-    void* allocatedAddress = VirtualAllocEx(processHandle, address, size, MEM_COMMIT | MEM_RESERVE, protection);
+    void* allocatedAddress = reinterpret_cast<void*>(std::visit(
+        [&](auto& impl) { return impl.allocate(reinterpret_cast<uintptr_t>(address), size, protection); }, backend));
 
     if (!allocatedAddress)
     {
         DWORD error = GetLastError();
-        qDebug() << "VirtualAllocEx failed with error:" << error;
+        qDebug() << "Memory allocation failed with error:" << error;
         return nullptr;
     }
 
+    regionMap.invalidate(reinterpret_cast<uintptr_t>(allocatedAddress), size);
+
     qDebug() << "Successfully allocated memory at" << QString::number(reinterpret_cast<quintptr>(allocatedAddress), 16);
 
     return allocatedAddress;
@@ -238,10 +939,14 @@ bool MemoryManager::FreeMemory(void* address)
 {
     qDebug() << "Attempting to free memory at address" << QString::number(reinterpret_cast<quintptr>(address), 16);
 
-    if (!VirtualFreeEx(processHandle, address, 0, MEM_RELEASE))
+    // Размер освобождаемого региона заранее неизвестен, поэтому сбрасываем кэши целиком
+    readCache.clear();
+    regionMap.clear();
+
+    if (!std::visit([address](auto& impl) { return impl.release(reinterpret_cast<uintptr_t>(address)); }, backend))
     {
         DWORD error = GetLastError();
-        qDebug() << "VirtualFreeEx failed with error:" << error;
+        qDebug() << "Memory release failed with error:" << error;
         return false;
     }
 
@@ -250,22 +955,69 @@ bool MemoryManager::FreeMemory(void* address)
     return true;
 }
 
+uintptr_t MemoryManager::AllocateCode(size_t size, size_t alignment)
+{
+    const uintptr_t address = arena.allocate(*this, ArenaPool::Code, size, alignment);
+    if (address == 0)
+    {
+        qDebug() << "Arena code allocation of" << size << "bytes failed:" << QString::fromStdString(arena.error());
+    }
+    return address;
+}
+
+uintptr_t MemoryManager::AllocateData(size_t size, size_t alignment)
+{
+    const uintptr_t address = arena.allocate(*this, ArenaPool::Data, size, alignment);
+    if (address == 0)
+    {
+        qDebug() << "Arena data allocation of" << size << "bytes failed:" << QString::fromStdString(arena.error());
+    }
+    return address;
+}
+
+bool MemoryManager::FreeArenaMemory(uintptr_t address)
+{
+    if (!arena.free(*this, address))
+    {
+        qDebug() << "Arena free at" << QString::number(address, 16)
+                 << "failed:" << QString::fromStdString(arena.error());
+        return false;
+    }
+    return true;
+}
+
+bool MemoryManager::ReleaseArena()
+{
+    const RemoteArenaStats& code = arena.stats(ArenaPool::Code);
+    const RemoteArenaStats& data = arena.stats(ArenaPool::Data);
+    if (code.blocks == 0 && data.blocks == 0)
+    {
+        return true;
+    }
+
+    qDebug() << "Releasing arena of process" << processId << ":" << code.blocks + data.blocks << "blocks,"
+             << code.liveAllocations + data.liveAllocations << "live allocations";
+    return arena.release(*this);
+}
+
 bool MemoryManager::SetMemoryProtection(uintptr_t address, size_t size, DWORD protection)
 {
-    MEMORY_BASIC_INFORMATION mbi;
-    if (VirtualQueryEx(processHandle, (LPCVOID)address, &mbi, sizeof(mbi)))
+    if (const MemoryRegion* region = QueryRegion(address))
     {
         qDebug() << "Current memory protection at" << QString::number(address, 16)
-                 << "is:" << QString::number(mbi.Protect, 16);
+                 << "is:" << QString::number(region->protection, 16);
     }
 
     DWORD oldProtect;
-    bool  result = VirtualProtectEx(processHandle, (LPVOID)address, size, protection, &oldProtect);
+    bool  result = std::visit([&](auto& impl) { return impl.protect(address, size, protection, oldProtect); }, backend);
+
+    // VirtualProtectEx может разделить регион, поэтому закэшированные записи диапазона сбрасываем
+    regionMap.invalidate(address, size);
 
     if (!result)
     {
         DWORD error = GetLastError();
-        qDebug() << "VirtualProtectEx failed with error:" << error << "at address:" << QString::number(address, 16)
+        qDebug() << "Memory protection change failed with error:" << error << "at address:" << QString::number(address, 16)
                  << "requested protection:" << QString::number(protection, 16);
     }
     else
@@ -279,28 +1031,28 @@ bool MemoryManager::SetMemoryProtection(uintptr_t address, size_t size, DWORD pr
 
 DWORD MemoryManager::GetMemoryProtection(uintptr_t address) const
 {
-    MEMORY_BASIC_INFORMATION mbi;
-    if (VirtualQueryEx(processHandle, (LPCVOID)address, &mbi, sizeof(mbi)))
-    {
-        return mbi.Protect;
-    }
-    return 0;
+    const MemoryRegion* region = QueryRegion(address);
+    return region ? region->protection : 0;
 }
 
 bool MemoryManager::EnsureMemoryAccess(uintptr_t address, size_t size, DWORD requiredAccess)
 {
-    MEMORY_BASIC_INFORMATION mbi;
-    if (!VirtualQueryEx(processHandle, (LPCVOID)address, &mbi, sizeof(mbi)))
+    const MemoryRegion* region = QueryRegion(address);
+    if (!region)
     {
         return false;
     }
 
-    if ((mbi.Protect & requiredAccess) == requiredAccess)
+    if ((region->protection & requiredAccess) == requiredAccess)
     {
         return true;
     }
 
-    DWORD oldProtect;
-    return VirtualProtectEx(processHandle, (LPVOID)address, size, mbi.Protect | requiredAccess, &oldProtect);
+    DWORD       oldProtect;
+    const DWORD protection = region->protection | requiredAccess;
+    const bool  result =
+        std::visit([&](auto& impl) { return impl.protect(address, size, protection, oldProtect); }, backend);
+    regionMap.invalidate(address, size);
+    return result;
 }
 #pragma endregion Memory Operations
@@ -5,15 +5,53 @@
  */
 
 #pragma once
-#include <windows.h>
-#include <TlHelp32.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include <stdexcept>
 
+#include "MemoryRegion.hpp"
+#include "ModuleTable.hpp"
+#include "Platform.hpp"
+#include "backend/MemoryBackend.hpp"
+#include "MultiPatternScanner.hpp"
+#include "PageCache.hpp"
+#include "PatternScanner.hpp"
+#include "ReadBatch.hpp"
+#include "ReadResult.hpp"
+#include "RegionMap.hpp"
+#include "RemoteArena.hpp"
+
+
+/**
+ * @brief Именованная сигнатура для разрешения через постоянный кэш
+ */
+struct SignatureEntry
+{
+    std::string key;     ///< Уникальный ключ сигнатуры (например, "PlayerFunc")
+    BytePattern pattern; ///< Сигнатура
+};
+
+/**
+ * @brief Параметры параллельного сканирования памяти
+ */
+struct ParallelScanOptions
+{
+    uintptr_t start{0};            ///< Начало диапазона поиска
+    uintptr_t end{UINTPTR_MAX};    ///< Конец диапазона поиска (не включительно)
+    unsigned  threads{0};          ///< Количество потоков (0 - по числу ядер)
+    bool      findAll{false};      ///< false - только младшее вхождение, true - все вхождения
+    size_t    shardSize{0x400000}; ///< Размер шарда (участка, обрабатываемого одним заданием)
+};
 
 /**
  * @class MemoryManager
@@ -21,6 +59,8 @@
  * @details Обеспечивает безопасный доступ к памятью процесса WoW, включая чтение и запись
  * различных типов данных, работу со строками и массивами, а также поиск паттернов в памяти.
  * Каждый экземпляр класса работает с отдельным процессом WoW.
+ * Обращения к памяти идут через бэкенд (MemoryBackend): Win32 или Linux для живого процесса,
+ * память текущего процесса или файл дампа - для проверок и замеров без игры.
  */
 class MemoryManager
 {
@@ -32,6 +72,14 @@ class MemoryManager
      */
     explicit MemoryManager(DWORD processId);
 
+    /**
+     * @brief Конструктор поверх произвольного бэкенда (дамп, память текущего процесса)
+     * @param backend Бэкенд доступа к памяти
+     * @details В отличие от конструктора по PID не требует наличия run.exe:
+     * если модуль не найден, базовый адрес остаётся нулевым
+     */
+    explicit MemoryManager(MemoryBackend backend);
+
     /**
      * @brief Деструктор
      * @details Освобождает handle процесса
@@ -48,9 +96,17 @@ class MemoryManager
 
     /**
      * @brief Получает handle процесса
-     * @return Handle процесса WoW
+     * @return Handle процесса WoW или nullptr, если бэкенд не Win32
      */
-    HANDLE GetProcessHandle() const { return processHandle; }
+    HANDLE GetProcessHandle() const;
+
+    /**
+     * @brief Получает бэкенд доступа к памяти
+     * @details После изменения набора регионов бэкенда (например, InProcessBackend::addRegion)
+     * нужно вызвать InvalidateRegionMap()
+     */
+    MemoryBackend&       GetBackend() { return backend; }
+    const MemoryBackend& GetBackend() const { return backend; }
 
     /**
      * @brief Получает ID процесса
@@ -65,6 +121,73 @@ class MemoryManager
      */
     uintptr_t GetModuleBaseAddress(const wchar_t* moduleName = L"run.exe");
 
+    /**
+     * @brief Получает список модулей процесса
+     * @return Модули из таблицы модулей (пустой список при ошибке)
+     */
+    std::vector<ModuleInfo> GetModules() const;
+
+    /**
+     * @brief Получает базовый адрес и размер модуля
+     * @param moduleName Имя модуля (по умолчанию "run.exe")
+     * @param info Сюда записывается информация о модуле
+     * @return true если модуль найден
+     * @details Модули перечисляются один раз и хранятся в таблице модулей. Если модуля нет в таблице,
+     * она перестраивается один раз: повторные поиски того же модуля не перечисляют модули до RefreshModules()
+     * @throw std::runtime_error если модули не удалось перечислить
+     */
+    bool GetModuleInfo(const wchar_t* moduleName, ModuleInfo& info);
+
+    /**
+     * @brief Перечисляет модули заново (после загрузки или выгрузки DLL)
+     * @return false если модули не удалось перечислить
+     * @details Разобранные PE-образы выгруженных модулей удаляются
+     */
+    bool RefreshModules();
+
+    /**
+     * @brief Получает разобранный PE-образ модуля (секции, импорт, экспорт)
+     * @param moduleName Имя модуля (по умолчанию "run.exe")
+     * @return Образ или nullptr, если модуль не найден или его заголовки не читаются
+     * @details Образ разбирается один раз и хранится, пока модуль есть в таблице модулей
+     */
+    const PeImage* GetModuleImage(const wchar_t* moduleName = L"run.exe");
+
+    /**
+     * @brief Счётчики таблицы модулей
+     */
+    const ModuleTableStats& GetModuleTableStats() const { return moduleTable.stats(); }
+
+    /**
+     * @brief Получает хэш образа модуля (метка времени, точка входа, размер и таблица секций)
+     * @param moduleName Имя модуля (по умолчанию "run.exe")
+     * @return Хэш образа или 0, если модуль не найден или заголовки не читаются
+     * @details Вычисляется один раз на модуль по уже разобранному PeImage, без чтения секций;
+     * хуки в .text хэш не меняют
+     */
+    uint64_t GetModuleImageHash(const wchar_t* moduleName = L"run.exe");
+
+    /**
+     * @brief Находит адрес сигнатуры, используя постоянный кэш смещений
+     * @param key Уникальный ключ сигнатуры
+     * @param pattern Сигнатура
+     * @param moduleName Модуль, в образе которого ищется сигнатура
+     * @return Абсолютный адрес вхождения или 0
+     */
+    uintptr_t ResolveSignature(const std::string& key, const BytePattern& pattern, const wchar_t* moduleName = L"run.exe");
+
+    /**
+     * @brief Находит адреса набора сигнатур, используя постоянный кэш смещений
+     * @param signatures Именованные сигнатуры
+     * @param moduleName Модуль, в образе которого ищутся сигнатуры
+     * @return Абсолютные адреса по индексам сигнатур (0 - не найдено)
+     * @details Смещения берутся из SignatureCache по хэшу образа и хэшу сигнатуры и проверяются
+     * чтением сигнатуры по найденному адресу; отсутствующие в кэше или не совпавшие с памятью
+     * сигнатуры ищутся одним проходом MultiPatternScanner по модулю и сохраняются в кэш
+     */
+    std::vector<uintptr_t> ResolveSignatures(std::span<const SignatureEntry> signatures,
+                                             const wchar_t*                  moduleName = L"run.exe");
+
     /**
      * @brief Преобразует относительный адрес в абсолютный
      * @param relativeAddress Относительный адрес от базового адреса модуля
@@ -82,6 +205,43 @@ class MemoryManager
     template <typename T>
     T Read(uintptr_t address);
 
+    /**
+     * @brief Читает значение без исключений и логирования
+     * @tparam T Тип читаемого значения
+     * @param address Абсолютный адрес для чтения
+     * @return Значение или код ошибки; ошибки учитываются в GetReadFailureStats()
+     * @details Предназначен для горячих циклов, где неудачное чтение - обычная ситуация
+     * (например, юнит исчез между тиками)
+     */
+    template <typename T>
+    ReadResult<T> TryRead(uintptr_t address);
+
+    /**
+     * @brief Читает массив значений в буфер вызывающего кода без исключений и логирования
+     * @tparam T Тип элементов массива
+     * @param address Абсолютный адрес начала массива
+     * @param destination Буфер назначения (его размер задаёт количество элементов)
+     * @return ReadError::None при успехе, иначе код ошибки
+     */
+    template <typename T>
+    ReadError TryReadArray(uintptr_t address, std::span<T> destination);
+
+    /**
+     * @brief Читает произвольный блок памяти без исключений и логирования
+     * @return ReadError::None при успехе, иначе код ошибки
+     */
+    ReadError TryReadMemory(uintptr_t address, void* buffer, size_t size);
+
+    /**
+     * @brief Получает снимок счётчиков неудачных чтений TryRead/TryReadArray/TryReadMemory
+     */
+    ReadFailureStats GetReadFailureStats() const { return readFailures.snapshot(); }
+
+    /**
+     * @brief Сбрасывает счётчики неудачных чтений
+     */
+    void ResetReadFailureStats() { readFailures.reset(); }
+
     /**
      * @brief Записывает значение в память процесса
      * @tparam T Тип записываемого значения
@@ -123,6 +283,7 @@ class MemoryManager
      * @param maxLength Максимальная длина строки (по умолчанию 12 для WoW)
      * @param isRelative Если true, адрес считается относительным от базового адреса модуля
      * @return Прочитанная строка
+     * @details Для повторного чтения одних и тех же строк (имена юнитов, предметов) - StringCache
      */
     std::string ReadString(uintptr_t address, size_t maxLength = 12, bool isRelative = false);
 
@@ -163,10 +324,123 @@ class MemoryManager
      */
     uintptr_t FindPattern(const char* pattern, const char* mask);
 
+    /**
+     * @brief Ищет первое вхождение сигнатуры в диапазоне адресов
+     * @param pattern Сигнатура
+     * @param start Начало диапазона поиска
+     * @param end Конец диапазона поиска (не включительно)
+     * @return Адрес первого вхождения или 0
+     * @details Обходит только закоммиченные читаемые регионы, читает их крупными блоками
+     * с перекрытием на границах блоков, поиск в блоке выполняет PatternScanner (SSE2/AVX2)
+     */
+    uintptr_t FindPattern(const BytePattern& pattern, uintptr_t start = 0, uintptr_t end = UINTPTR_MAX);
+
+    /**
+     * @brief Ищет все вхождения сигнатуры в диапазоне адресов
+     * @param pattern Сигнатура
+     * @param start Начало диапазона поиска
+     * @param end Конец диапазона поиска (не включительно)
+     * @return Адреса всех вхождений по возрастанию
+     */
+    std::vector<uintptr_t> FindAllPatterns(const BytePattern& pattern, uintptr_t start = 0, uintptr_t end = UINTPTR_MAX);
+
+    /**
+     * @brief Ищет набор сигнатур за один проход по диапазону адресов
+     * @param scanner Подготовленный многосигнатурный сканер
+     * @param start Начало диапазона поиска
+     * @param end Конец диапазона поиска (не включительно)
+     * @return Адреса первых вхождений по индексам сигнатур (0 - не найдено)
+     * @details Время поиска растёт с размером диапазона, а не с количеством сигнатур.
+     * Обход прекращается, как только найдены все сигнатуры.
+     */
+    std::vector<uintptr_t> FindPatterns(const MultiPatternScanner& scanner,
+                                        uintptr_t                  start = 0,
+                                        uintptr_t                  end   = UINTPTR_MAX);
+
+    /**
+     * @brief Ищет набор сигнатур за один проход по образу модуля
+     * @param scanner Подготовленный многосигнатурный сканер
+     * @param moduleName Имя модуля (по умолчанию "run.exe")
+     * @param section Секция образа (".text", ".rdata"); пусто - весь образ
+     * @return Адреса первых вхождений по индексам сигнатур (0 - не найдено)
+     */
+    std::vector<uintptr_t> FindPatternsInModule(const MultiPatternScanner& scanner,
+                                                const wchar_t*             moduleName = L"run.exe",
+                                                std::string_view           section    = {});
+
+    /**
+     * @brief Параллельный поиск сигнатуры с разбиением регионов на шарды
+     * @param pattern Сигнатура
+     * @param options Диапазон, количество потоков и режим (младшее/все вхождения)
+     * @return Младшее вхождение (0 или 1 элемент) либо все вхождения по возрастанию
+     * @details Сплошные участки читаемой памяти режутся на шарды фиксированного размера,
+     * каждый рабочий поток берёт следующий шард из общей очереди и читает его в собственный
+     * буфер. Результат не зависит от порядка выполнения: шарды сливаются по возрастанию адресов,
+     * а в режиме младшего вхождения потоки пропускают шарды старше уже найденного.
+     */
+    std::vector<uintptr_t> FindPatternParallel(const BytePattern& pattern, const ParallelScanOptions& options = {});
+
+    /**
+     * @brief Параллельный поиск набора сигнатур
+     * @param scanner Подготовленный многосигнатурный сканер
+     * @param options Диапазон и количество потоков (findAll не используется)
+     * @return Адреса младших вхождений по индексам сигнатур (0 - не найдено)
+     */
+    std::vector<uintptr_t> FindPatternsParallel(const MultiPatternScanner& scanner,
+                                                const ParallelScanOptions& options = {});
+
+    /**
+     * @brief Шард параллельного сканирования
+     */
+    struct ScanShard
+    {
+        uintptr_t address{0};  ///< Начало шарда (вхождения, начинающиеся здесь, принадлежат шарду)
+        size_t    size{0};     ///< Размер собственной части шарда
+        size_t    readSize{0}; ///< Размер чтения с учётом перекрытия со следующим шардом
+    };
+
+    /**
+     * @brief Разбивает читаемую память диапазона на шарды
+     * @param start Начало диапазона
+     * @param end Конец диапазона (не включительно)
+     * @param overlap Перекрытие с соседним шардом (длина сигнатуры - 1)
+     * @param shardSize Размер собственной части шарда
+     * @return Шарды по возрастанию адресов
+     */
+    std::vector<ScanShard> PlanScanShards(uintptr_t start, uintptr_t end, size_t overlap, size_t shardSize) const;
+
+    /**
+     * @brief Выполняет обработчик для каждого шарда в пуле потоков
+     * @param shards Шарды по возрастанию адресов
+     * @param threads Количество потоков (0 - по числу ядер)
+     * @param stopOnFirst Пропускать шарды старше первого шарда, для которого обработчик вернул true
+     * @param onShard bool(size_t index, uintptr_t address, const uint8_t* data, size_t size) - true если найдено
+     * @return Количество шардов, которые не удалось прочитать
+     * @details Используется и другими сканерами поверх MemoryManager (ValueScanner); шарды, которые
+     * не удалось прочитать, пропускаются без вызова обработчика
+     */
+    template <typename OnShard>
+    size_t RunShardsParallel(const std::vector<ScanShard>& shards, unsigned threads, bool stopOnFirst, OnShard&& onShard);
+
+    /**
+     * @brief Перечисляет закоммиченные читаемые регионы памяти процесса
+     * @param start Начало диапазона
+     * @param end Конец диапазона (не включительно)
+     * @return Регионы по возрастанию адресов
+     */
+    std::vector<MemoryRegion> EnumerateRegions(uintptr_t start = 0, uintptr_t end = UINTPTR_MAX) const;
+
+    /**
+     * @brief Проверяет, допускают ли права доступа чтение
+     * @param protection Флаги PAGE_*
+     */
+    static bool IsReadableProtection(DWORD protection);
+
     /**
      * @brief Проверяет валидность адреса
      * @param address Проверяемый адрес
      * @return true если адрес валиден
+     * @details Регион берётся из кэша карты регионов (см. SetRegionRefreshPolicy)
      */
     bool IsValidAddress(uintptr_t address) const;
 
@@ -191,7 +465,7 @@ class MemoryManager
      * @param str Строка для проверки
      * @return true если строка валидна (содержит только допустимые символы)
      */
-    static bool IsValidCharacterName(const std::string& str)
+    static bool IsValidCharacterName(std::string_view str)
     {
         if (str.empty() || str.length() > 12)
         {
@@ -225,6 +499,41 @@ class MemoryManager
      */
     bool FreeMemory(void* address);
 
+    /**
+     * @brief Выделяет исполняемую память из арены (PAGE_EXECUTE_READ)
+     * @param size Размер
+     * @param alignment Выравнивание (степень двойки, не больше 0x1000)
+     * @return Адрес или 0 в случае ошибки
+     * @details Для трамплинов и пещер кода: десятки выделений занимают один блок арены вместо
+     * отдельного VirtualAllocEx на каждое. Страницы недоступны для записи, код пишется через WriteTransaction
+     */
+    uintptr_t AllocateCode(size_t size, size_t alignment = 16);
+
+    /**
+     * @brief Выделяет память для данных из арены (PAGE_READWRITE)
+     * @param size Размер
+     * @param alignment Выравнивание (степень двойки, не больше 0x1000)
+     * @return Адрес или 0 в случае ошибки
+     */
+    uintptr_t AllocateData(size_t size, size_t alignment = 16);
+
+    /**
+     * @brief Возвращает в арену память AllocateCode/AllocateData
+     * @return false если адрес не выделен ареной
+     */
+    bool FreeArenaMemory(uintptr_t address);
+
+    /**
+     * @brief Освобождает в процессе все блоки арены
+     * @details Вызывается при уничтожении менеджера; выделенные ареной адреса становятся недействительны
+     */
+    bool ReleaseArena();
+
+    /**
+     * @brief Статистика пула арены
+     */
+    const RemoteArenaStats& GetArenaStats(ArenaPool pool) const { return arena.stats(pool); }
+
     /**
      * @brief Базовый метод для чтения памяти процесса
      * @param address Адрес для чтения
@@ -240,13 +549,167 @@ class MemoryManager
      * @param buffer Буфер с данными для записи
      * @param size Размер записываемых данных
      * @return true если запись успешна
+     * @details Каждый вызов - отдельная запись; связанные изменения нескольких полей с откатом - WriteTransaction
      */
     bool WriteMemory(uintptr_t address, const void* buffer, size_t size);
 
+    /**
+     * @brief Включает или выключает постраничный кэш чтения
+     * @param enabled true - чтения обслуживаются из кэша страниц до следующего BeginTick()
+     * @details По умолчанию кэш выключен, и каждое чтение - отдельный вызов ReadProcessMemory
+     */
+    void EnableReadCache(bool enabled);
+
+    /**
+     * @brief Проверяет, включен ли кэш чтения
+     */
+    bool IsReadCacheEnabled() const { return readCacheEnabled; }
+
+    /**
+     * @brief Начинает новый тик чтения
+     * @details Инвалидирует все страницы кэша и продвигает эпоху GetTickEpoch(), по которой стареют звенья
+     * PointerChain и записи RegionMap. Вызывается владельцем менеджера ровно один раз в начале каждого тика
+     * опроса (в приложении - BotCore::tick() по таймеру); между вызовами память клиента считается неизменной
+     */
+    void BeginTick();
+
+    /**
+     * @brief Номер текущего тика (растёт с каждым BeginTick(), независимо от включения кэша)
+     */
+    uint64_t GetTickEpoch() const { return readCache.epoch(); }
+
+    /**
+     * @brief Был ли начат хотя бы один тик (вызывался ли BeginTick())
+     * @details Без тиков эпоха стоит на месте, и всё, что стареет по ней, должно перечитывать память каждый раз
+     */
+    bool IsTicking() const { return readCache.epoch() != PageCache::FIRST_EPOCH; }
+
+    /**
+     * @brief Устанавливает политику устаревания кэша карты регионов
+     * @details Карта сбрасывается автоматически при AllocateMemory/FreeMemory/SetMemoryProtection;
+     * срок жизни нужен только для изменений, которые делает сам целевой процесс. Срок считается в тиках:
+     * до первого BeginTick() и в менеджерах без тиков регионы хранятся до явного сброса
+     */
+    void SetRegionRefreshPolicy(const RegionMap::Policy& policy) { regionMap.setPolicy(policy); }
+
+    /**
+     * @brief Полностью сбрасывает кэш карты регионов
+     */
+    void InvalidateRegionMap() { regionMap.clear(); }
+
+    /**
+     * @brief Получает статистику кэша карты регионов (попадания/промахи/негативные попадания)
+     */
+    const RegionMap::Stats& GetRegionMapStats() const { return regionMap.stats(); }
+
+    /**
+     * @brief Сбрасывает статистику кэша карты регионов
+     */
+    void ResetRegionMapStats() { regionMap.resetStats(); }
+
+    /**
+     * @brief Получает статистику кэша чтения (попадания/промахи/загрузки страниц)
+     */
+    const PageCache::Stats& GetReadCacheStats() const { return readCache.stats(); }
+
+    /**
+     * @brief Сбрасывает статистику кэша чтения
+     */
+    void ResetReadCacheStats() { readCache.resetStats(); }
+
+    /**
+     * @brief Пакетное чтение набора диапазонов
+     * @param requests Запросы {адрес, размер, буфер}; поле succeeded заполняется для каждого запроса
+     * @return Статистика пакета (запросы, фактические чтения, "лишние" байты)
+     * @details Запросы сортируются по адресу, пересекающиеся и близкие (не дальше порога
+     * SetBatchGapThreshold) объединяются в одно чтение, после чего байты раскладываются
+     * по буферам вызывающего кода. Если объединённое чтение не удалось, его запросы
+     * читаются по отдельности, чтобы одна невалидная область не ломала весь пакет.
+     */
+    BatchReadStats ReadBatch(std::span<ReadRequest> requests);
+
+    /**
+     * @brief Устанавливает порог объединения запросов в ReadBatch
+     * @param gap Максимальный промежуток между диапазонами в байтах
+     */
+    void SetBatchGapThreshold(size_t gap) { batchPlanner.setGapThreshold(gap); }
+
+    /**
+     * @brief Получает порог объединения запросов в ReadBatch
+     */
+    size_t GetBatchGapThreshold() const { return batchPlanner.gapThreshold(); }
+
+    /**
+     * @brief Статистика последнего вызова ReadBatch
+     */
+    const BatchReadStats& GetLastBatchStats() const { return lastBatchStats; }
+
   private:
-    HANDLE    processHandle; ///< Handle процесса WoW
-    DWORD     processId;     ///< ID процесса WoW
-    uintptr_t baseAddress;   ///< Базовый адрес run.exe
+    MemoryBackend    backend;                 ///< Бэкенд доступа к памяти процесса
+    DWORD            processId;               ///< ID процесса WoW
+    uintptr_t        baseAddress;             ///< Базовый адрес run.exe
+    PageCache        readCache;               ///< Постраничный кэш чтения
+    bool             readCacheEnabled{false}; ///< Флаг использования кэша чтения
+    ReadBatchPlanner batchPlanner;            ///< Планировщик пакетных чтений
+    BatchReadStats   lastBatchStats;          ///< Статистика последнего пакета
+
+    std::unordered_map<uintptr_t, uint64_t> moduleHashes; ///< Хэши образов модулей по базовому адресу
+    mutable ModuleTable                     moduleTable;  ///< Кэш модулей и их PE-образов
+    RemoteArena                             arena;        ///< Арена выделений в процессе
+
+    mutable RegionMap regionMap; ///< Кэш карты регионов и недоступных страниц
+
+    ReadFailureCounters readFailures; ///< Счётчики неудачных чтений Try*-методов
+
+    /**
+     * @brief Находит регион по адресу через кэш карты регионов
+     * @return Регион или nullptr, если VirtualQueryEx для адреса невозможен
+     */
+    const MemoryRegion* QueryRegion(uintptr_t address) const;
+
+    /**
+     * @brief Вычисляет хэш образа модуля по заголовкам и таблице секций PE
+     */
+    uint64_t ComputeImageHash(const ModuleInfo& module);
+
+    /**
+     * @brief Заполняет таблицу модулей, если она ещё не заполнена
+     * @param refresh Перечислить модули заново, даже если таблица заполнена
+     * @return false если модули не удалось перечислить
+     */
+    bool LoadModules(bool refresh = false) const;
+
+    /**
+     * @brief Разбирает PE-образ модуля или берёт его из таблицы модулей
+     */
+    const PeImage& GetImage(const ModuleInfo& module);
+
+    /**
+     * @brief Читает память без логирования, через кэш если он включен
+     * @return true если все байты прочитаны
+     * @details Если страницу кэша загрузить не удалось, диапазон читается напрямую; отказ (и отметка
+     * страницы недоступной) - только когда не удалось и это чтение.
+     */
+    bool ReadRaw(uintptr_t address, void* buffer, size_t size);
+
+    /**
+     * @brief Читает память напрямую из процесса одним вызовом бэкенда
+     * @return true если все байты прочитаны
+     */
+    bool ReadProcess(uintptr_t address, void* buffer, size_t size) const
+    {
+        return std::visit([&](const auto& impl) { return impl.read(address, buffer, size); }, backend);
+    }
+
+    /**
+     * @brief Записывает память процесса одним вызовом бэкенда, без логирования
+     * @return true если все байты записаны
+     */
+    bool WriteProcess(uintptr_t address, const void* buffer, size_t size)
+    {
+        readCache.invalidate(address, size);
+        return std::visit([&](auto& impl) { return impl.write(address, buffer, size); }, backend);
+    }
 
     /**
      * @brief Проверяет и при необходимости изменяет права доступа к памяти
@@ -257,6 +720,19 @@ class MemoryManager
      */
     bool EnsureMemoryAccess(uintptr_t address, size_t size, DWORD requiredAccess);
 
+    /**
+     * @brief Обходит читаемые участки памяти блоками и вызывает обработчик для каждого блока
+     * @param start Начало диапазона
+     * @param end Конец диапазона (не включительно)
+     * @param overlap Количество байт перекрытия соседних блоков
+     * @param onChunk bool(uintptr_t address, const uint8_t* data, size_t size), false - прекратить обход
+     * @details Соседние регионы объединяются в сплошные участки, чтобы не терять совпадения на их границах
+     */
+    template <typename OnChunk>
+    void ForEachReadableChunk(uintptr_t start, uintptr_t end, size_t overlap, OnChunk&& onChunk);
+
+    static constexpr size_t SCAN_CHUNK_SIZE = 0x100000; ///< Размер блока чтения при сканировании (1 MiB)
+
     /**
      * @brief Выбрасывает исключение с информацией об ошибке Windows
      * @param message Сообщение об ошибке
@@ -274,10 +750,9 @@ class MemoryManager
 template <typename T>
 T MemoryManager::Read(uintptr_t address)
 {
-    T      value;
-    SIZE_T bytesRead;
+    T value;
 
-    if (!ReadProcessMemory(processHandle, (LPCVOID)address, &value, sizeof(T), &bytesRead) || bytesRead != sizeof(T))
+    if (!ReadRaw(address, &value, sizeof(T)))
     {
         ThrowLastError("Failed to read memory");
     }
@@ -285,22 +760,40 @@ T MemoryManager::Read(uintptr_t address)
     return value;
 }
 
+template <typename T>
+ReadResult<T> MemoryManager::TryRead(uintptr_t address)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "TryRead requires a trivially copyable type");
+
+    T               value;
+    const ReadError error = TryReadMemory(address, &value, sizeof(T));
+    if (error != ReadError::None)
+    {
+        return error;
+    }
+    return value;
+}
+
+template <typename T>
+ReadError MemoryManager::TryReadArray(uintptr_t address, std::span<T> destination)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "TryReadArray requires a trivially copyable type");
+
+    return TryReadMemory(address, destination.data(), destination.size_bytes());
+}
+
 template <typename T>
 bool MemoryManager::Write(uintptr_t address, const T& value)
 {
-    SIZE_T bytesWritten;
-    return WriteProcessMemory(processHandle, (LPVOID)address, &value, sizeof(T), &bytesWritten)
-           && bytesWritten == sizeof(T);
+    return WriteProcess(address, &value, sizeof(T));
 }
 
 template <typename T>
 std::vector<T> MemoryManager::ReadArray(uintptr_t address, size_t count)
 {
     std::vector<T> result(count);
-    SIZE_T         bytesRead;
 
-    if (!ReadProcessMemory(processHandle, (LPCVOID)address, result.data(), count * sizeof(T), &bytesRead)
-        || bytesRead != count * sizeof(T))
+    if (!ReadRaw(address, result.data(), count * sizeof(T)))
     {
         ThrowLastError("Failed to read array");
     }
@@ -308,10 +801,108 @@ std::vector<T> MemoryManager::ReadArray(uintptr_t address, size_t count)
     return result;
 }
 
+template <typename OnChunk>
+void MemoryManager::ForEachReadableChunk(uintptr_t start, uintptr_t end, size_t overlap, OnChunk&& onChunk)
+{
+    std::vector<MemoryRegion> regions = EnumerateRegions(start, end);
+    std::vector<uint8_t>      buffer;
+
+    for (size_t i = 0; i < regions.size();)
+    {
+        // Объединяем смежные регионы в один сплошной участок
+        uintptr_t spanStart = std::max(regions[i].base, start);
+        uintptr_t spanEnd   = regions[i].end();
+        for (i++; i < regions.size() && regions[i].base == spanEnd; i++)
+        {
+            spanEnd = regions[i].end();
+        }
+        spanEnd = std::min(spanEnd, end);
+
+        for (uintptr_t address = spanStart; address < spanEnd;)
+        {
+            const size_t length = std::min<size_t>(SCAN_CHUNK_SIZE, spanEnd - address);
+            if (length <= overlap)
+            {
+                break;
+            }
+
+            buffer.resize(length);
+            if (ReadProcess(address, buffer.data(), length) && !onChunk(address, buffer.data(), length))
+            {
+                return;
+            }
+
+            if (address + length >= spanEnd)
+            {
+                break;
+            }
+            address += length - overlap;
+        }
+    }
+}
+
+template <typename OnShard>
+size_t MemoryManager::RunShardsParallel(const std::vector<ScanShard>& shards,
+                                        unsigned                      threads,
+                                        bool                          stopOnFirst,
+                                        OnShard&&                     onShard)
+{
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, shards.size()));
+
+    std::atomic<size_t> nextShard{0};
+    std::atomic<size_t> firstFound{SIZE_MAX};
+    std::atomic<size_t> failed{0};
+
+    auto worker = [&]()
+    {
+        std::vector<uint8_t> buffer; // Собственный буфер чтения каждого потока
+        for (size_t index = nextShard++; index < shards.size(); index = nextShard++)
+        {
+            // Шарды старше уже найденного не могут дать младшее вхождение
+            if (stopOnFirst && index > firstFound.load(std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+            const ScanShard& shard = shards[index];
+            buffer.resize(shard.readSize);
+            if (!ReadProcess(shard.address, buffer.data(), shard.readSize))
+            {
+                failed.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            if (onShard(index, shard.address, buffer.data(), shard.readSize) && stopOnFirst)
+            {
+                size_t current = firstFound.load(std::memory_order_relaxed);
+                while (index < current && !firstFound.compare_exchange_weak(current, index))
+                {
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads > 0 ? threads - 1 : 0);
+    for (unsigned i = 1; i < threads; i++)
+    {
+        pool.emplace_back(worker);
+    }
+    worker(); // Текущий поток тоже участвует в работе
+
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
+    return failed.load();
+}
+
 template <typename T>
 bool MemoryManager::WriteArray(uintptr_t address, const std::vector<T>& array)
 {
-    SIZE_T bytesWritten;
-    return WriteProcessMemory(processHandle, (LPVOID)address, array.data(), array.size() * sizeof(T), &bytesWritten)
-           && bytesWritten == array.size() * sizeof(T);
+    return WriteProcess(address, array.data(), array.size() * sizeof(T));
 }
\ No newline at end of file
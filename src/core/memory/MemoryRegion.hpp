@@ -0,0 +1,44 @@
+/**
+ * @file MemoryRegion.hpp
+ * @brief Описание регионов памяти и модулей целевого процесса
+ */
+#pragma once
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * @brief Регион виртуальной памяти целевого процесса
+ * @details Аналог MEMORY_BASIC_INFORMATION без зависимости от WinAPI.
+ * Поля protection/state/type содержат значения флагов PAGE_* / MEM_*.
+ */
+struct MemoryRegion
+{
+    uintptr_t base{0};       ///< Начальный адрес региона
+    size_t    size{0};       ///< Размер региона в байтах
+    uint32_t  protection{0}; ///< Права доступа (PAGE_*)
+    uint32_t  state{0};      ///< Состояние (MEM_COMMIT, MEM_RESERVE, MEM_FREE)
+    uint32_t  type{0};       ///< Тип (MEM_IMAGE, MEM_MAPPED, MEM_PRIVATE)
+
+    /**
+     * @brief Конечный адрес региона (не включительно)
+     */
+    uintptr_t end() const { return base + size; }
+
+    /**
+     * @brief Проверяет, попадает ли адрес в регион
+     */
+    bool contains(uintptr_t address) const { return address >= base && address - base < size; }
+};
+
+/**
+ * @brief Информация о модуле, загруженном в процесс
+ */
+struct ModuleInfo
+{
+    std::wstring name;    ///< Имя модуля (например, run.exe)
+    uintptr_t    base{0}; ///< Базовый адрес образа
+    size_t       size{0}; ///< Размер образа в памяти
+};
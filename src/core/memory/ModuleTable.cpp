@@ -0,0 +1,73 @@
+#include "ModuleTable.hpp"
+
+#include <cwctype>
+
+
+void ModuleTable::assign(std::vector<ModuleInfo> modules)
+{
+    m_modules = std::move(modules);
+    m_loaded  = true;
+    m_byName.clear();
+    m_missing.clear();
+    m_stats.refreshes++;
+
+    m_byName.reserve(m_modules.size());
+    std::unordered_map<uintptr_t, size_t> sizes;
+    for (size_t i = 0; i < m_modules.size(); i++)
+    {
+        // При совпадении имён остаётся первый модуль, как при линейном поиске
+        m_byName.emplace(normalize(m_modules[i].name), i);
+        sizes.emplace(m_modules[i].base, m_modules[i].size);
+    }
+
+    // Образы оставшихся на месте модулей сохраняются (указатели на них остаются действительны)
+    std::erase_if(m_images,
+                  [&sizes](const auto& entry)
+                  {
+                      auto it = sizes.find(entry.first);
+                      return it == sizes.end() || it->second != entry.second.size();
+                  });
+}
+
+const ModuleInfo* ModuleTable::find(std::wstring_view name)
+{
+    m_stats.lookups++;
+    auto it = m_byName.find(normalize(name));
+    if (it == m_byName.end())
+    {
+        return nullptr;
+    }
+    m_stats.hits++;
+    return &m_modules[it->second];
+}
+
+const PeImage* ModuleTable::image(uintptr_t base) const
+{
+    auto it = m_images.find(base);
+    return it != m_images.end() ? &it->second : nullptr;
+}
+
+const PeImage& ModuleTable::storeImage(uintptr_t base, PeImage image)
+{
+    m_stats.images++;
+    return m_images.insert_or_assign(base, std::move(image)).first->second;
+}
+
+void ModuleTable::clear()
+{
+    m_loaded = false;
+    m_modules.clear();
+    m_byName.clear();
+    m_missing.clear();
+    m_images.clear();
+}
+
+std::wstring ModuleTable::normalize(std::wstring_view name)
+{
+    std::wstring result(name);
+    for (wchar_t& c : result)
+    {
+        c = static_cast<wchar_t>(std::towlower(c));
+    }
+    return result;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file ModuleTable.hpp
+ * @brief Кэш списка модулей процесса и их PE-образов
+ */
+#pragma once
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MemoryRegion.hpp"
+#include "PeImage.hpp"
+
+
+/**
+ * @brief Счётчики работы ModuleTable
+ */
+struct ModuleTableStats
+{
+    uint64_t lookups{0};   ///< Поиски модуля по имени
+    uint64_t hits{0};      ///< Поиски, обслуженные таблицей без перечисления модулей
+    uint64_t refreshes{0}; ///< Перечисления модулей (снимки Toolhelp32)
+    uint64_t images{0};    ///< Разобранные PE-образы
+};
+
+/**
+ * @class ModuleTable
+ * @brief Модули процесса по имени и разобранные образы по базовому адресу
+ * @details Не зависит от WinAPI и от менеджера памяти: список модулей передаётся в assign(), образы
+ * разбирает MemoryManager. Имена сравниваются без учёта регистра, как в Windows. Имена, которых не
+ * оказалось в свежем списке, запоминаются: повторный поиск отсутствующего модуля не перечисляет модули
+ * заново до следующего assign(). assign() удаляет образы модулей, которых нет в новом списке по тому же
+ * адресу с тем же размером; образы остальных модулей сохраняются. Не потокобезопасен.
+ */
+class ModuleTable
+{
+  public:
+    /**
+     * @brief Список модулей получен хотя бы один раз
+     */
+    bool isLoaded() const { return m_loaded; }
+
+    /**
+     * @brief Заменяет список модулей
+     */
+    void assign(std::vector<ModuleInfo> modules);
+
+    /**
+     * @brief Модули в порядке перечисления
+     */
+    const std::vector<ModuleInfo>& modules() const { return m_modules; }
+
+    /**
+     * @brief Находит модуль по имени (без учёта регистра)
+     * @return Модуль или nullptr; указатель действителен до assign()
+     */
+    const ModuleInfo* find(std::wstring_view name);
+
+    /**
+     * @brief Запоминает, что модуля нет в текущем списке
+     */
+    void markMissing(std::wstring_view name) { m_missing.insert(normalize(name)); }
+
+    /**
+     * @brief Модуль уже искали в текущем списке и не нашли
+     */
+    bool isKnownMissing(std::wstring_view name) const { return m_missing.count(normalize(name)) != 0; }
+
+    /**
+     * @brief Разобранный образ модуля
+     * @return Образ (в том числе недействительный, если разбор не удался) или nullptr, если не разбирался
+     */
+    const PeImage* image(uintptr_t base) const;
+
+    /**
+     * @brief Сохраняет разобранный образ модуля
+     */
+    const PeImage& storeImage(uintptr_t base, PeImage image);
+
+    /**
+     * @brief Удаляет список модулей и образы
+     */
+    void clear();
+
+    /**
+     * @brief Счётчики
+     */
+    const ModuleTableStats& stats() const { return m_stats; }
+
+  private:
+    /**
+     * @brief Имя в нижнем регистре
+     */
+    static std::wstring normalize(std::wstring_view name);
+
+    bool                                     m_loaded{false}; ///< Список получен
+    std::vector<ModuleInfo>                  m_modules;       ///< Модули
+    std::unordered_map<std::wstring, size_t> m_byName;        ///< Имя в нижнем регистре -> индекс модуля
+    std::unordered_set<std::wstring>         m_missing;       ///< Отсутствующие в списке имена
+    std::unordered_map<uintptr_t, PeImage>   m_images;        ///< Разобранные образы по базовому адресу
+    ModuleTableStats                         m_stats;         ///< Счётчики
+};
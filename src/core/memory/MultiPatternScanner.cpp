@@ -0,0 +1,118 @@
+#include "MultiPatternScanner.hpp"
+
+#include <algorithm>
+
+
+MultiPatternScanner::MultiPatternScanner(std::vector<BytePattern> patterns) : m_patterns(std::move(patterns))
+{
+    for (uint32_t index = 0; index < m_patterns.size(); index++)
+    {
+        const BytePattern& pattern = m_patterns[index];
+        m_maxPatternSize           = std::max(m_maxPatternSize, pattern.size());
+
+        if (!pattern.hasSignificantBytes())
+        {
+            continue;
+        }
+
+        // Ищем пару соседних значимых байтов с минимальным суммарным весом
+        size_t bestOffset = SIZE_MAX;
+        int    bestWeight = 0;
+        for (size_t i = 0; i + 1 < pattern.size(); i++)
+        {
+            if (!pattern.mask()[i] || !pattern.mask()[i + 1])
+            {
+                continue;
+            }
+            const int weight = patternByteWeight(pattern.bytes()[i]) + patternByteWeight(pattern.bytes()[i + 1]);
+            if (bestOffset == SIZE_MAX || weight < bestWeight)
+            {
+                bestOffset = i;
+                bestWeight = weight;
+            }
+        }
+
+        if (bestOffset != SIZE_MAX)
+        {
+            const uint32_t key = pattern.bytes()[bestOffset] | (pattern.bytes()[bestOffset + 1] << 8);
+            m_pairFilter[key >> 6] |= uint64_t(1) << (key & 63);
+            m_pairAnchors.push_back(Anchor{key, index, bestOffset});
+        }
+        else
+        {
+            const uint32_t key = pattern.bytes()[pattern.anchor()];
+            m_byteFilter[key]  = true;
+            m_byteAnchors.push_back(Anchor{key, index, pattern.anchor()});
+        }
+    }
+
+    auto byKey = [](const Anchor& a, const Anchor& b) { return a.key < b.key; };
+    std::sort(m_pairAnchors.begin(), m_pairAnchors.end(), byKey);
+    std::sort(m_byteAnchors.begin(), m_byteAnchors.end(), byKey);
+}
+
+void MultiPatternScanner::checkBucket(const std::vector<Anchor>& anchors,
+                                      uint32_t                   key,
+                                      const uint8_t*             data,
+                                      size_t                     size,
+                                      size_t                     position,
+                                      uintptr_t                  baseAddress,
+                                      std::vector<uintptr_t>&    results,
+                                      size_t&                    found) const
+{
+    auto it = std::lower_bound(
+        anchors.begin(), anchors.end(), key, [](const Anchor& anchor, uint32_t value) { return anchor.key < value; });
+
+    for (; it != anchors.end() && it->key == key; ++it)
+    {
+        if (results[it->pattern] != 0 || position < it->offset)
+        {
+            continue;
+        }
+
+        const size_t       start   = position - it->offset;
+        const BytePattern& pattern = m_patterns[it->pattern];
+        if (start + pattern.size() <= size && pattern.matches(data + start))
+        {
+            results[it->pattern] = baseAddress + start;
+            found++;
+        }
+    }
+}
+
+size_t MultiPatternScanner::scan(const uint8_t*          data,
+                                 size_t                  size,
+                                 uintptr_t               baseAddress,
+                                 std::vector<uintptr_t>& results) const
+{
+    results.resize(m_patterns.size(), 0);
+
+    size_t found = 0;
+    for (uintptr_t result : results)
+    {
+        if (result)
+        {
+            found++;
+        }
+    }
+
+    const bool hasByteAnchors = !m_byteAnchors.empty();
+    for (size_t position = 0; position < size && found < m_patterns.size(); position++)
+    {
+        if (position + 1 < size)
+        {
+            const uint32_t key = data[position] | (data[position + 1] << 8);
+            if (m_pairFilter[key >> 6] & (uint64_t(1) << (key & 63)))
+            {
+                checkBucket(m_pairAnchors, key, data, size, position, baseAddress, results, found);
+            }
+        }
+
+        if (hasByteAnchors && m_byteFilter[data[position]])
+        {
+            checkBucket(m_byteAnchors, data[position], data, size, position, baseAddress, results, found);
+        }
+    }
+
+    return found;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file MultiPatternScanner.hpp
+ * @brief Поиск множества сигнатур за один проход по буферу
+ */
+#pragma once
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "PatternScanner.hpp"
+
+
+/**
+ * @class MultiPatternScanner
+ * @brief Одновременный поиск N сигнатур за один проход
+ * @details Для каждой сигнатуры выбирается пара соседних значимых байтов с наименьшим
+ * суммарным весом. Все пары попадают в битовую карту на 65536 бит (8 KiB, помещается в L1),
+ * поэтому проход по буферу стоит одну проверку бита на позицию независимо от количества
+ * сигнатур. Сигнатуры проверяются полностью только при попадании в карту.
+ * Сигнатуры без двух соседних значимых байтов фильтруются по одиночному байту.
+ */
+class MultiPatternScanner
+{
+  public:
+    /**
+     * @brief Конструктор
+     * @param patterns Набор сигнатур; индексы результатов соответствуют порядку в этом наборе
+     */
+    explicit MultiPatternScanner(std::vector<BytePattern> patterns);
+
+    /**
+     * @brief Количество сигнатур
+     */
+    size_t patternCount() const { return m_patterns.size(); }
+
+    /**
+     * @brief Длина самой длинной сигнатуры (нужна для перекрытия блоков)
+     */
+    size_t maxPatternSize() const { return m_maxPatternSize; }
+
+    /**
+     * @brief Ищет сигнатуры в буфере
+     * @param data Буфер
+     * @param size Размер буфера
+     * @param baseAddress Адрес начала буфера в целевом процессе
+     * @param results Адреса первых вхождений по индексам сигнатур (0 - ещё не найдено).
+     * Уже найденные сигнатуры не перезаписываются, поэтому при обходе буферов по возрастанию
+     * адресов в результате остаются самые младшие вхождения.
+     * @return Количество сигнатур, для которых найдено вхождение (с учётом прошлых вызовов)
+     */
+    size_t scan(const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<uintptr_t>& results) const;
+
+  private:
+    /**
+     * @brief Сигнатура и смещение её опорной позиции
+     */
+    struct Anchor
+    {
+        uint32_t key;     ///< Пара байтов (b0 | b1 << 8) или одиночный байт
+        uint32_t pattern; ///< Индекс сигнатуры
+        size_t   offset;  ///< Смещение опорной позиции внутри сигнатуры
+    };
+
+    /**
+     * @brief Проверяет кандидатов из корзины и записывает найденные вхождения
+     */
+    void checkBucket(const std::vector<Anchor>& anchors,
+                     uint32_t                   key,
+                     const uint8_t*             data,
+                     size_t                     size,
+                     size_t                     position,
+                     uintptr_t                  baseAddress,
+                     std::vector<uintptr_t>&    results,
+                     size_t&                    found) const;
+
+    std::vector<BytePattern>   m_patterns;          ///< Сигнатуры
+    std::array<uint64_t, 1024> m_pairFilter{};      ///< Битовая карта опорных пар байтов
+    std::array<bool, 256>      m_byteFilter{};      ///< Фильтр одиночных опорных байтов
+    std::vector<Anchor>        m_pairAnchors;       ///< Опорные пары, отсортированные по ключу
+    std::vector<Anchor>        m_byteAnchors;       ///< Опорные байты, отсортированные по ключу
+    size_t                     m_maxPatternSize{0}; ///< Длина самой длинной сигнатуры
+};
@@ -0,0 +1,48 @@
+#include "PageCache.hpp"
+
+
+PageCache::PageCache(size_t maxPages, size_t maxReadPages) : m_maxPages(maxPages), m_maxReadPages(maxReadPages)
+{
+    m_pages.reserve(maxPages);
+}
+
+void PageCache::beginTick()
+{
+    m_epoch++;
+
+    // Страницы прошлых тиков переиспользуются, но если набор адресов сильно сменился,
+    // освобождаем память целиком, чтобы кэш не упирался в лимит устаревшими записями
+    if (m_pages.size() >= m_maxPages)
+    {
+        m_pages.clear();
+    }
+}
+
+void PageCache::invalidate(uintptr_t address, size_t size)
+{
+    if (size == 0 || m_pages.empty())
+    {
+        return;
+    }
+
+    const uintptr_t firstPage = address & ~(PAGE_SIZE - 1);
+    const uintptr_t lastPage  = (address + size - 1) & ~(PAGE_SIZE - 1);
+
+    for (uintptr_t pageBase = firstPage;; pageBase += PAGE_SIZE)
+    {
+        auto it = m_pages.find(pageBase);
+        if (it != m_pages.end())
+        {
+            it->second->epoch = 0;
+        }
+        if (pageBase == lastPage)
+        {
+            break;
+        }
+    }
+}
+
+void PageCache::clear()
+{
+    m_pages.clear();
+}
@@ -0,0 +1,204 @@
+/**
+ * @file PageCache.hpp
+ * @brief Постраничный кэш чтения памяти в пределах одного тика
+ * @details Кэш не зависит от WinAPI: источник страниц передаётся в read() как функтор,
+ * поэтому его можно проверять на любой платформе поверх обычного буфера в памяти.
+ */
+#pragma once
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+/**
+ * @class PageCache
+ * @brief Кэш страниц целевого процесса размером 4 KiB
+ * @details При первом обращении к странице в текущем тике она читается целиком одним вызовом
+ * источника, все последующие чтения в этом же тике обслуживаются из локальной копии.
+ * beginTick() увеличивает эпоху и тем самым за O(1) инвалидирует все страницы.
+ */
+class PageCache
+{
+  public:
+    static constexpr size_t   PAGE_SIZE   = 0x1000; ///< Размер страницы (4 KiB)
+    static constexpr uint64_t FIRST_EPOCH = 1;      ///< Эпоха до первого beginTick()
+
+    /**
+     * @brief Счётчики работы кэша
+     */
+    struct Stats
+    {
+        uint64_t hits{0};          ///< Чтения, полностью обслуженные из кэша
+        uint64_t misses{0};        ///< Чтения, потребовавшие загрузки хотя бы одной страницы
+        uint64_t bypasses{0};      ///< Чтения в обход кэша (слишком большие или кэш переполнен)
+        uint64_t pageFetches{0};   ///< Количество загрузок страниц (= обращений к источнику)
+        uint64_t failedFetches{0}; ///< Неудачные загрузки страниц
+    };
+
+    /**
+     * @brief Конструктор
+     * @param maxPages Максимальное количество страниц, хранимых одновременно
+     * @param maxReadPages Чтения, затрагивающие больше страниц, идут в обход кэша
+     */
+    explicit PageCache(size_t maxPages = 256, size_t maxReadPages = 4);
+
+    /**
+     * @brief Начинает новый тик
+     * @details Все закэшированные страницы становятся недействительными
+     */
+    void beginTick();
+
+    /**
+     * @brief Текущая эпоха (номер тика)
+     */
+    uint64_t epoch() const { return m_epoch; }
+
+    /**
+     * @brief Читает данные через кэш
+     * @tparam Fetch Функтор вида bool(uintptr_t address, void* buffer, size_t size)
+     * @param address Адрес начала чтения
+     * @param buffer Буфер назначения
+     * @param size Размер читаемых данных
+     * @param fetch Источник данных, вызывается для загрузки целых страниц
+     * @return true если все байты прочитаны
+     */
+    template <typename Fetch>
+    bool read(uintptr_t address, void* buffer, size_t size, Fetch&& fetch);
+
+    /**
+     * @brief Инвалидирует страницы, пересекающиеся с диапазоном
+     * @details Вызывается при записи в память цели, чтобы не отдавать устаревшие данные
+     */
+    void invalidate(uintptr_t address, size_t size);
+
+    /**
+     * @brief Полностью очищает кэш
+     */
+    void clear();
+
+    /**
+     * @brief Получает счётчики кэша
+     */
+    const Stats& stats() const { return m_stats; }
+
+    /**
+     * @brief Сбрасывает счётчики кэша
+     */
+    void resetStats() { m_stats = Stats{}; }
+
+  private:
+    /**
+     * @brief Закэшированная страница
+     */
+    struct Page
+    {
+        uint64_t                         epoch{0}; ///< Эпоха, в которую страница была загружена
+        std::array<uint8_t, PAGE_SIZE>   data{};   ///< Содержимое страницы
+    };
+
+    /**
+     * @brief Возвращает актуальную страницу, загружая её при необходимости
+     * @return Указатель на страницу или nullptr при ошибке/переполнении
+     */
+    template <typename Fetch>
+    const Page* acquire(uintptr_t pageBase, bool& fetched, Fetch& fetch);
+
+    std::unordered_map<uintptr_t, std::unique_ptr<Page>> m_pages;              ///< Страницы по базовому адресу
+    size_t                                               m_maxPages;           ///< Лимит страниц
+    size_t                                               m_maxReadPages;       ///< Лимит страниц на одно чтение
+    uint64_t                                             m_epoch{FIRST_EPOCH}; ///< Текущая эпоха
+    Stats                                                m_stats;              ///< Счётчики
+};
+
+template <typename Fetch>
+const PageCache::Page* PageCache::acquire(uintptr_t pageBase, bool& fetched, Fetch& fetch)
+{
+    auto it = m_pages.find(pageBase);
+    if (it != m_pages.end() && it->second->epoch == m_epoch)
+    {
+        return it->second.get();
+    }
+
+    if (it == m_pages.end())
+    {
+        if (m_pages.size() >= m_maxPages)
+        {
+            return nullptr;
+        }
+        it = m_pages.emplace(pageBase, std::make_unique<Page>()).first;
+    }
+
+    fetched = true;
+    m_stats.pageFetches++;
+    if (!fetch(pageBase, it->second->data.data(), PAGE_SIZE))
+    {
+        m_stats.failedFetches++;
+        it->second->epoch = 0;
+        return nullptr;
+    }
+
+    it->second->epoch = m_epoch;
+    return it->second.get();
+}
+
+template <typename Fetch>
+bool PageCache::read(uintptr_t address, void* buffer, size_t size, Fetch&& fetch)
+{
+    if (size == 0)
+    {
+        return true;
+    }
+
+    const uintptr_t firstPage = address & ~(PAGE_SIZE - 1);
+    const uintptr_t lastPage  = (address + size - 1) & ~(PAGE_SIZE - 1);
+    const size_t    pageCount = (lastPage - firstPage) / PAGE_SIZE + 1;
+
+    if (pageCount > m_maxReadPages)
+    {
+        m_stats.bypasses++;
+        return fetch(address, buffer, size);
+    }
+
+    auto*     out     = static_cast<uint8_t*>(buffer);
+    uintptr_t current = address;
+    size_t    left    = size;
+    bool      fetched = false;
+
+    for (uintptr_t pageBase = firstPage; left > 0; pageBase += PAGE_SIZE)
+    {
+        const Page* page = acquire(pageBase, fetched, fetch);
+        if (!page)
+        {
+            // Страница недоступна: если кэш просто переполнен, читаем напрямую
+            if (m_pages.size() >= m_maxPages && m_pages.find(pageBase) == m_pages.end())
+            {
+                m_stats.bypasses++;
+                return fetch(current, out, left);
+            }
+            m_stats.misses++;
+            return false;
+        }
+
+        const size_t offset = current - pageBase;
+        const size_t chunk  = (left < PAGE_SIZE - offset) ? left : PAGE_SIZE - offset;
+        std::memcpy(out, page->data.data() + offset, chunk);
+
+        out += chunk;
+        current += chunk;
+        left -= chunk;
+    }
+
+    if (fetched)
+    {
+        m_stats.misses++;
+    }
+    else
+    {
+        m_stats.hits++;
+    }
+    return true;
+}
@@ -0,0 +1,380 @@
+#include "PatternScanner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define MDBOT_PATTERN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// MSVC разрешает AVX2-интринсики без флагов компиляции, GCC/Clang требуют атрибут target
+#if defined(MDBOT_PATTERN_X86) && !defined(_MSC_VER)
+#define MDBOT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MDBOT_TARGET_AVX2
+#endif
+
+
+#pragma region BytePattern
+BytePattern::BytePattern(const char* pattern, const char* mask)
+{
+    const size_t length = mask ? strlen(mask) : 0;
+    m_bytes.resize(length);
+    m_mask.resize(length);
+
+    for (size_t i = 0; i < length; i++)
+    {
+        m_bytes[i] = static_cast<uint8_t>(pattern[i]);
+        m_mask[i]  = mask[i] == '?' ? 0x00 : 0xFF;
+    }
+
+    prepare();
+}
+
+BytePattern::BytePattern(std::vector<uint8_t> bytes, std::vector<uint8_t> mask)
+    : m_bytes(std::move(bytes)), m_mask(std::move(mask))
+{
+    m_mask.resize(m_bytes.size(), 0xFF);
+    prepare();
+}
+
+BytePattern::BytePattern(std::vector<uint8_t> bytes, std::vector<uint8_t> mask, size_t anchor, size_t secondAnchor)
+    : m_bytes(std::move(bytes)), m_mask(std::move(mask)), m_anchor(anchor), m_secondAnchor(secondAnchor)
+{
+    m_mask.resize(m_bytes.size(), 0xFF);
+    m_significant = m_anchor < m_mask.size() && m_mask[m_anchor] && m_secondAnchor < m_mask.size();
+}
+
+void BytePattern::prepare()
+{
+    for (size_t i = 0; i < m_bytes.size(); i++)
+    {
+        m_mask[i] = m_mask[i] ? 0xFF : 0x00;
+        m_bytes[i] &= m_mask[i];
+    }
+
+    m_significant = selectPatternAnchors(m_bytes.data(), m_mask.data(), m_bytes.size(), m_anchor, m_secondAnchor);
+}
+
+bool BytePattern::matches(const uint8_t* data) const
+{
+    for (size_t i = 0; i < m_bytes.size(); i++)
+    {
+        if ((data[i] & m_mask[i]) != m_bytes[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#pragma endregion BytePattern
+
+#pragma region Kernels
+namespace
+{
+    std::atomic<int> g_simdLevel{-1}; ///< Выбранный уровень SIMD (-1 - ещё не определён)
+
+    /**
+     * @brief Скалярное ядро: memchr по опорному байту + полная проверка кандидата
+     * @tparam OnMatch bool(size_t offset), возвращает false чтобы остановить поиск
+     */
+    template <typename OnMatch>
+    void scanScalar(const uint8_t* data, size_t size, const BytePattern& pattern, size_t from, OnMatch&& onMatch)
+    {
+        const size_t  length = pattern.size();
+        const size_t  last   = size - length;
+        const size_t  anchor = pattern.anchor();
+        const uint8_t value  = pattern.bytes()[anchor];
+
+        size_t position = from;
+        while (position <= last)
+        {
+            const void* hit = memchr(data + position + anchor, value, last - position + 1);
+            if (!hit)
+            {
+                return;
+            }
+
+            const size_t candidate = static_cast<const uint8_t*>(hit) - data - anchor;
+            if (pattern.matches(data + candidate) && !onMatch(candidate))
+            {
+                return;
+            }
+            position = candidate + 1;
+        }
+    }
+
+#ifdef MDBOT_PATTERN_X86
+    /**
+     * @brief Проверка кандидата блоками по 16 байт: ((data & mask) == bytes)
+     */
+    inline bool matchesSse2(const uint8_t* data, const BytePattern& pattern)
+    {
+        const size_t length = pattern.size();
+        size_t       i      = 0;
+
+        for (; i + 16 <= length; i += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const __m128i mask  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.mask() + i));
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.bytes() + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(block, mask), bytes)) != 0xFFFF)
+            {
+                return false;
+            }
+        }
+
+        for (; i < length; i++)
+        {
+            if ((data[i] & pattern.mask()[i]) != pattern.bytes()[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief SSE2 ядро: 16 позиций за итерацию по двум опорным байтам
+     */
+    template <typename OnMatch>
+    void scanSse2(const uint8_t* data, size_t size, const BytePattern& pattern, OnMatch&& onMatch)
+    {
+        const size_t  last    = size - pattern.size();
+        const size_t  anchor1 = pattern.anchor();
+        const size_t  anchor2 = pattern.secondAnchor();
+        const __m128i first   = _mm_set1_epi8(static_cast<char>(pattern.bytes()[anchor1]));
+        const __m128i second  = _mm_set1_epi8(static_cast<char>(pattern.bytes()[anchor2]));
+
+        size_t position = 0;
+        for (; position + 16 <= last + 1; position += 16)
+        {
+            const __m128i block1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position + anchor1));
+            const __m128i block2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position + anchor2));
+            uint32_t      bits   = static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block1, first), _mm_cmpeq_epi8(block2, second))));
+
+            while (bits)
+            {
+                const size_t candidate = position + std::countr_zero(bits);
+                if (matchesSse2(data + candidate, pattern) && !onMatch(candidate))
+                {
+                    return;
+                }
+                bits &= bits - 1;
+            }
+        }
+
+        scanScalar(data, size, pattern, position, onMatch);
+    }
+
+    /**
+     * @brief Проверка кандидата блоками по 32 байта
+     */
+    MDBOT_TARGET_AVX2 inline bool matchesAvx2(const uint8_t* data, const BytePattern& pattern)
+    {
+        const size_t length = pattern.size();
+        size_t       i      = 0;
+
+        for (; i + 32 <= length; i += 32)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const __m256i mask  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern.mask() + i));
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern.bytes() + i));
+            if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(block, mask), bytes)))
+                != 0xFFFFFFFFu)
+            {
+                return false;
+            }
+        }
+
+        for (; i < length; i++)
+        {
+            if ((data[i] & pattern.mask()[i]) != pattern.bytes()[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief AVX2 ядро: 32 позиции за итерацию по двум опорным байтам
+     */
+    template <typename OnMatch>
+    MDBOT_TARGET_AVX2 void scanAvx2(const uint8_t* data, size_t size, const BytePattern& pattern, OnMatch&& onMatch)
+    {
+        const size_t  last    = size - pattern.size();
+        const size_t  anchor1 = pattern.anchor();
+        const size_t  anchor2 = pattern.secondAnchor();
+        const __m256i first   = _mm256_set1_epi8(static_cast<char>(pattern.bytes()[anchor1]));
+        const __m256i second  = _mm256_set1_epi8(static_cast<char>(pattern.bytes()[anchor2]));
+
+        size_t position = 0;
+        for (; position + 32 <= last + 1; position += 32)
+        {
+            const __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position + anchor1));
+            const __m256i block2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position + anchor2));
+            uint32_t      bits   = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(block1, first), _mm256_cmpeq_epi8(block2, second))));
+
+            while (bits)
+            {
+                const size_t candidate = position + std::countr_zero(bits);
+                if (matchesAvx2(data + candidate, pattern) && !onMatch(candidate))
+                {
+                    return;
+                }
+                bits &= bits - 1;
+            }
+        }
+
+        scanScalar(data, size, pattern, position, onMatch);
+    }
+#endif
+
+    /**
+     * @brief Выбирает ядро по текущему уровню SIMD и выполняет поиск
+     */
+    template <typename OnMatch>
+    void scan(const uint8_t* data, size_t size, const BytePattern& pattern, OnMatch&& onMatch)
+    {
+        if (pattern.empty() || size < pattern.size())
+        {
+            return;
+        }
+
+        // Сигнатура из одних wildcard совпадает в любой позиции
+        if (!pattern.hasSignificantBytes())
+        {
+            for (size_t i = 0; i + pattern.size() <= size; i++)
+            {
+                if (!onMatch(i))
+                {
+                    return;
+                }
+            }
+            return;
+        }
+
+        switch (PatternScanner::simdLevel())
+        {
+#ifdef MDBOT_PATTERN_X86
+            case PatternScanner::SimdLevel::AVX2:
+                scanAvx2(data, size, pattern, onMatch);
+                return;
+            case PatternScanner::SimdLevel::SSE2:
+                scanSse2(data, size, pattern, onMatch);
+                return;
+#endif
+            default:
+                scanScalar(data, size, pattern, 0, onMatch);
+                return;
+        }
+    }
+} // namespace
+#pragma endregion Kernels
+
+#pragma region PatternScanner
+PatternScanner::SimdLevel PatternScanner::detectSimdLevel()
+{
+#ifdef MDBOT_PATTERN_X86
+    bool sse2 = false;
+    bool avx2 = false;
+
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    sse2               = (info[3] & (1 << 26)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+
+    if (maxLeaf >= 7 && osxsave && avx)
+    {
+        __cpuidex(info, 7, 0);
+        // ОС должна сохранять состояние YMM-регистров (XCR0 биты 1 и 2)
+        avx2 = (info[1] & (1 << 5)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    }
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        sse2               = (edx & (1u << 26)) != 0;
+        const bool osxsave = (ecx & (1u << 27)) != 0;
+        const bool avx     = (ecx & (1u << 28)) != 0;
+
+        if (osxsave && avx && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        {
+            unsigned int xcr0Low = 0, xcr0High = 0;
+            __asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+            avx2 = (ebx & (1u << 5)) != 0 && (xcr0Low & 0x6) == 0x6;
+        }
+    }
+#endif
+
+    if (avx2)
+    {
+        return SimdLevel::AVX2;
+    }
+    if (sse2)
+    {
+        return SimdLevel::SSE2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+PatternScanner::SimdLevel PatternScanner::simdLevel()
+{
+    int level = g_simdLevel.load(std::memory_order_relaxed);
+    if (level < 0)
+    {
+        level = static_cast<int>(detectSimdLevel());
+        g_simdLevel.store(level, std::memory_order_relaxed);
+    }
+    return static_cast<SimdLevel>(level);
+}
+
+void PatternScanner::setSimdLevel(SimdLevel level)
+{
+    const SimdLevel supported = detectSimdLevel();
+    g_simdLevel.store(static_cast<int>(std::min(level, supported)), std::memory_order_relaxed);
+}
+
+size_t PatternScanner::find(const uint8_t* data, size_t size, const BytePattern& pattern)
+{
+    size_t result = SIZE_MAX;
+    scan(data,
+         size,
+         pattern,
+         [&result](size_t offset)
+         {
+             result = offset;
+             return false;
+         });
+    return result;
+}
+
+void PatternScanner::findAll(const uint8_t* data, size_t size, const BytePattern& pattern, std::vector<size_t>& offsets)
+{
+    scan(data,
+         size,
+         pattern,
+         [&offsets](size_t offset)
+         {
+             offsets.push_back(offset);
+             return true;
+         });
+}
+#pragma endregion PatternScanner
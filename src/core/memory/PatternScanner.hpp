@@ -0,0 +1,250 @@
+/**
+ * @file PatternScanner.hpp
+ * @brief Поиск байтовых сигнатур с маской в локальном буфере
+ * @details Содержит SSE2/AVX2 ядра сравнения с маской и скалярный вариант.
+ * Ядра работают только с локальной памятью; обход регионов целевого процесса
+ * выполняет MemoryManager::FindPattern.
+ */
+#pragma once
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * @brief Вес байта для выбора опорных (anchor) байтов сигнатуры
+ * @details Чем меньше значение, тем реже байт встречается в машинном коде x86.
+ * Опорным выбирается самый редкий значимый байт, чтобы префильтр давал минимум ложных кандидатов.
+ */
+constexpr int patternByteWeight(uint8_t value)
+{
+    switch (value)
+    {
+        case 0x00:
+        case 0xFF:
+        case 0xCC:
+            return 100; // Выравнивание, заполнение, int3
+        case 0x8B:
+        case 0x89:
+        case 0x90:
+            return 90; // mov r/m, nop
+        case 0x83:
+        case 0xE8:
+        case 0x0F:
+        case 0x85:
+        case 0xC3:
+        case 0x55:
+        case 0x50:
+        case 0x51:
+        case 0x52:
+        case 0x53:
+        case 0x56:
+        case 0x57:
+        case 0x5D:
+        case 0x5E:
+        case 0x5F:
+        case 0x74:
+        case 0x75:
+        case 0xEB:
+        case 0xE9:
+        case 0x8D:
+        case 0xC7:
+        case 0x33:
+        case 0x01:
+        case 0x04:
+        case 0x08:
+        case 0x10:
+        case 0x24:
+        case 0x45:
+        case 0x4D:
+            return 60; // Частые опкоды и ModRM
+        default:
+            return 10;
+    }
+}
+
+/**
+ * @brief Выбирает два опорных байта сигнатуры по весу patternByteWeight
+ * @param bytes Байты сигнатуры
+ * @param mask Маска (ненулевой байт - значимый)
+ * @param size Длина сигнатуры
+ * @param anchor Смещение самого редкого значимого байта
+ * @param secondAnchor Смещение следующего по редкости значимого байта (или anchor, если он один)
+ * @return true если в сигнатуре есть значимые байты
+ * @details constexpr, чтобы одинаково работать и для сигнатур времени компиляции (Signature.hpp)
+ */
+constexpr bool selectPatternAnchors(
+    const uint8_t* bytes, const uint8_t* mask, size_t size, size_t& anchor, size_t& secondAnchor)
+{
+    bool found        = false;
+    bool foundSecond  = false;
+    int  bestWeight   = 0;
+    int  secondWeight = 0;
+    anchor            = 0;
+    secondAnchor      = 0;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        if (!mask[i])
+        {
+            continue;
+        }
+
+        const int weight = patternByteWeight(bytes[i]);
+        if (!found || weight < bestWeight)
+        {
+            // Прежний лучший байт становится вторым опорным
+            if (found)
+            {
+                secondAnchor = anchor;
+                secondWeight = bestWeight;
+                foundSecond  = true;
+            }
+            anchor     = i;
+            bestWeight = weight;
+            found      = true;
+        }
+        else if (!foundSecond || weight < secondWeight)
+        {
+            secondAnchor = i;
+            secondWeight = weight;
+            foundSecond  = true;
+        }
+    }
+
+    if (!foundSecond)
+    {
+        secondAnchor = anchor;
+    }
+    return found;
+}
+
+/**
+ * @class BytePattern
+ * @brief Сигнатура: байты + маска значимости
+ * @details Маска хранится побайтно: 0xFF - байт проверяется, 0x00 - пропускается.
+ * Байты сигнатуры заранее умножены на маску, что позволяет сравнивать блоки как
+ * ((data & mask) == bytes). При построении выбираются два опорных байта для префильтра.
+ */
+class BytePattern
+{
+  public:
+    BytePattern() = default;
+
+    /**
+     * @brief Создаёт сигнатуру в классическом формате
+     * @param pattern Байты сигнатуры
+     * @param mask Маска ('x' - проверять байт, '?' - пропустить), её длина задаёт длину сигнатуры
+     */
+    BytePattern(const char* pattern, const char* mask);
+
+    /**
+     * @brief Создаёт сигнатуру из готовых байтов и маски
+     * @param bytes Байты сигнатуры
+     * @param mask Маска (0xFF - проверять, 0x00 - пропустить), той же длины
+     */
+    BytePattern(std::vector<uint8_t> bytes, std::vector<uint8_t> mask);
+
+    /**
+     * @brief Создаёт сигнатуру с заранее выбранными опорными байтами
+     * @param bytes Байты сигнатуры, уже умноженные на маску
+     * @param mask Маска (только 0xFF и 0x00), той же длины
+     * @param anchor Смещение первого опорного байта (результат selectPatternAnchors)
+     * @param secondAnchor Смещение второго опорного байта
+     * @details Нормализация и выбор опорных байтов не выполняются: конструктор для
+     * сигнатур, разобранных при компиляции (Signature::toPattern).
+     */
+    BytePattern(std::vector<uint8_t> bytes, std::vector<uint8_t> mask, size_t anchor, size_t secondAnchor);
+
+    size_t         size() const { return m_bytes.size(); }
+    bool           empty() const { return m_bytes.empty(); }
+    const uint8_t* bytes() const { return m_bytes.data(); }
+    const uint8_t* mask() const { return m_mask.data(); }
+
+    /**
+     * @brief Смещение самого редкого значимого байта
+     */
+    size_t anchor() const { return m_anchor; }
+
+    /**
+     * @brief Смещение второго опорного байта (равно anchor(), если значимый байт один)
+     */
+    size_t secondAnchor() const { return m_secondAnchor; }
+
+    /**
+     * @brief Есть ли в сигнатуре хотя бы один значимый байт
+     */
+    bool hasSignificantBytes() const { return m_significant; }
+
+    /**
+     * @brief Проверяет совпадение сигнатуры с данными (данных должно быть не меньше size())
+     */
+    bool matches(const uint8_t* data) const;
+
+  private:
+    /**
+     * @brief Нормализует байты по маске и выбирает опорные байты
+     */
+    void prepare();
+
+    std::vector<uint8_t> m_bytes;              ///< Байты (уже умноженные на маску)
+    std::vector<uint8_t> m_mask;               ///< Маска значимости
+    size_t               m_anchor{0};          ///< Смещение первого опорного байта
+    size_t               m_secondAnchor{0};    ///< Смещение второго опорного байта
+    bool                 m_significant{false}; ///< Есть ли значимые байты
+};
+
+/**
+ * @class PatternScanner
+ * @brief Векторизованный поиск сигнатур в локальном буфере
+ * @details Префильтр сравнивает сразу 16/32 позиции по двум опорным байтам,
+ * кандидаты проверяются сравнением блоков с маской. Уровень SIMD выбирается
+ * один раз по возможностям процессора, скалярный вариант используется как запасной.
+ */
+class PatternScanner
+{
+  public:
+    /**
+     * @brief Набор инструкций, используемый ядром поиска
+     */
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * @brief Определяет лучший поддерживаемый процессором уровень SIMD
+     */
+    static SimdLevel detectSimdLevel();
+
+    /**
+     * @brief Текущий уровень SIMD (по умолчанию - detectSimdLevel())
+     */
+    static SimdLevel simdLevel();
+
+    /**
+     * @brief Принудительно задаёт уровень SIMD (не выше поддерживаемого)
+     */
+    static void setSimdLevel(SimdLevel level);
+
+    /**
+     * @brief Ищет первое вхождение сигнатуры
+     * @param data Буфер
+     * @param size Размер буфера
+     * @param pattern Сигнатура
+     * @return Смещение найденного вхождения или SIZE_MAX
+     */
+    static size_t find(const uint8_t* data, size_t size, const BytePattern& pattern);
+
+    /**
+     * @brief Ищет все вхождения сигнатуры
+     * @param data Буфер
+     * @param size Размер буфера
+     * @param pattern Сигнатура
+     * @param offsets Сюда добавляются смещения найденных вхождений
+     */
+    static void findAll(const uint8_t* data, size_t size, const BytePattern& pattern, std::vector<size_t>& offsets);
+};
@@ -0,0 +1,443 @@
+#include "PeImage.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "MemoryManager.hpp"
+
+
+namespace
+{
+    constexpr size_t SECTION_HEADER_SIZE    = 40;      ///< IMAGE_SECTION_HEADER
+    constexpr size_t EXPORT_DIRECTORY_SIZE  = 40;      ///< IMAGE_EXPORT_DIRECTORY
+    constexpr size_t IMPORT_DESCRIPTOR_SIZE = 20;      ///< IMAGE_IMPORT_DESCRIPTOR
+    constexpr size_t MAX_STRING_LENGTH      = 512;     ///< Предел длины имени в таблицах
+    constexpr size_t MAX_IMPORT_MODULES     = 4096;    ///< Предел дескрипторов импорта
+    constexpr size_t MAX_THUNKS             = 0x10000; ///< Предел функций одной DLL
+
+    uint32_t readU16(const uint8_t* data)
+    {
+        return data[0] | (data[1] << 8);
+    }
+
+    uint32_t readU32(const uint8_t* data)
+    {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    uint64_t readU64(const uint8_t* data)
+    {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    std::string toLower(std::string_view text)
+    {
+        std::string result(text);
+        std::transform(result.begin(),
+                       result.end(),
+                       result.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return result;
+    }
+} // namespace
+
+
+bool PeImage::parse(MemoryManager& memory, uintptr_t base, size_t size)
+{
+    *this  = PeImage();
+    m_base = base;
+    m_size = size;
+
+    if (!parseHeaders(memory))
+    {
+        return false;
+    }
+    m_valid = true;
+
+    // Ошибка в одном каталоге не мешает разобрать другой
+    m_sectionData.resize(m_sections.size());
+    parseExports(memory);
+    parseImports(memory);
+    m_sectionData.clear();
+    m_sectionData.shrink_to_fit();
+
+    m_stats.exports = m_exports.size();
+    m_stats.imports = m_imports.size();
+    return true;
+}
+
+bool PeImage::parseHeaders(MemoryManager& memory)
+{
+    if (m_size < 0x40 || !readImage(memory, 0, m_headers, std::min(HEADERS_SIZE, m_size)))
+    {
+        m_error = "Failed to read PE headers";
+        return false;
+    }
+
+    auto u16 = [this](size_t offset) -> uint32_t
+    { return offset + 2 <= m_headers.size() ? readU16(m_headers.data() + offset) : 0; };
+    auto u32 = [this](size_t offset) -> uint32_t
+    { return offset + 4 <= m_headers.size() ? readU32(m_headers.data() + offset) : 0; };
+
+    // DOS-заголовок "MZ" -> e_lfanew -> сигнатура "PE\0\0"
+    const size_t ntOffset = u32(0x3C);
+    if (u16(0) != 0x5A4D || u32(ntOffset) != 0x00004550)
+    {
+        m_error = "Invalid PE headers";
+        return false;
+    }
+
+    const size_t   fileHeader   = ntOffset + 4;
+    const uint32_t sectionCount = u16(fileHeader + 2);
+    const uint32_t optionalSize = u16(fileHeader + 16);
+    const size_t   optional     = fileHeader + 20;
+    m_timeDateStamp             = u32(fileHeader + 4);
+
+    const uint32_t magic = u16(optional);
+    if (magic != 0x10B && magic != 0x20B)
+    {
+        m_error = "Unknown optional header magic";
+        return false;
+    }
+    m_is64 = magic == 0x20B;
+
+    // Таблица секций может не поместиться в первую страницу - дочитываем до SizeOfHeaders
+    const size_t sectionTable = optional + optionalSize;
+    const size_t tableEnd     = sectionTable + sectionCount * SECTION_HEADER_SIZE;
+    if (tableEnd > m_headers.size())
+    {
+        const size_t headersSize = std::min({std::max<size_t>(u32(optional + 60), tableEnd), MAX_HEADERS_SIZE, m_size});
+        if (tableEnd > headersSize || !readImage(memory, 0, m_headers, headersSize))
+        {
+            m_error = "Section table is outside of readable headers";
+            return false;
+        }
+    }
+
+    const uint32_t entryPoint = u32(optional + 16);
+    m_entryPoint              = entryPoint ? m_base + entryPoint : 0;
+
+    const uint32_t directoryCount = u32(optional + (m_is64 ? 108 : 92));
+    const size_t   directories    = optional + (m_is64 ? 112 : 96);
+    if (directoryCount > 0)
+    {
+        m_exportDirectory = DataDirectory{u32(directories), u32(directories + 4)};
+    }
+    if (directoryCount > 1)
+    {
+        m_importDirectory = DataDirectory{u32(directories + 8), u32(directories + 12)};
+    }
+
+    m_sections.reserve(sectionCount);
+    for (uint32_t i = 0; i < sectionCount; i++)
+    {
+        const uint8_t* header = m_headers.data() + sectionTable + i * SECTION_HEADER_SIZE;
+
+        PeSection section;
+        section.name.assign(reinterpret_cast<const char*>(header), strnlen(reinterpret_cast<const char*>(header), 8));
+        section.virtualSize     = readU32(header + 8);
+        section.rva             = readU32(header + 12);
+        section.characteristics = readU32(header + 36);
+        if (section.virtualSize == 0)
+        {
+            section.virtualSize = readU32(header + 16); // SizeOfRawData
+        }
+        m_sections.push_back(std::move(section));
+    }
+    return true;
+}
+
+bool PeImage::parseExports(MemoryManager& memory)
+{
+    const DataDirectory directory = m_exportDirectory;
+    if (directory.rva == 0)
+    {
+        return true;
+    }
+
+    const uint8_t* header = at(memory, directory.rva, EXPORT_DIRECTORY_SIZE);
+    if (!header)
+    {
+        m_error = "Failed to read export directory";
+        return false;
+    }
+
+    const uint32_t ordinalBase   = readU32(header + 16);
+    const uint32_t functionCount = readU32(header + 20);
+    const uint32_t nameCount     = readU32(header + 24);
+    if (functionCount > 0x10000 || nameCount > functionCount)
+    {
+        m_error = "Invalid export directory";
+        return false;
+    }
+
+    const uint8_t* functions = at(memory, readU32(header + 28), functionCount * 4);
+    const uint8_t* names     = at(memory, readU32(header + 32), nameCount * 4);
+    const uint8_t* ordinals  = at(memory, readU32(header + 36), nameCount * 2);
+    if ((functionCount && !functions) || (nameCount && (!names || !ordinals)))
+    {
+        m_error = "Failed to read export tables";
+        return false;
+    }
+
+    std::vector<size_t> exportIndex(functionCount, SIZE_MAX);
+    m_exports.reserve(functionCount);
+    for (uint32_t i = 0; i < functionCount; i++)
+    {
+        const uint32_t rva = readU32(functions + i * 4);
+        if (rva == 0)
+        {
+            continue;
+        }
+
+        PeExport entry;
+        entry.ordinal = static_cast<uint16_t>(ordinalBase + i);
+        // RVA внутри каталога экспорта - строка перенаправления "dll.Function"
+        if (rva >= directory.rva && rva - directory.rva < directory.size)
+        {
+            entry.forwarder = stringAt(memory, rva);
+        }
+        else
+        {
+            entry.address = m_base + rva;
+        }
+
+        exportIndex[i] = m_exports.size();
+        m_exportsByOrdinal.emplace(entry.ordinal, m_exports.size());
+        m_exports.push_back(std::move(entry));
+    }
+
+    for (uint32_t i = 0; i < nameCount; i++)
+    {
+        const uint32_t function = readU16(ordinals + i * 2);
+        if (function >= functionCount || exportIndex[function] == SIZE_MAX)
+        {
+            continue;
+        }
+
+        const std::string_view name = stringAt(memory, readU32(names + i * 4));
+        if (name.empty())
+        {
+            continue;
+        }
+
+        // Несколько имён одной функции: в PeExport остаётся первое, в индекс попадают все
+        PeExport& entry = m_exports[exportIndex[function]];
+        if (entry.name.empty())
+        {
+            entry.name = name;
+        }
+        m_exportsByName.emplace(std::string(name), exportIndex[function]);
+    }
+    return true;
+}
+
+bool PeImage::parseImports(MemoryManager& memory)
+{
+    if (m_importDirectory.rva == 0)
+    {
+        return true;
+    }
+
+    const size_t   pointerSize = m_is64 ? 8 : 4;
+    const uint64_t ordinalFlag = m_is64 ? 1ull << 63 : 1ull << 31;
+
+    for (size_t module = 0; module < MAX_IMPORT_MODULES; module++)
+    {
+        const uint32_t descriptorRva = static_cast<uint32_t>(m_importDirectory.rva + module * IMPORT_DESCRIPTOR_SIZE);
+        const uint8_t* descriptor    = at(memory, descriptorRva, IMPORT_DESCRIPTOR_SIZE);
+        if (!descriptor)
+        {
+            m_error = "Failed to read import directory";
+            return false;
+        }
+
+        const uint32_t lookupTable = readU32(descriptor);
+        const uint32_t nameRva     = readU32(descriptor + 12);
+        const uint32_t firstThunk  = readU32(descriptor + 16);
+        if (nameRva == 0 && firstThunk == 0)
+        {
+            return true; // Нулевой дескриптор завершает каталог
+        }
+
+        const std::string moduleName = toLower(stringAt(memory, nameRva));
+        if (moduleName.empty())
+        {
+            m_error = "Failed to read imported module name";
+            continue;
+        }
+
+        // Имена берутся из таблицы поиска (OriginalFirstThunk): IAT загрузчик уже заполнил адресами
+        const uint32_t names = lookupTable ? lookupTable : firstThunk;
+        for (size_t i = 0; i < MAX_THUNKS; i++)
+        {
+            const uint32_t offset = static_cast<uint32_t>(i * pointerSize);
+            const uint8_t* lookup = at(memory, names + offset, pointerSize);
+            const uint8_t* slot   = at(memory, firstThunk + offset, pointerSize);
+            if (!lookup || !slot)
+            {
+                m_error = "Failed to read import thunks of " + moduleName;
+                break;
+            }
+
+            const uint64_t value = m_is64 ? readU64(lookup) : readU32(lookup);
+            if (value == 0)
+            {
+                break;
+            }
+
+            PeImport entry;
+            entry.module = moduleName;
+            entry.slot   = m_base + firstThunk + offset;
+            entry.target = static_cast<uintptr_t>(m_is64 ? readU64(slot) : readU32(slot));
+            if (value & ordinalFlag)
+            {
+                entry.ordinal = static_cast<uint16_t>(value);
+                entry.name    = "#" + std::to_string(entry.ordinal);
+            }
+            else
+            {
+                // IMAGE_IMPORT_BY_NAME: подсказка (WORD) и имя
+                const uint8_t* hint = at(memory, static_cast<uint32_t>(value), 2);
+                entry.name          = stringAt(memory, static_cast<uint32_t>(value) + 2);
+                if (!hint || entry.name.empty())
+                {
+                    continue;
+                }
+                entry.ordinal = static_cast<uint16_t>(readU16(hint));
+            }
+
+            m_importsByKey.emplace(importKey(entry.module, entry.name), m_imports.size());
+            m_imports.push_back(std::move(entry));
+        }
+    }
+    return true;
+}
+
+const PeSection* PeImage::section(std::string_view name) const
+{
+    for (const PeSection& section : m_sections)
+    {
+        if (section.name == name)
+        {
+            return &section;
+        }
+    }
+    return nullptr;
+}
+
+bool PeImage::sectionRange(std::string_view name, uintptr_t& start, uintptr_t& end) const
+{
+    const PeSection* found = section(name);
+    if (!found || found->rva >= m_size)
+    {
+        return false;
+    }
+
+    start = m_base + found->rva;
+    end   = start + sectionSize(*found);
+    return true;
+}
+
+const PeExport* PeImage::findExport(std::string_view name) const
+{
+    auto it = m_exportsByName.find(std::string(name));
+    return it != m_exportsByName.end() ? &m_exports[it->second] : nullptr;
+}
+
+const PeExport* PeImage::findExport(uint16_t ordinal) const
+{
+    auto it = m_exportsByOrdinal.find(ordinal);
+    return it != m_exportsByOrdinal.end() ? &m_exports[it->second] : nullptr;
+}
+
+const PeImport* PeImage::findImport(std::string_view module, std::string_view name) const
+{
+    auto it = m_importsByKey.find(importKey(module, name));
+    return it != m_importsByKey.end() ? &m_imports[it->second] : nullptr;
+}
+
+size_t PeImage::sectionSize(const PeSection& section) const
+{
+    return section.rva < m_size ? std::min<size_t>(section.virtualSize, m_size - section.rva) : 0;
+}
+
+std::span<const uint8_t> PeImage::tail(MemoryManager& memory, uint32_t rva)
+{
+    if (rva < m_headers.size())
+    {
+        return std::span<const uint8_t>(m_headers).subspan(rva);
+    }
+
+    for (size_t i = 0; i < m_sections.size() && i < m_sectionData.size(); i++)
+    {
+        const PeSection& section = m_sections[i];
+        const size_t     size    = sectionSize(section);
+        if (rva < section.rva || rva - section.rva >= size)
+        {
+            continue;
+        }
+
+        SectionData& data = m_sectionData[i];
+        if (!data.loaded)
+        {
+            data.loaded = true;
+            readImage(memory, section.rva, data.bytes, size);
+        }
+        if (data.bytes.empty())
+        {
+            return {};
+        }
+        return std::span<const uint8_t>(data.bytes).subspan(rva - section.rva);
+    }
+    return {};
+}
+
+const uint8_t* PeImage::at(MemoryManager& memory, uint32_t rva, size_t size)
+{
+    const auto bytes = tail(memory, rva);
+    return bytes.size() >= size && !bytes.empty() ? bytes.data() : nullptr;
+}
+
+std::string_view PeImage::stringAt(MemoryManager& memory, uint32_t rva)
+{
+    if (rva == 0)
+    {
+        return {};
+    }
+
+    const auto bytes  = tail(memory, rva);
+    const auto limit  = bytes.begin() + std::min(bytes.size(), MAX_STRING_LENGTH);
+    const auto string = std::find(bytes.begin(), limit, 0);
+    if (string == limit)
+    {
+        return {};
+    }
+    return std::string_view(reinterpret_cast<const char*>(bytes.data()), string - bytes.begin());
+}
+
+bool PeImage::readImage(MemoryManager& memory, uint32_t rva, std::vector<uint8_t>& buffer, size_t size)
+{
+    buffer.resize(size);
+    m_stats.reads++;
+    if (memory.TryReadMemory(m_base + rva, buffer.data(), size) != ReadError::None)
+    {
+        buffer.clear();
+        return false;
+    }
+    m_stats.bytesRead += size;
+    return true;
+}
+
+std::string PeImage::importKey(std::string_view module, std::string_view name)
+{
+    std::string key = toLower(module);
+    key += '!';
+    key += name;
+    return key;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file PeImage.hpp
+ * @brief Разбор PE-образа модуля прямо из памяти целевого процесса
+ * @details Пример (слот IAT и диапазон кода run.exe):
+ * @code
+ * const PeImage* image = memory.GetModuleImage(L"run.exe");
+ * if (image)
+ * {
+ *     uintptr_t slot = image->importSlot("kernel32.dll", "GetTickCount");
+ *     uintptr_t start = 0, end = 0;
+ *     image->sectionRange(".text", start, end);
+ * }
+ * @endcode
+ */
+#pragma once
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+class MemoryManager;
+
+
+/**
+ * @brief Секция образа
+ */
+struct PeSection
+{
+    static constexpr uint32_t EXECUTE = 0x20000000; ///< IMAGE_SCN_MEM_EXECUTE
+    static constexpr uint32_t WRITE   = 0x80000000; ///< IMAGE_SCN_MEM_WRITE
+
+    std::string name;               ///< Имя (".text", ".rdata", ...)
+    uint32_t    rva{0};             ///< Смещение от базы образа
+    uint32_t    virtualSize{0};     ///< Размер в памяти
+    uint32_t    characteristics{0}; ///< Флаги IMAGE_SCN_*
+
+    bool isExecutable() const { return characteristics & EXECUTE; }
+    bool isWritable() const { return characteristics & WRITE; }
+};
+
+/**
+ * @brief Экспортируемая функция
+ */
+struct PeExport
+{
+    std::string name;       ///< Имя (пусто для экспорта только по ординалу)
+    uint16_t    ordinal{0}; ///< Ординал (с учётом Base каталога экспорта)
+    uintptr_t   address{0}; ///< Абсолютный адрес (0 для перенаправленного экспорта)
+    std::string forwarder;  ///< "dll.Function" для перенаправленного экспорта
+};
+
+/**
+ * @brief Импортируемая функция
+ */
+struct PeImport
+{
+    std::string module;     ///< Имя DLL в нижнем регистре
+    std::string name;       ///< Имя функции ("#<ординал>" для импорта по ординалу)
+    uint16_t    ordinal{0}; ///< Ординал (для импорта по имени - подсказка)
+    uintptr_t   slot{0};    ///< Абсолютный адрес слота IAT
+    uintptr_t   target{0};  ///< Значение слота на момент разбора
+};
+
+/**
+ * @brief Статистика разбора PeImage
+ */
+struct PeImageStats
+{
+    size_t reads{0};     ///< Чтения памяти процесса
+    size_t bytesRead{0}; ///< Прочитано байт
+    size_t exports{0};   ///< Экспорты
+    size_t imports{0};   ///< Импорты
+};
+
+/**
+ * @class PeImage
+ * @brief Заголовки, таблица секций, импорт и экспорт загруженного модуля
+ * @details parse() читает страницу заголовков одним вызовом и разбирает из неё DOS/NT-заголовки и
+ * таблицу секций. Каталоги импорта и экспорта разбираются из секций, в которых они лежат: каждая
+ * такая секция (обычно .rdata или .idata) читается целиком один раз, после чего все таблицы, имена
+ * и слоты IAT берутся из буфера. В итоге разбор образа - несколько крупных чтений вместо чтения на
+ * каждое имя. После разбора буферы секций освобождаются, поиск импорта и экспорта по имени - обращение
+ * к хэш-таблице без чтения памяти. Поддерживаются PE32 и PE32+.
+ * Менеджер памяти не хранится, он передаётся в parse().
+ */
+class PeImage
+{
+  public:
+    static constexpr size_t HEADERS_SIZE     = 0x1000;  ///< Размер первого чтения заголовков
+    static constexpr size_t MAX_HEADERS_SIZE = 0x10000; ///< Предел SizeOfHeaders
+
+    /**
+     * @brief Разбирает образ
+     * @param memory Менеджер памяти процесса
+     * @param base Базовый адрес модуля
+     * @param size Размер образа в памяти
+     * @return false если заголовки не читаются или не являются PE; ошибки разбора импорта и
+     * экспорта не делают образ недействительным (см. error())
+     */
+    bool parse(MemoryManager& memory, uintptr_t base, size_t size);
+
+    /**
+     * @brief Заголовки успешно разобраны
+     */
+    bool isValid() const { return m_valid; }
+
+    uintptr_t base() const { return m_base; }
+    size_t    size() const { return m_size; }
+    bool      is64Bit() const { return m_is64; }
+
+    /**
+     * @brief Поле TimeDateStamp заголовка файла
+     */
+    uint32_t timeDateStamp() const { return m_timeDateStamp; }
+
+    /**
+     * @brief Абсолютный адрес точки входа (0 если её нет)
+     */
+    uintptr_t entryPoint() const { return m_entryPoint; }
+
+    /**
+     * @brief Прочитанные байты заголовков (не меньше первых HEADERS_SIZE байт образа, если образ не меньше)
+     */
+    std::span<const uint8_t> headers() const { return m_headers; }
+
+    /**
+     * @brief Секции в порядке таблицы секций
+     */
+    const std::vector<PeSection>& sections() const { return m_sections; }
+
+    /**
+     * @brief Находит секцию по имени
+     * @return Первая секция с таким именем или nullptr
+     */
+    const PeSection* section(std::string_view name) const;
+
+    /**
+     * @brief Абсолютный диапазон секции [start, end), обрезанный по размеру образа
+     * @return false если секции нет
+     */
+    bool sectionRange(std::string_view name, uintptr_t& start, uintptr_t& end) const;
+
+    /**
+     * @brief Экспорты по возрастанию ординалов
+     */
+    const std::vector<PeExport>& exports() const { return m_exports; }
+
+    /**
+     * @brief Находит экспорт по имени (с учётом регистра)
+     */
+    const PeExport* findExport(std::string_view name) const;
+
+    /**
+     * @brief Находит экспорт по ординалу
+     */
+    const PeExport* findExport(uint16_t ordinal) const;
+
+    /**
+     * @brief Импорты в порядке каталога импорта
+     */
+    const std::vector<PeImport>& imports() const { return m_imports; }
+
+    /**
+     * @brief Находит импорт
+     * @param module Имя DLL (без учёта регистра)
+     * @param name Имя функции (с учётом регистра) или "#<ординал>"
+     */
+    const PeImport* findImport(std::string_view module, std::string_view name) const;
+
+    /**
+     * @brief Адрес слота IAT импортируемой функции
+     * @return 0 если функция не импортируется
+     */
+    uintptr_t importSlot(std::string_view module, std::string_view name) const
+    {
+        const PeImport* import = findImport(module, name);
+        return import ? import->slot : 0;
+    }
+
+    /**
+     * @brief Статистика последнего разбора
+     */
+    const PeImageStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Описание последней ошибки
+     */
+    const std::string& error() const { return m_error; }
+
+  private:
+    /**
+     * @brief Буфер секции, прочитанной во время разбора
+     */
+    struct SectionData
+    {
+        bool                 loaded{false}; ///< Чтение выполнялось
+        std::vector<uint8_t> bytes;         ///< Байты секции (пусто, если чтение не удалось)
+    };
+
+    /**
+     * @brief Элемент каталога данных (IMAGE_DATA_DIRECTORY)
+     */
+    struct DataDirectory
+    {
+        uint32_t rva{0};  ///< Смещение от базы образа (0 - каталога нет)
+        uint32_t size{0}; ///< Размер
+    };
+
+    /**
+     * @brief Разбирает NT-заголовки и таблицу секций
+     */
+    bool parseHeaders(MemoryManager& memory);
+
+    /**
+     * @brief Разбирает каталог экспорта
+     */
+    bool parseExports(MemoryManager& memory);
+
+    /**
+     * @brief Разбирает каталог импорта
+     */
+    bool parseImports(MemoryManager& memory);
+
+    /**
+     * @brief Размер секции в памяти, обрезанный по размеру образа
+     */
+    size_t sectionSize(const PeSection& section) const;
+
+    /**
+     * @brief Прочитанные байты от RVA до конца заголовков или секции
+     * @details Секция читается целиком при первом обращении к ней
+     * @return Пустой участок, если RVA не попадает в прочитанные данные
+     */
+    std::span<const uint8_t> tail(MemoryManager& memory, uint32_t rva);
+
+    /**
+     * @brief Указатель на size байт по RVA
+     * @return nullptr если участок не прочитан или пересекает границу секции
+     */
+    const uint8_t* at(MemoryManager& memory, uint32_t rva, size_t size);
+
+    /**
+     * @brief Строка с нуль-терминатором по RVA (пусто, если она не прочитана)
+     */
+    std::string_view stringAt(MemoryManager& memory, uint32_t rva);
+
+    /**
+     * @brief Читает участок образа одним вызовом
+     */
+    bool readImage(MemoryManager& memory, uint32_t rva, std::vector<uint8_t>& buffer, size_t size);
+
+    /**
+     * @brief Ключ таблицы импорта: "dll!function", имя DLL в нижнем регистре
+     */
+    static std::string importKey(std::string_view module, std::string_view name);
+
+    uintptr_t m_base{0};          ///< База образа
+    size_t    m_size{0};          ///< Размер образа
+    bool      m_valid{false};     ///< Заголовки разобраны
+    bool      m_is64{false};      ///< PE32+
+    uint32_t  m_timeDateStamp{0}; ///< TimeDateStamp
+    uintptr_t m_entryPoint{0};    ///< Точка входа
+
+    DataDirectory m_exportDirectory; ///< Каталог экспорта
+    DataDirectory m_importDirectory; ///< Каталог импорта
+
+    std::vector<uint8_t>     m_headers;     ///< Байты заголовков
+    std::vector<PeSection>   m_sections;    ///< Таблица секций
+    std::vector<SectionData> m_sectionData; ///< Буферы секций на время разбора
+
+    std::vector<PeExport>                   m_exports;          ///< Экспорты
+    std::unordered_map<std::string, size_t> m_exportsByName;    ///< Имя -> индекс экспорта
+    std::unordered_map<uint16_t, size_t>    m_exportsByOrdinal; ///< Ординал -> индекс экспорта
+    std::vector<PeImport>                   m_imports;          ///< Импорты
+    std::unordered_map<std::string, size_t> m_importsByKey;     ///< "dll!function" -> индекс импорта
+
+    PeImageStats m_stats; ///< Статистика
+    std::string  m_error; ///< Последняя ошибка
+};
@@ -0,0 +1,100 @@
+/**
+ * @file Platform.hpp
+ * @brief Минимальная совместимость с WinAPI для сборки движка памяти вне Windows
+ * @details На Windows просто подключает windows.h. На других платформах объявляет
+ * используемые MemoryManager типы (DWORD, HANDLE), флаги PAGE_* / MEM_*, коды ошибок
+ * и GetLastError/SetLastError поверх thread_local-переменной. Значения флагов и кодов
+ * совпадают с WinAPI, поэтому регионы, снятые на Windows, читаются на Linux без пересчёта.
+ */
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdint>
+
+using DWORD  = uint32_t;
+using BOOL   = int;
+using HANDLE = void*;
+
+#ifndef FALSE
+#define FALSE 0
+#endif
+#ifndef TRUE
+#define TRUE 1
+#endif
+
+// Права доступа к страницам
+constexpr DWORD PAGE_NOACCESS          = 0x01;
+constexpr DWORD PAGE_READONLY          = 0x02;
+constexpr DWORD PAGE_READWRITE         = 0x04;
+constexpr DWORD PAGE_WRITECOPY         = 0x08;
+constexpr DWORD PAGE_EXECUTE           = 0x10;
+constexpr DWORD PAGE_EXECUTE_READ      = 0x20;
+constexpr DWORD PAGE_EXECUTE_READWRITE = 0x40;
+constexpr DWORD PAGE_EXECUTE_WRITECOPY = 0x80;
+constexpr DWORD PAGE_GUARD             = 0x100;
+
+// Состояние и тип регионов
+constexpr DWORD MEM_COMMIT  = 0x1000;
+constexpr DWORD MEM_RESERVE = 0x2000;
+constexpr DWORD MEM_FREE    = 0x10000;
+constexpr DWORD MEM_PRIVATE = 0x20000;
+constexpr DWORD MEM_MAPPED  = 0x40000;
+constexpr DWORD MEM_IMAGE   = 0x1000000;
+
+// Коды ошибок
+constexpr DWORD ERROR_SUCCESS           = 0;
+constexpr DWORD ERROR_FILE_NOT_FOUND    = 2;
+constexpr DWORD ERROR_ACCESS_DENIED     = 5;
+constexpr DWORD ERROR_INVALID_HANDLE    = 6;
+constexpr DWORD ERROR_NOT_SUPPORTED     = 50;
+constexpr DWORD ERROR_INVALID_PARAMETER = 87;
+constexpr DWORD ERROR_PARTIAL_COPY      = 299;
+constexpr DWORD ERROR_INVALID_ADDRESS   = 487;
+constexpr DWORD ERROR_NOACCESS          = 998;
+
+namespace platform_detail
+{
+    inline thread_local DWORD lastError = ERROR_SUCCESS;
+}
+
+inline DWORD GetLastError()
+{
+    return platform_detail::lastError;
+}
+
+inline void SetLastError(DWORD error)
+{
+    platform_detail::lastError = error;
+}
+#endif
+
+/**
+ * @brief Проверяет, разрешено ли чтение при данных правах доступа (PAGE_*)
+ */
+inline bool isReadableProtection(DWORD protection)
+{
+    if (protection & (PAGE_GUARD | PAGE_NOACCESS))
+    {
+        return false;
+    }
+
+    constexpr DWORD readable = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ
+                               | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    return (protection & readable) != 0;
+}
+
+/**
+ * @brief Проверяет, разрешена ли запись при данных правах доступа (PAGE_*)
+ */
+inline bool isWritableProtection(DWORD protection)
+{
+    if (protection & (PAGE_GUARD | PAGE_NOACCESS))
+    {
+        return false;
+    }
+
+    constexpr DWORD writable = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    return (protection & writable) != 0;
+}
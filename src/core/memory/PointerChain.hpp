@@ -0,0 +1,198 @@
+/**
+ * @file PointerChain.hpp
+ * @brief Цепочка указателей со смещениями, заданными на этапе компиляции
+ * @details Пример (статическая база -> менеджер объектов -> первый объект):
+ * @code
+ * PointerChain<0xC79CE0, 0x2ED0, 0xAC> firstObject;
+ * firstObject.setLinkLifetime(0, PointerChain<0xC79CE0, 0x2ED0, 0xAC>::FOREVER);
+ * uintptr_t address = 0;
+ * if (firstObject.resolve(memory, address)) { ... }
+ * @endcode
+ */
+#pragma once
+#include <array>
+#include <limits>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MemoryManager.hpp"
+
+
+/**
+ * @class PointerChain
+ * @brief Разыменование цепочки [[[Base] + O0] + O1] ... + On за один вызов
+ * @tparam Base Абсолютный адрес статического указателя
+ * @tparam Offsets Смещения уровней; последнее смещение прибавляется к последнему указателю без чтения
+ * @details Звено i - это указатель, прочитанный на i-м уровне. Каждое звено хранит эпоху
+ * (номер тика MemoryManager), в которую было прочитано, и остаётся действительным
+ * заданное количество тиков. Стабильный префикс цепочки (например, указатель на менеджер
+ * объектов) перечитывается только когда истекает его срок, остальные звенья - каждый тик.
+ * Если значение звена изменилось, все последующие звенья перечитываются. Пока у менеджера не начат
+ * ни один тик (MemoryManager::IsTicking()), эпоха не движется, и кэшируются только звенья со сроком FOREVER.
+ * Цепочка не хранит ссылку на MemoryManager (он перемещаемый), менеджер передаётся в resolve().
+ */
+template <uintptr_t Base, ptrdiff_t... Offsets>
+class PointerChain
+{
+  public:
+    static constexpr size_t   LINK_COUNT = sizeof...(Offsets); ///< Количество читаемых звеньев
+    static constexpr uint64_t FOREVER    = std::numeric_limits<uint64_t>::max(); ///< Звено не истекает
+
+    static_assert(LINK_COUNT > 0, "PointerChain requires at least one offset");
+
+    /**
+     * @brief Счётчики работы цепочки
+     */
+    struct Stats
+    {
+        uint64_t resolutions{0}; ///< Вызовы resolve()
+        uint64_t failures{0};    ///< Неудачные разрешения (нулевой указатель или ошибка чтения)
+        uint64_t linkReads{0};   ///< Фактические чтения звеньев из памяти цели
+        uint64_t linkHits{0};    ///< Звенья, взятые из кэша
+
+        /**
+         * @brief Среднее количество чтений на одно разрешение
+         */
+        double readsPerResolution() const
+        {
+            return resolutions ? static_cast<double>(linkReads) / static_cast<double>(resolutions) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Смещения уровней цепочки
+     */
+    static constexpr std::array<ptrdiff_t, LINK_COUNT> offsets() { return {Offsets...}; }
+
+    /**
+     * @brief Задаёт срок жизни звена в тиках
+     * @param link Индекс звена (0 - указатель по адресу Base)
+     * @param ticks Количество тиков (1 - только текущий тик, 0 - не кэшировать, FOREVER - до invalidate())
+     */
+    void setLinkLifetime(size_t link, uint64_t ticks)
+    {
+        if (link < LINK_COUNT)
+        {
+            m_lifetimes[link] = ticks;
+        }
+    }
+
+    /**
+     * @brief Разрешает цепочку в конечный адрес
+     * @param memory Менеджер памяти процесса
+     * @param address Сюда записывается конечный адрес (последний указатель + последнее смещение)
+     * @return false если одно из звеньев нулевое или не прочиталось
+     */
+    bool resolve(MemoryManager& memory, uintptr_t& address)
+    {
+        constexpr auto OFFSETS = offsets();
+
+        const uint64_t epoch   = memory.GetTickEpoch();
+        const bool     ticking = memory.IsTicking();
+        uintptr_t      source  = Base;
+        bool           reread = false; ///< Предыдущее звено изменилось - дальше кэшу верить нельзя
+
+        m_stats.resolutions++;
+        for (size_t i = 0; i < LINK_COUNT; i++)
+        {
+            if (!reread && isLinkValid(i, epoch, ticking))
+            {
+                m_stats.linkHits++;
+            }
+            else
+            {
+                uintptr_t value = 0;
+                m_stats.linkReads++;
+                if (memory.TryReadMemory(source, &value, sizeof(value)) != ReadError::None || value == 0)
+                {
+                    invalidateFrom(i);
+                    m_stats.failures++;
+                    return false;
+                }
+
+                reread      = reread || !m_valid[i] || value != m_links[i];
+                m_links[i]  = value;
+                m_epochs[i] = epoch;
+                m_valid[i]  = true;
+            }
+
+            source = m_links[i] + static_cast<uintptr_t>(OFFSETS[i]);
+        }
+
+        address = source;
+        return true;
+    }
+
+    /**
+     * @brief Разрешает цепочку и читает значение по конечному адресу
+     * @tparam T Тип значения
+     * @return false если цепочка не разрешилась или значение не прочиталось
+     */
+    template <typename T>
+    bool read(MemoryManager& memory, T& value)
+    {
+        uintptr_t address = 0;
+        return resolve(memory, address) && memory.TryReadMemory(address, &value, sizeof(T)) == ReadError::None;
+    }
+
+    /**
+     * @brief Сбрасывает все закэшированные звенья
+     */
+    void invalidate() { invalidateFrom(0); }
+
+    /**
+     * @brief Получает счётчики цепочки
+     */
+    const Stats& stats() const { return m_stats; }
+
+    /**
+     * @brief Сбрасывает счётчики цепочки
+     */
+    void resetStats() { m_stats = Stats{}; }
+
+  private:
+    /**
+     * @brief Проверяет, не истёк ли срок закэшированного звена
+     * @param ticking false - тиков нет, и срок в тиках не истекает никогда: верим только звеньям FOREVER
+     */
+    bool isLinkValid(size_t link, uint64_t epoch, bool ticking) const
+    {
+        if (!m_valid[link])
+        {
+            return false;
+        }
+        if (m_lifetimes[link] == FOREVER)
+        {
+            return true;
+        }
+        return ticking && epoch >= m_epochs[link] && epoch - m_epochs[link] < m_lifetimes[link];
+    }
+
+    /**
+     * @brief Сбрасывает звено и все последующие
+     */
+    void invalidateFrom(size_t link)
+    {
+        for (size_t i = link; i < LINK_COUNT; i++)
+        {
+            m_valid[i] = false;
+        }
+    }
+
+    /**
+     * @brief Сроки жизни звеньев по умолчанию - один тик
+     */
+    static constexpr std::array<uint64_t, LINK_COUNT> defaultLifetimes()
+    {
+        std::array<uint64_t, LINK_COUNT> lifetimes{};
+        lifetimes.fill(1);
+        return lifetimes;
+    }
+
+    std::array<uintptr_t, LINK_COUNT> m_links{};                      ///< Закэшированные указатели
+    std::array<uint64_t, LINK_COUNT>  m_epochs{};                     ///< Эпоха чтения каждого звена
+    std::array<uint64_t, LINK_COUNT>  m_lifetimes{defaultLifetimes()}; ///< Срок жизни звеньев в тиках
+    std::array<bool, LINK_COUNT>      m_valid{};                      ///< Звено прочитано и не сброшено
+    Stats                             m_stats;                        ///< Счётчики
+};
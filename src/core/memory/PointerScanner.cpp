@@ -0,0 +1,467 @@
+#include "PointerScanner.hpp"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cwctype>
+#include <limits>
+#include <thread>
+#include <unordered_set>
+
+
+#pragma region Helpers
+namespace
+{
+    constexpr uint32_t NO_PARENT   = UINT32_MAX;        ///< Узел-цель
+    constexpr uint64_t ADDRESS_END = uint64_t{1} << 32; ///< Конец индексируемого адресного пространства
+    constexpr size_t   PAGE_SHIFT  = 12;                ///< Страница карты читаемости - 4 KiB
+
+    /**
+     * @brief Адрес на уровне обхода
+     */
+    struct Node
+    {
+        uint32_t address{0};        ///< Адрес (указатель или цель)
+        uint32_t parent{NO_PARENT}; ///< Узел, на который указывает этот адрес со смещением
+        uint32_t offset{0};         ///< Смещение от значения указателя до адреса parent
+    };
+
+    /**
+     * @brief Ребро обхода: указатель address со значением в пределах maxOffset от узла node
+     */
+    struct Edge
+    {
+        uint32_t address{0}; ///< Адрес указателя
+        uint32_t node{0};    ///< Индекс узла
+        uint32_t offset{0};  ///< Смещение
+    };
+
+    /**
+     * @brief Выполняет fn(begin, end, chunk) для частей диапазона [0, count) в пуле потоков
+     * @details Части нумеруются по порядку, поэтому результаты по частям детерминированы
+     */
+    template <typename Fn>
+    void parallelChunks(size_t count, size_t chunkSize, unsigned threads, Fn&& fn)
+    {
+        const size_t chunks = (count + chunkSize - 1) / chunkSize;
+        if (threads == 0)
+        {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = static_cast<unsigned>(std::min<size_t>(threads, chunks));
+
+        std::atomic<size_t> nextChunk{0};
+        auto                worker = [&]()
+        {
+            for (size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++)
+            {
+                fn(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize), chunk);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned i = 1; i < threads; i++)
+        {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+    }
+
+    /**
+     * @brief Сравнение имён модулей без учёта регистра
+     */
+    bool sameModule(const std::wstring& left, const std::wstring& right)
+    {
+        return left.size() == right.size() &&
+               std::equal(left.begin(),
+                          left.end(),
+                          right.begin(),
+                          [](wchar_t a, wchar_t b) { return std::towlower(a) == std::towlower(b); });
+    }
+
+    /**
+     * @brief Имя модуля в ASCII (имена модулей клиента не содержат других символов)
+     */
+    std::string narrow(const std::wstring& text)
+    {
+        std::string result;
+        result.reserve(text.size());
+        for (wchar_t c : text)
+        {
+            result.push_back(c < 0x80 ? static_cast<char>(c) : '?');
+        }
+        return result;
+    }
+
+    /**
+     * @brief Шестнадцатеричная запись числа: 0x2ED0
+     */
+    std::string hex(uint64_t value)
+    {
+        char buffer[24];
+        std::snprintf(buffer, sizeof(buffer), "0x%llX", static_cast<unsigned long long>(value));
+        return buffer;
+    }
+} // namespace
+#pragma endregion Helpers
+
+#pragma region PointerPath
+std::string PointerPath::toString() const
+{
+    std::string result = narrow(module) + "+" + hex(moduleOffset);
+    for (uint32_t offset : offsets)
+    {
+        result += " -> " + hex(offset);
+    }
+    return result;
+}
+
+std::string PointerPath::toDefinition() const
+{
+    std::string result = "PointerChain<" + hex(base);
+    for (uint32_t offset : offsets)
+    {
+        result += ", " + hex(offset);
+    }
+    return result + ">";
+}
+#pragma endregion PointerPath
+
+#pragma region PointerScanner
+void PointerScanner::reset()
+{
+    m_modules.clear();
+    m_bucketStart.clear();
+    m_valueLow.clear();
+    m_addresses.clear();
+    m_stats = PointerScanStats{};
+    m_error.clear();
+}
+
+bool PointerScanner::buildIndex(MemoryManager& memory, const PointerIndexOptions& options)
+{
+    reset();
+
+    const size_t alignment = options.alignment;
+    if (alignment == 0 || alignment > 4 || !std::has_single_bit(alignment))
+    {
+        m_error = "Alignment must be 1, 2 or 4";
+        return false;
+    }
+
+    const uintptr_t start = (options.start + alignment - 1) & ~(alignment - 1);
+    const uintptr_t end   = static_cast<uintptr_t>(std::min<uint64_t>(options.end, ADDRESS_END - 1));
+    if (start >= end)
+    {
+        m_error = "Empty address range";
+        return false;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    m_modules = memory.GetModules();
+    std::sort(m_modules.begin(),
+              m_modules.end(),
+              [](const ModuleInfo& a, const ModuleInfo& b) { return a.base < b.base; });
+
+    // Карта читаемых страниц 32-битного пространства (128 KiB): значение считается
+    // указателем, только если указывает в читаемую память
+    std::vector<uint64_t> readable((ADDRESS_END >> PAGE_SHIFT) / 64, 0);
+    for (const MemoryRegion& region : memory.EnumerateRegions(0, static_cast<uintptr_t>(ADDRESS_END - 1)))
+    {
+        if (!MemoryManager::IsReadableProtection(region.protection))
+        {
+            continue;
+        }
+        const uint64_t regionEnd = std::min<uint64_t>(region.end(), ADDRESS_END);
+        for (uint64_t page = region.base >> PAGE_SHIFT; page < (regionEnd + (1 << PAGE_SHIFT) - 1) >> PAGE_SHIFT; page++)
+        {
+            readable[page / 64] |= uint64_t{1} << (page % 64);
+        }
+    }
+
+    // Проход по памяти: каждый шард собирает пары (значение, адрес) в порядке адресов
+    const size_t shardSize = std::max<size_t>(0x1000, options.shardSize & ~size_t{0xFFF});
+    const auto   shards    = memory.PlanScanShards(start, end, sizeof(uint32_t) - 1, shardSize);
+    std::vector<std::vector<uint64_t>> found(shards.size());
+    std::atomic<uint64_t>              bytesRead{0};
+
+    memory.RunShardsParallel(shards,
+                             options.threads,
+                             false,
+                             [&](size_t index, uintptr_t address, const uint8_t* data, size_t size)
+                             {
+                                 bytesRead.fetch_add(size, std::memory_order_relaxed);
+                                 const size_t own   = std::min(shards[index].size, size);
+                                 const size_t first = ((address + alignment - 1) & ~(alignment - 1)) - address;
+
+                                 std::vector<uint64_t>& output = found[index];
+                                 for (size_t offset = first; offset < own && offset + sizeof(uint32_t) <= size; offset += alignment)
+                                 {
+                                     uint32_t value;
+                                     std::memcpy(&value, data + offset, sizeof(value));
+                                     const uint32_t page = value >> PAGE_SHIFT;
+                                     if (readable[page / 64] >> (page % 64) & 1)
+                                     {
+                                         output.push_back(uint64_t{value} << 32 | static_cast<uint32_t>(address + offset));
+                                     }
+                                 }
+                                 output.shrink_to_fit();
+                                 return false;
+                             });
+
+    size_t total = 0;
+    for (const auto& output : found)
+    {
+        total += output.size();
+    }
+    if (total > UINT32_MAX)
+    {
+        m_error = "Too many pointer candidates";
+        reset();
+        return false;
+    }
+
+    // Раскладка по корзинам подсчётом; внутри корзины адреса идут по возрастанию (шарды упорядочены)
+    m_bucketStart.assign(BUCKET_COUNT + 1, 0);
+    for (const auto& output : found)
+    {
+        for (uint64_t entry : output)
+        {
+            m_bucketStart[(entry >> (32 + BUCKET_BITS)) + 1]++;
+        }
+    }
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++)
+    {
+        m_bucketStart[bucket + 1] += m_bucketStart[bucket];
+    }
+
+    m_valueLow.resize(total);
+    m_addresses.resize(total);
+    std::vector<uint32_t> position(m_bucketStart.begin(), m_bucketStart.end() - 1);
+    for (auto& output : found)
+    {
+        for (uint64_t entry : output)
+        {
+            const uint32_t slot = position[entry >> (32 + BUCKET_BITS)]++;
+            m_valueLow[slot]    = static_cast<uint16_t>(entry >> 32);
+            m_addresses[slot]   = static_cast<uint32_t>(entry);
+        }
+        std::vector<uint64_t>().swap(output); // Пиковая память - сырые пары плюс индекс
+    }
+
+    // Сортировка корзин по остатку значения (устойчивая - адреса остаются по возрастанию)
+    parallelChunks(BUCKET_COUNT,
+                   256,
+                   options.threads,
+                   [this](size_t firstBucket, size_t lastBucket, size_t)
+                   {
+                       std::vector<uint64_t> keys;
+                       for (size_t bucket = firstBucket; bucket < lastBucket; bucket++)
+                       {
+                           const uint32_t begin = m_bucketStart[bucket];
+                           const uint32_t end   = m_bucketStart[bucket + 1];
+                           if (end - begin < 2 || std::is_sorted(&m_valueLow[begin], &m_valueLow[0] + end))
+                           {
+                               continue;
+                           }
+
+                           keys.resize(end - begin);
+                           for (uint32_t i = begin; i < end; i++)
+                           {
+                               keys[i - begin] = uint64_t{m_valueLow[i]} << 32 | m_addresses[i];
+                           }
+                           std::sort(keys.begin(), keys.end());
+                           for (uint32_t i = begin; i < end; i++)
+                           {
+                               m_valueLow[i]  = static_cast<uint16_t>(keys[i - begin] >> 32);
+                               m_addresses[i] = static_cast<uint32_t>(keys[i - begin]);
+                           }
+                       }
+                   });
+
+    m_stats.pointers          = total;
+    m_stats.indexBytes        = m_bucketStart.size() * sizeof(uint32_t) + total * (sizeof(uint16_t) + sizeof(uint32_t));
+    m_stats.bytesRead         = bytesRead.load();
+    m_stats.indexMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    qDebug() << "Pointer index:" << m_stats.pointers << "pointers," << m_stats.indexBytes << "bytes, read"
+             << m_stats.bytesRead << "bytes in" << m_stats.indexMilliseconds << "ms";
+    return true;
+}
+
+std::vector<PointerPath> PointerScanner::findPaths(uintptr_t target, const PointerSearchOptions& options)
+{
+    m_error.clear();
+    m_stats.nodes              = 0;
+    m_stats.paths              = 0;
+    m_stats.truncated          = false;
+    m_stats.searchMilliseconds = 0;
+
+    std::vector<PointerPath> paths;
+    if (!hasIndex())
+    {
+        m_error = "Pointer index has not been built";
+        return paths;
+    }
+    if (target >= ADDRESS_END || options.maxDepth == 0)
+    {
+        m_error = "Target is outside of the indexed address space";
+        return paths;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // Корни: образы выбранных модулей
+    std::vector<const ModuleInfo*> roots;
+    for (const ModuleInfo& module : m_modules)
+    {
+        if (options.modules.empty() ||
+            std::any_of(options.modules.begin(),
+                        options.modules.end(),
+                        [&](const std::wstring& name) { return sameModule(name, module.name); }))
+        {
+            roots.push_back(&module);
+        }
+    }
+    auto findRoot = [&roots](uint32_t address) -> const ModuleInfo*
+    {
+        auto it = std::upper_bound(roots.begin(),
+                                   roots.end(),
+                                   address,
+                                   [](uint32_t value, const ModuleInfo* module) { return value < module->base; });
+        if (it == roots.begin())
+        {
+            return nullptr;
+        }
+        --it;
+        return address - (*it)->base < (*it)->size ? *it : nullptr;
+    };
+
+    std::vector<Node>            nodes{Node{static_cast<uint32_t>(target), NO_PARENT, 0}};
+    std::unordered_set<uint32_t> visited{static_cast<uint32_t>(target)};
+
+    constexpr size_t CHUNK_SIZE = 1024;            // Узлов на одно задание потока
+    constexpr size_t BATCH_SIZE = CHUNK_SIZE * 64; // Узлов между слияниями (ограничивает память рёбер)
+    size_t           levelBegin = 0;
+    for (size_t depth = 1; depth <= options.maxDepth && levelBegin < nodes.size(); depth++)
+    {
+        const size_t levelEnd  = nodes.size();
+        const bool   lastLevel = depth == options.maxDepth;
+
+        for (size_t batchBegin = levelBegin; batchBegin < levelEnd; batchBegin += BATCH_SIZE)
+        {
+            const size_t batchEnd = std::min(levelEnd, batchBegin + BATCH_SIZE);
+
+            // Поиск рёбер - параллельно по частям узлов; на последнем уровне нужны только корни
+            std::vector<std::vector<Edge>> edges((batchEnd - batchBegin + CHUNK_SIZE - 1) / CHUNK_SIZE);
+            parallelChunks(batchEnd - batchBegin,
+                           CHUNK_SIZE,
+                           options.threads,
+                           [&](size_t first, size_t last, size_t chunk)
+                           {
+                               for (size_t i = batchBegin + first; i < batchBegin + last; i++)
+                               {
+                                   const uint32_t address = nodes[i].address;
+                                   const uint32_t low = address > options.maxOffset ? address - options.maxOffset : 0;
+                                   forEachPointer(low,
+                                                  address,
+                                                  [&](uint32_t value, uint32_t pointer)
+                                                  {
+                                                      if (!lastLevel || findRoot(pointer))
+                                                      {
+                                                          edges[chunk].push_back(
+                                                              Edge{pointer, static_cast<uint32_t>(i), address - value});
+                                                      }
+                                                  });
+                               }
+                           });
+
+            // Слияние по порядку частей: корни дают цепочки, остальные адреса - следующий уровень
+            for (const auto& chunk : edges)
+            {
+                for (const Edge& edge : chunk)
+                {
+                    if (const ModuleInfo* root = findRoot(edge.address))
+                    {
+                        if (paths.size() >= options.maxResults)
+                        {
+                            m_stats.truncated = true;
+                            continue;
+                        }
+
+                        PointerPath path;
+                        path.module       = root->name;
+                        path.base         = edge.address;
+                        path.moduleOffset = edge.address - root->base;
+                        path.offsets.push_back(edge.offset);
+                        for (uint32_t node = edge.node; nodes[node].parent != NO_PARENT; node = nodes[node].parent)
+                        {
+                            path.offsets.push_back(nodes[node].offset);
+                        }
+                        paths.push_back(std::move(path));
+                        continue;
+                    }
+
+                    if (lastLevel || !visited.insert(edge.address).second)
+                    {
+                        continue;
+                    }
+                    if (nodes.size() - levelEnd >= options.maxNodesPerLevel)
+                    {
+                        m_stats.truncated = true;
+                        continue;
+                    }
+                    nodes.push_back(Node{edge.address, edge.node, edge.offset});
+                }
+            }
+        }
+
+        levelBegin = levelEnd;
+    }
+
+    std::stable_sort(paths.begin(),
+                     paths.end(),
+                     [](const PointerPath& a, const PointerPath& b)
+                     {
+                         if (a.offsets.size() != b.offsets.size())
+                         {
+                             return a.offsets.size() < b.offsets.size();
+                         }
+                         return a.base < b.base;
+                     });
+
+    m_stats.nodes              = nodes.size();
+    m_stats.paths              = paths.size();
+    m_stats.searchMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    qDebug() << "Pointer search:" << m_stats.paths << "paths," << m_stats.nodes << "addresses visited in"
+             << m_stats.searchMilliseconds << "ms" << (m_stats.truncated ? "(truncated)" : "");
+    return paths;
+}
+
+bool PointerScanner::resolve(MemoryManager& memory, const PointerPath& path, uintptr_t& address)
+{
+    uintptr_t current = path.base;
+    for (uint32_t offset : path.offsets)
+    {
+        const auto value = memory.TryRead<uint32_t>(current);
+        if (!value)
+        {
+            return false;
+        }
+        current = static_cast<uintptr_t>(*value) + offset;
+    }
+    address = current;
+    return true;
+}
+#pragma endregion PointerScanner
@@ -0,0 +1,190 @@
+/**
+ * @file PointerScanner.hpp
+ * @brief Поиск статических цепочек указателей до динамического адреса
+ * @details Пример (адрес структуры игрока найден ValueScanner или хуком):
+ * @code
+ * PointerScanner scanner;
+ * scanner.buildIndex(memory, {});
+ * for (const PointerPath& path : scanner.findPaths(playerAddress, {.maxDepth = 4, .modules = {L"run.exe"}}))
+ * {
+ *     qDebug() << path.toDefinition().c_str(); // PointerChain<0xC79CE0, 0x2ED0, 0xAC>
+ * }
+ * @endcode
+ */
+#pragma once
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MemoryManager.hpp"
+
+
+/**
+ * @brief Параметры построения индекса указателей
+ */
+struct PointerIndexOptions
+{
+    uintptr_t start{0};            ///< Начало сканируемого диапазона
+    uintptr_t end{UINTPTR_MAX};    ///< Конец диапазона (не включительно, не выше 4 GiB)
+    size_t    alignment{4};        ///< Шаг адресов указателей: 1, 2 или 4
+    unsigned  threads{0};          ///< Количество потоков (0 - по числу ядер)
+    size_t    shardSize{0x400000}; ///< Размер задания одного потока
+};
+
+/**
+ * @brief Параметры поиска цепочек
+ */
+struct PointerSearchOptions
+{
+    size_t                    maxDepth{5};               ///< Максимальное количество разыменований в цепочке
+    uint32_t                  maxOffset{0x1000};         ///< Максимальное смещение на каждом уровне
+    std::vector<std::wstring> modules;                   ///< Модули-корни (пусто - любой модуль)
+    size_t                    maxResults{10000};         ///< Максимальное количество цепочек
+    size_t                    maxNodesPerLevel{1 << 20}; ///< Ограничение ширины уровня обхода
+    unsigned                  threads{0};                ///< Количество потоков (0 - по числу ядер)
+};
+
+/**
+ * @brief Найденная цепочка [[[module + moduleOffset] + offsets[0]] + ...] + offsets[n-1]
+ */
+struct PointerPath
+{
+    std::wstring          module;          ///< Модуль, в образе которого лежит корневой указатель
+    uintptr_t             moduleOffset{0}; ///< Смещение корневого указателя от базы модуля
+    uintptr_t             base{0};         ///< Абсолютный адрес корневого указателя
+    std::vector<uint32_t> offsets;         ///< Смещения уровней от корня к цели
+
+    /**
+     * @brief Запись вида "run.exe+0x879CE0 -> 0x2ED0 -> 0xAC"
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Определение для вставки в код: "PointerChain<0xC79CE0, 0x2ED0, 0xAC>"
+     * @details Base - абсолютный адрес, поэтому определение верно для модулей без релокации (run.exe)
+     */
+    std::string toDefinition() const;
+};
+
+/**
+ * @brief Статистика PointerScanner
+ */
+struct PointerScanStats
+{
+    size_t   pointers{0};           ///< Указатели в индексе
+    size_t   indexBytes{0};         ///< Память индекса
+    uint64_t bytesRead{0};          ///< Прочитано байт при построении индекса
+    double   indexMilliseconds{0};  ///< Длительность построения индекса
+    size_t   nodes{0};              ///< Адреса, пройденные последним поиском
+    size_t   paths{0};              ///< Цепочки, найденные последним поиском
+    bool     truncated{false};      ///< Последний поиск упёрся в maxResults или maxNodesPerLevel
+    double   searchMilliseconds{0}; ///< Длительность последнего поиска
+};
+
+/**
+ * @class PointerScanner
+ * @brief Обратный индекс указателей и обход от цели к статическим корням
+ * @details buildIndex() за один проход читаемой памяти (шарды MemoryManager::RunShardsParallel)
+ * собирает все выровненные 32-битные значения, указывающие в читаемую память, и строит
+ * обратный индекс "значение -> адреса, где оно лежит". Индекс - отсортированные массивы,
+ * разбитые на корзины по старшим 16 битам значения: на указатель хранится 16-битный остаток
+ * значения и 32-битный адрес (6 байт), поиск в корзине - двоичный.
+ * findPaths() обходит граф в ширину от цели: на каждом уровне для каждого адреса A ищутся
+ * указатели со значениями [A - maxOffset, A]. Указатель внутри образа модуля даёт цепочку,
+ * остальные становятся адресами следующего уровня. Каждый адрес проходится один раз (по
+ * кратчайшему пути), уровни обрабатываются параллельно. Индекс рассчитан на 32-битный клиент:
+ * адреса и значения выше 4 GiB не индексируются.
+ */
+class PointerScanner
+{
+  public:
+    /**
+     * @brief Строит индекс указателей
+     * @param memory Менеджер памяти процесса
+     * @param options Диапазон, шаг и потоки
+     * @return false при неверных параметрах (см. error())
+     */
+    bool buildIndex(MemoryManager& memory, const PointerIndexOptions& options);
+
+    /**
+     * @brief Ищет цепочки от статических корней до адреса
+     * @param target Искомый адрес
+     * @param options Глубина, смещения, корни и ограничения
+     * @return Цепочки по возрастанию длины, затем корня
+     */
+    std::vector<PointerPath> findPaths(uintptr_t target, const PointerSearchOptions& options);
+
+    /**
+     * @brief Разрешает цепочку в текущем состоянии процесса (проверка после перезапуска клиента)
+     * @param memory Менеджер памяти процесса
+     * @param path Цепочка
+     * @param address Итоговый адрес
+     * @return false если одно из звеньев не прочитано
+     */
+    static bool resolve(MemoryManager& memory, const PointerPath& path, uintptr_t& address);
+
+    /**
+     * @brief Перебирает адреса, хранящие значения из диапазона [low, high]
+     * @param onPointer void(uint32_t value, uint32_t address), значения по возрастанию
+     */
+    template <typename OnPointer>
+    void forEachPointer(uint32_t low, uint32_t high, OnPointer&& onPointer) const;
+
+    /**
+     * @brief Построен ли индекс
+     */
+    bool hasIndex() const { return !m_bucketStart.empty(); }
+
+    /**
+     * @brief Сбрасывает индекс
+     */
+    void reset();
+
+    /**
+     * @brief Статистика
+     */
+    const PointerScanStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Описание ошибки последнего вызова
+     */
+    const std::string& error() const { return m_error; }
+
+  private:
+    static constexpr size_t BUCKET_BITS  = 16;                       ///< Биты значения, задающие корзину
+    static constexpr size_t BUCKET_COUNT = size_t{1} << BUCKET_BITS; ///< Количество корзин
+
+    std::vector<ModuleInfo> m_modules;     ///< Модули процесса по возрастанию базы
+    std::vector<uint32_t>   m_bucketStart; ///< Начала корзин в m_valueLow/m_addresses (BUCKET_COUNT + 1)
+    std::vector<uint16_t>   m_valueLow;    ///< Младшие 16 бит значений, по возрастанию внутри корзины
+    std::vector<uint32_t>   m_addresses;   ///< Адреса указателей (параллельно m_valueLow)
+    PointerScanStats        m_stats;       ///< Статистика
+    std::string             m_error;       ///< Ошибка последнего вызова
+};
+
+template <typename OnPointer>
+void PointerScanner::forEachPointer(uint32_t low, uint32_t high, OnPointer&& onPointer) const
+{
+    if (!hasIndex() || low > high)
+    {
+        return;
+    }
+
+    const uint32_t firstBucket = low >> BUCKET_BITS;
+    const uint32_t lastBucket  = high >> BUCKET_BITS;
+    for (uint32_t bucket = firstBucket; bucket <= lastBucket; bucket++)
+    {
+        const uint16_t lowBound  = bucket == firstBucket ? static_cast<uint16_t>(low) : 0;
+        const uint16_t highBound = bucket == lastBucket ? static_cast<uint16_t>(high) : UINT16_MAX;
+
+        const uint16_t* begin = m_valueLow.data() + m_bucketStart[bucket];
+        const uint16_t* end   = m_valueLow.data() + m_bucketStart[bucket + 1];
+        for (const uint16_t* it = std::lower_bound(begin, end, lowBound); it != end && *it <= highBound; ++it)
+        {
+            onPointer((bucket << BUCKET_BITS) | *it, m_addresses[it - m_valueLow.data()]);
+        }
+    }
+}
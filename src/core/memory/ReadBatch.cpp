@@ -0,0 +1,71 @@
+#include "ReadBatch.hpp"
+
+#include <algorithm>
+
+
+ReadBatchPlanner::ReadBatchPlanner(size_t gapThreshold, size_t maxReadSize)
+    : m_gapThreshold(gapThreshold), m_maxReadSize(maxReadSize)
+{
+}
+
+const std::vector<CoalescedRead>& ReadBatchPlanner::plan(std::span<const ReadRequest> requests, BatchReadStats& stats)
+{
+    stats = BatchReadStats{};
+    stats.requests = requests.size();
+
+    m_order.clear();
+    m_reads.clear();
+
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        // Пустые запросы не требуют чтения
+        if (requests[i].size == 0)
+        {
+            continue;
+        }
+        m_order.push_back(i);
+        stats.bytesRequested += requests[i].size;
+    }
+
+    // Постоянные наборы запросов (WatchList, таблицы объектов) обычно уже упорядочены
+    const auto byAddress = [&requests](size_t a, size_t b) { return requests[a].address < requests[b].address; };
+    if (!std::is_sorted(m_order.begin(), m_order.end(), byAddress))
+    {
+        std::sort(m_order.begin(), m_order.end(), byAddress);
+    }
+
+    for (size_t i = 0; i < m_order.size(); i++)
+    {
+        const ReadRequest& request = requests[m_order[i]];
+        const uintptr_t    end     = request.address + request.size;
+
+        if (!m_reads.empty())
+        {
+            CoalescedRead&  current    = m_reads.back();
+            const uintptr_t currentEnd = current.address + current.size;
+            const uintptr_t mergedEnd  = std::max(currentEnd, end);
+
+            const bool closeEnough = request.address <= currentEnd || request.address - currentEnd <= m_gapThreshold;
+            if (closeEnough && mergedEnd - current.address <= m_maxReadSize)
+            {
+                if (request.address > currentEnd)
+                {
+                    stats.bytesOverRead += request.address - currentEnd;
+                }
+                current.size = mergedEnd - current.address;
+                current.last = i;
+                continue;
+            }
+        }
+
+        m_reads.push_back(CoalescedRead{request.address, request.size, i, i});
+    }
+
+    stats.mergedReads = m_reads.size();
+    for (const auto& read : m_reads)
+    {
+        stats.bytesRead += read.size;
+    }
+
+    return m_reads;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file ReadBatch.hpp
+ * @brief Пакетное (scatter/gather) чтение памяти с объединением соседних диапазонов
+ * @details Планировщик не зависит от WinAPI: он только сортирует запросы и объединяет их
+ * в минимальное количество сплошных чтений. Само чтение выполняет MemoryManager::ReadBatch.
+ */
+#pragma once
+#include <span>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * @brief Один запрос пакетного чтения
+ */
+struct ReadRequest
+{
+    uintptr_t address{0};           ///< Адрес в целевом процессе
+    size_t    size{0};              ///< Количество байт
+    void*     destination{nullptr}; ///< Буфер вызывающего кода
+    bool      succeeded{false};     ///< Заполняется после чтения: true если байты получены
+};
+
+/**
+ * @brief Статистика одного пакета чтений
+ * @details Используется для подбора порога объединения (gap threshold)
+ */
+struct BatchReadStats
+{
+    size_t requests{0};       ///< Количество запросов в пакете
+    size_t mergedReads{0};    ///< Количество фактических чтений после объединения
+    size_t failedRequests{0}; ///< Запросы, которые не удалось прочитать
+    size_t bytesRequested{0}; ///< Сумма размеров запросов
+    size_t bytesRead{0};      ///< Сумма размеров фактических чтений
+    size_t bytesOverRead{0};  ///< Байты промежутков, прочитанные "лишними" при объединении
+};
+
+/**
+ * @brief Сплошное чтение, покрывающее один или несколько запросов
+ */
+struct CoalescedRead
+{
+    uintptr_t address{0}; ///< Начало чтения
+    size_t    size{0};    ///< Размер чтения
+    size_t    first{0};   ///< Индекс первого запроса в ReadBatchPlanner::order()
+    size_t    last{0};    ///< Индекс последнего запроса в ReadBatchPlanner::order() (включительно)
+};
+
+/**
+ * @class ReadBatchPlanner
+ * @brief Сортирует запросы и объединяет пересекающиеся и близкие диапазоны
+ * @details Два диапазона объединяются, если промежуток между ними не больше gapThreshold
+ * и итоговое чтение не превышает maxReadSize. Внутренние буферы переиспользуются между пакетами,
+ * поэтому в установившемся режиме планирование не выделяет память.
+ */
+class ReadBatchPlanner
+{
+  public:
+    /**
+     * @brief Конструктор
+     * @param gapThreshold Максимальный промежуток в байтах, который допускается прочитать "лишним"
+     * @param maxReadSize Максимальный размер одного объединённого чтения
+     */
+    explicit ReadBatchPlanner(size_t gapThreshold = 64, size_t maxReadSize = 0x10000);
+
+    /**
+     * @brief Строит план чтений
+     * @param requests Запросы (порядок не меняется)
+     * @param stats Статистика пакета, заполняется планировщиком (кроме failedRequests)
+     * @return Список объединённых чтений, отсортированный по адресу
+     */
+    const std::vector<CoalescedRead>& plan(std::span<const ReadRequest> requests, BatchReadStats& stats);
+
+    /**
+     * @brief Индексы запросов, отсортированные по адресу
+     */
+    const std::vector<size_t>& order() const { return m_order; }
+
+    /**
+     * @brief Порог объединения соседних диапазонов (в байтах)
+     */
+    void   setGapThreshold(size_t gap) { m_gapThreshold = gap; }
+    size_t gapThreshold() const { return m_gapThreshold; }
+
+    /**
+     * @brief Максимальный размер одного объединённого чтения
+     */
+    void   setMaxReadSize(size_t size) { m_maxReadSize = size; }
+    size_t maxReadSize() const { return m_maxReadSize; }
+
+    /**
+     * @brief Временный буфер для объединённых чтений
+     */
+    std::vector<uint8_t>& scratch() { return m_scratch; }
+
+  private:
+    size_t                     m_gapThreshold; ///< Порог объединения
+    size_t                     m_maxReadSize;  ///< Ограничение размера одного чтения
+    std::vector<size_t>        m_order;        ///< Отсортированные индексы запросов
+    std::vector<CoalescedRead> m_reads;        ///< Результат планирования
+    std::vector<uint8_t>       m_scratch;      ///< Буфер для объединённых чтений
+};
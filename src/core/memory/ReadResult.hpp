@@ -0,0 +1,152 @@
+/**
+ * @file ReadResult.hpp
+ * @brief Результат чтения без исключений для горячих циклов
+ */
+#pragma once
+#include <array>
+#include <atomic>
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * @brief Причина неудачного чтения
+ */
+enum class ReadError : uint8_t
+{
+    None,           ///< Ошибки нет
+    NullAddress,    ///< Адрес в нулевой области (< 0x10000), чтение не выполнялось
+    InvalidAddress, ///< Страница не отображена или недоступна (в том числе по негативному кэшу)
+    AccessDenied,   ///< Нет прав на чтение памяти процесса
+    Failed,         ///< Прочие ошибки ReadProcessMemory
+    Count           ///< Количество значений (служебное)
+};
+
+/**
+ * @brief Значение или код ошибки чтения (аналог std::expected<T, ReadError>)
+ * @tparam T Тип прочитанного значения
+ * @details Хранит значение по месту, без выделения памяти. При ошибке value() содержит T{}.
+ */
+template <typename T>
+class ReadResult
+{
+  public:
+    ReadResult(const T& value) : m_value(value) {}
+    ReadResult(ReadError error) : m_error(error) {}
+
+    /**
+     * @brief true если чтение успешно
+     */
+    bool hasValue() const { return m_error == ReadError::None; }
+    explicit operator bool() const { return hasValue(); }
+
+    /**
+     * @brief Прочитанное значение
+     */
+    const T& value() const { return m_value; }
+    const T& operator*() const { return m_value; }
+    const T* operator->() const { return &m_value; }
+
+    /**
+     * @brief Значение или запасное значение при ошибке
+     */
+    T valueOr(const T& fallback) const { return hasValue() ? m_value : fallback; }
+
+    /**
+     * @brief Код ошибки (ReadError::None при успехе)
+     */
+    ReadError error() const { return m_error; }
+
+  private:
+    T         m_value{};                ///< Значение
+    ReadError m_error{ReadError::None}; ///< Код ошибки
+};
+
+/**
+ * @brief Снимок счётчиков неудачных чтений по причинам
+ */
+struct ReadFailureStats
+{
+    std::array<uint64_t, static_cast<size_t>(ReadError::Count)> byError{}; ///< Количество ошибок по ReadError
+
+    /**
+     * @brief Количество ошибок заданного типа
+     */
+    uint64_t count(ReadError error) const { return byError[static_cast<size_t>(error)]; }
+
+    /**
+     * @brief Общее количество ошибок
+     */
+    uint64_t total() const
+    {
+        uint64_t sum = 0;
+        for (uint64_t value : byError)
+        {
+            sum += value;
+        }
+        return sum;
+    }
+};
+
+/**
+ * @class ReadFailureCounters
+ * @brief Атомарные счётчики неудачных чтений
+ * @details Обновляются с relaxed-порядком только на пути ошибки, поэтому
+ * не влияют на стоимость успешного чтения. Копирование переносит текущие значения,
+ * чтобы владелец (MemoryManager) оставался перемещаемым.
+ */
+class ReadFailureCounters
+{
+  public:
+    ReadFailureCounters() = default;
+    ReadFailureCounters(const ReadFailureCounters& other) { assign(other); }
+    ReadFailureCounters& operator=(const ReadFailureCounters& other)
+    {
+        if (this != &other)
+        {
+            assign(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Учитывает ошибку
+     */
+    void add(ReadError error) { m_counters[static_cast<size_t>(error)].fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Снимок счётчиков
+     */
+    ReadFailureStats snapshot() const
+    {
+        ReadFailureStats stats;
+        for (size_t i = 0; i < m_counters.size(); i++)
+        {
+            stats.byError[i] = m_counters[i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    /**
+     * @brief Обнуляет счётчики
+     */
+    void reset()
+    {
+        for (auto& counter : m_counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+
+  private:
+    void assign(const ReadFailureCounters& other)
+    {
+        for (size_t i = 0; i < m_counters.size(); i++)
+        {
+            m_counters[i].store(other.m_counters[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(ReadError::Count)> m_counters{}; ///< Счётчики по ReadError
+};
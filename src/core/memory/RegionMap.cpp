@@ -0,0 +1,71 @@
+#include "RegionMap.hpp"
+
+
+bool RegionMap::isKnownUnreadable(uintptr_t address, uint64_t epoch)
+{
+    if (m_negativePages.empty())
+    {
+        return false;
+    }
+
+    auto it = m_negativePages.find(address & ~(PAGE_SIZE - 1));
+    if (it == m_negativePages.end())
+    {
+        return false;
+    }
+
+    if (!isFresh(it->second, epoch, m_policy.negativeMaxAgeTicks))
+    {
+        m_negativePages.erase(it);
+        return false;
+    }
+
+    m_stats.negativeHits++;
+    return true;
+}
+
+void RegionMap::markUnreadable(uintptr_t address, uint64_t epoch)
+{
+    if (m_negativePages.size() >= m_policy.maxNegativePages)
+    {
+        m_negativePages.clear();
+    }
+    m_negativePages[address & ~(PAGE_SIZE - 1)] = epoch;
+}
+
+void RegionMap::invalidate(uintptr_t address, size_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    m_stats.invalidations++;
+
+    const uintptr_t end = (address + size < address) ? UINTPTR_MAX : address + size;
+
+    auto first = m_regions.lower_bound(address);
+    if (first != m_regions.begin() && std::prev(first)->second.region.end() > address)
+    {
+        --first;
+    }
+    m_regions.erase(first, m_regions.lower_bound(end));
+
+    for (auto it = m_negativePages.begin(); it != m_negativePages.end();)
+    {
+        if (it->first + PAGE_SIZE > address && it->first < end)
+        {
+            it = m_negativePages.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void RegionMap::clear()
+{
+    m_stats.invalidations++;
+    m_regions.clear();
+    m_negativePages.clear();
+}
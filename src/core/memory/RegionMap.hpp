@@ -0,0 +1,201 @@
+/**
+ * @file RegionMap.hpp
+ * @brief Кэш карты регионов памяти целевого процесса
+ * @details Как и PageCache, не зависит от WinAPI: запрос региона (VirtualQueryEx)
+ * передаётся в find() как функтор.
+ */
+#pragma once
+#include <iterator>
+#include <map>
+#include <unordered_map>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MemoryRegion.hpp"
+
+
+/**
+ * @class RegionMap
+ * @brief Упорядоченная карта регионов с ленивым заполнением и негативным кэшем
+ * @details Регионы хранятся в std::map по базовому адресу, поиск региона по адресу - O(log n).
+ * Карта заполняется по мере запросов и сбрасывается при выделении, освобождении
+ * памяти и смене прав доступа. Кэшируются только выделенные (MEM_COMMIT) регионы:
+ * свободные и зарезервированные целевой процесс может выделить в любой момент. Отдельно хранятся страницы, запрос или чтение которых
+ * завершились ошибкой: повторное обращение к ним отклоняется без системного вызова.
+ * Записи стареют по тикам. Без тиков (ticking = false) эпоха стоит на месте: регионы хранятся до явного
+ * сброса (выделение, освобождение, смена прав, InvalidateRegionMap), а негативные записи не ведутся.
+ * Так установка хуков до первого тика и менеджеры, которые вообще не тикают, тоже получают попадания.
+ */
+class RegionMap
+{
+  public:
+    static constexpr size_t   PAGE_SIZE    = 0x1000; ///< Размер страницы (4 KiB)
+    static constexpr uint32_t STATE_COMMIT = 0x1000; ///< MEM_COMMIT
+
+    /**
+     * @brief Политика устаревания записей
+     * @details Возраст измеряется в тиках (MemoryManager::BeginTick)
+     */
+    struct Policy
+    {
+        uint64_t maxAgeTicks{50};        ///< Срок жизни региона (0 - до явного сброса)
+        uint64_t negativeMaxAgeTicks{1}; ///< Срок жизни негативной записи (0 - до явного сброса)
+        size_t   maxNegativePages{4096}; ///< Лимит негативных записей
+    };
+
+    /**
+     * @brief Счётчики работы карты
+     */
+    struct Stats
+    {
+        uint64_t hits{0};          ///< Запросы, обслуженные из карты
+        uint64_t misses{0};        ///< Запросы, потребовавшие системного вызова
+        uint64_t negativeHits{0};  ///< Обращения, отклонённые негативным кэшем
+        uint64_t invalidations{0}; ///< Сбросы диапазонов и полные очистки
+
+        /**
+         * @brief Доля запросов, обслуженных без системного вызова
+         */
+        double hitRate() const
+        {
+            const uint64_t total = hits + misses + negativeHits;
+            return total ? static_cast<double>(hits + negativeHits) / static_cast<double>(total) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Находит регион, содержащий адрес
+     * @tparam Query Функтор вида bool(uintptr_t address, MemoryRegion& region)
+     * @param address Адрес
+     * @param epoch Текущий тик
+     * @param ticking false - тики не идут: регион запоминается до явного сброса, неудачный запрос не запоминается
+     * @param query Системный запрос региона
+     * @return Регион (в том числе свободный или зарезервированный) или nullptr, если запрос невозможен
+     */
+    template <typename Query>
+    const MemoryRegion* find(uintptr_t address, uint64_t epoch, bool ticking, Query&& query);
+
+    /**
+     * @brief Проверяет, известно ли, что страница адреса недоступна
+     */
+    bool isKnownUnreadable(uintptr_t address, uint64_t epoch);
+
+    /**
+     * @brief Запоминает, что страница адреса недоступна
+     */
+    void markUnreadable(uintptr_t address, uint64_t epoch);
+
+    /**
+     * @brief Сбрасывает регионы и негативные записи, пересекающиеся с диапазоном
+     */
+    void invalidate(uintptr_t address, size_t size);
+
+    /**
+     * @brief Полностью очищает карту
+     */
+    void clear();
+
+    /**
+     * @brief Устанавливает политику устаревания записей
+     */
+    void setPolicy(const Policy& policy) { m_policy = policy; }
+
+    /**
+     * @brief Текущая политика устаревания записей
+     */
+    const Policy& policy() const { return m_policy; }
+
+    /**
+     * @brief Количество регионов в карте
+     */
+    size_t regionCount() const { return m_regions.size(); }
+
+    /**
+     * @brief Получает счётчики карты
+     */
+    const Stats& stats() const { return m_stats; }
+
+    /**
+     * @brief Сбрасывает счётчики карты
+     */
+    void resetStats() { m_stats = Stats{}; }
+
+  private:
+    /**
+     * @brief Регион и тик, в который он был получен
+     */
+    struct Entry
+    {
+        MemoryRegion region; ///< Регион
+        uint64_t     epoch;  ///< Тик запроса
+    };
+
+    /**
+     * @brief Проверяет, не устарела ли запись
+     */
+    static bool isFresh(uint64_t entryEpoch, uint64_t epoch, uint64_t maxAge)
+    {
+        return maxAge == 0 || (epoch >= entryEpoch && epoch - entryEpoch < maxAge);
+    }
+
+    std::map<uintptr_t, Entry>              m_regions;       ///< Регионы по базовому адресу
+    std::unordered_map<uintptr_t, uint64_t> m_negativePages; ///< Недоступные страницы -> тик обнаружения
+    MemoryRegion                            m_uncached;      ///< Последний некэшируемый регион
+    Policy                                  m_policy;        ///< Политика устаревания
+    Stats                                   m_stats;         ///< Счётчики
+};
+
+template <typename Query>
+const MemoryRegion* RegionMap::find(uintptr_t address, uint64_t epoch, bool ticking, Query&& query)
+{
+    if (isKnownUnreadable(address, epoch))
+    {
+        return nullptr;
+    }
+
+    // Последний регион с base <= address
+    auto it = m_regions.upper_bound(address);
+    if (it != m_regions.begin())
+    {
+        --it;
+        if (it->second.region.contains(address))
+        {
+            if (isFresh(it->second.epoch, epoch, m_policy.maxAgeTicks))
+            {
+                m_stats.hits++;
+                return &it->second.region;
+            }
+            m_regions.erase(it);
+        }
+    }
+
+    m_stats.misses++;
+    MemoryRegion region;
+    if (!query(address, region) || !region.contains(address))
+    {
+        // Без тиков негативная запись не устарела бы никогда, а страницу могут выделить в любой момент
+        if (ticking)
+        {
+            markUnreadable(address, epoch);
+        }
+        return nullptr;
+    }
+
+    if (region.state != STATE_COMMIT)
+    {
+        m_uncached = region;
+        return &m_uncached;
+    }
+
+    // Убираем устаревшие записи, которые пересекаются с новым регионом
+    auto first = m_regions.lower_bound(region.base);
+    if (first != m_regions.begin() && std::prev(first)->second.region.end() > region.base)
+    {
+        --first;
+    }
+    auto last = m_regions.lower_bound(region.end());
+    m_regions.erase(first, last);
+
+    return &m_regions.emplace(region.base, Entry{region, epoch}).first->second.region;
+}
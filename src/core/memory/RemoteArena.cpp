@@ -0,0 +1,196 @@
+#include "RemoteArena.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "MemoryManager.hpp"
+
+
+namespace
+{
+    constexpr size_t PAGE_SIZE = 0x1000; ///< Гранулярность размера крупных выделений
+
+    /**
+     * @brief Индекс класса размера куска (16 -> 0, 32 -> 1, ...)
+     */
+    size_t classIndex(size_t chunk)
+    {
+        return std::countr_zero(chunk) - std::countr_zero(RemoteArena::MIN_CHUNK);
+    }
+} // namespace
+
+
+uintptr_t RemoteArena::allocate(MemoryManager& memory, ArenaPool pool, size_t size, size_t alignment)
+{
+    if (size == 0 || !std::has_single_bit(alignment) || alignment > MAX_ALIGN)
+    {
+        m_error = "Invalid allocation size or alignment";
+        return 0;
+    }
+
+    Pool& state = m_pools[static_cast<size_t>(pool)];
+    state.stats.allocations++;
+
+    Allocation allocation{pool, 0, 0, size};
+    uintptr_t  address = 0;
+
+    const size_t chunk = std::bit_ceil(std::max({size, alignment, MIN_CHUNK}));
+    if (chunk > MAX_CHUNK)
+    {
+        // Крупный запрос получает собственное выделение, выровненное по странице
+        allocation.sizeClass = LARGE;
+        allocation.size      = (size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+
+        address = reinterpret_cast<uintptr_t>(memory.AllocateMemory(nullptr, allocation.size, protection(pool)));
+        if (address == 0)
+        {
+            m_error = "Failed to allocate memory in the target process";
+            return 0;
+        }
+        state.large.push_back(address);
+        state.stats.blocks++;
+        state.stats.reservedBytes += allocation.size;
+        state.stats.systemAllocations++;
+    }
+    else
+    {
+        allocation.sizeClass = static_cast<uint8_t>(classIndex(chunk));
+        allocation.size      = chunk;
+
+        auto& freeList = state.freeLists[allocation.sizeClass];
+        if (!freeList.empty())
+        {
+            address = freeList.back();
+            freeList.pop_back();
+        }
+        else if ((address = carve(memory, pool, chunk)) == 0)
+        {
+            return 0;
+        }
+    }
+
+    state.stats.usedBytes += allocation.size;
+    state.stats.requestedBytes += allocation.requested;
+    state.stats.liveAllocations++;
+    m_allocations.emplace(address, allocation);
+    return address;
+}
+
+bool RemoteArena::free(MemoryManager& memory, uintptr_t address)
+{
+    auto it = m_allocations.find(address);
+    if (it == m_allocations.end())
+    {
+        m_error = "Address is not allocated by the arena";
+        return false;
+    }
+
+    const Allocation allocation = it->second;
+    m_allocations.erase(it);
+
+    Pool& state = m_pools[static_cast<size_t>(allocation.pool)];
+    state.stats.frees++;
+    state.stats.usedBytes -= allocation.size;
+    state.stats.requestedBytes -= allocation.requested;
+    state.stats.liveAllocations--;
+
+    if (allocation.sizeClass != LARGE)
+    {
+        state.freeLists[allocation.sizeClass].push_back(address);
+        return true;
+    }
+
+    std::erase(state.large, address);
+    state.stats.blocks--;
+    state.stats.reservedBytes -= allocation.size;
+    if (!memory.FreeMemory(reinterpret_cast<void*>(address)))
+    {
+        m_error = "Failed to free memory in the target process";
+        return false;
+    }
+    return true;
+}
+
+bool RemoteArena::release(MemoryManager& memory)
+{
+    bool result = true;
+    for (Pool& state : m_pools)
+    {
+        for (const Block& block : state.blocks)
+        {
+            result &= memory.FreeMemory(reinterpret_cast<void*>(block.address));
+        }
+        for (uintptr_t address : state.large)
+        {
+            result &= memory.FreeMemory(reinterpret_cast<void*>(address));
+        }
+
+        // Накопительные счётчики сохраняются, текущее состояние обнуляется
+        state.blocks.clear();
+        state.large.clear();
+        for (auto& freeList : state.freeLists)
+        {
+            freeList.clear();
+        }
+        state.stats.blocks          = 0;
+        state.stats.reservedBytes   = 0;
+        state.stats.usedBytes       = 0;
+        state.stats.requestedBytes  = 0;
+        state.stats.liveAllocations = 0;
+    }
+    m_allocations.clear();
+
+    if (!result)
+    {
+        m_error = "Failed to free memory in the target process";
+    }
+    return result;
+}
+
+uintptr_t RemoteArena::carve(MemoryManager& memory, ArenaPool pool, size_t chunk)
+{
+    Pool& state = m_pools[static_cast<size_t>(pool)];
+
+    // Нарезанная часть блока всегда кратна MIN_CHUNK. Промежутки до выравнивания куска и остаток
+    // блока раздаются в списки свободных меньших классов, поэтому место в блоке не теряется.
+    auto spill = [&state](Block& block, size_t limit)
+    {
+        while (block.used < limit)
+        {
+            size_t size = std::min<size_t>(MAX_CHUNK, size_t{1} << std::countr_zero(block.used | BLOCK_SIZE));
+            while (size > limit - block.used)
+            {
+                size >>= 1;
+            }
+            state.freeLists[classIndex(size)].push_back(block.address + block.used);
+            block.used += size;
+        }
+    };
+
+    if (!state.blocks.empty())
+    {
+        Block&       block  = state.blocks.back();
+        const size_t offset = (block.used + chunk - 1) & ~(chunk - 1);
+        if (offset + chunk <= BLOCK_SIZE)
+        {
+            spill(block, offset);
+            block.used = offset + chunk;
+            return block.address + offset;
+        }
+        spill(block, BLOCK_SIZE);
+    }
+
+    const uintptr_t address =
+        reinterpret_cast<uintptr_t>(memory.AllocateMemory(nullptr, BLOCK_SIZE, protection(pool)));
+    if (address == 0)
+    {
+        m_error = "Failed to allocate memory in the target process";
+        return 0;
+    }
+
+    state.blocks.push_back(Block{address, chunk});
+    state.stats.blocks++;
+    state.stats.reservedBytes += BLOCK_SIZE;
+    state.stats.systemAllocations++;
+    return address;
+}
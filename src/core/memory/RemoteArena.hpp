@@ -0,0 +1,172 @@
+/**
+ * @file RemoteArena.hpp
+ * @brief Арена памяти в целевом процессе: блоки по 64 KiB, нарезаемые на куски по классам размеров
+ * @details Пример (трамплин и буфер данных для кода внедрения):
+ * @code
+ * uintptr_t code = memory.AllocateCode(32);   // RX, выравнивание 16
+ * uintptr_t data = memory.AllocateData(0x40); // RW
+ * ...
+ * memory.FreeArenaMemory(code);
+ * memory.ReleaseArena(); // все блоки разом (при отсоединении это делает ~MemoryManager)
+ * @endcode
+ */
+#pragma once
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Platform.hpp"
+
+class MemoryManager;
+
+
+/**
+ * @brief Пул арены
+ */
+enum class ArenaPool : uint8_t
+{
+    Code, ///< Исполняемая память (PAGE_EXECUTE_READ): трамплины, пещеры кода
+    Data  ///< Данные (PAGE_READWRITE): буферы, аргументы, переменные внедрённого кода
+};
+
+/**
+ * @brief Статистика пула RemoteArena
+ */
+struct RemoteArenaStats
+{
+    size_t   blocks{0};            ///< Выделения в процессе (блоки и крупные выделения)
+    size_t   reservedBytes{0};     ///< Память, выделенная в процессе
+    size_t   usedBytes{0};         ///< Память занятых кусков (с округлением до класса)
+    size_t   requestedBytes{0};    ///< Запрошенная память занятых кусков
+    size_t   liveAllocations{0};   ///< Занятые куски
+    uint64_t allocations{0};       ///< Вызовы allocate()
+    uint64_t frees{0};             ///< Вызовы free()
+    uint64_t systemAllocations{0}; ///< Вызовы AllocateMemory (VirtualAllocEx)
+
+    /**
+     * @brief Доля выделенной в процессе памяти, занятая кусками
+     */
+    double utilization() const
+    {
+        return reservedBytes ? static_cast<double>(usedBytes) / static_cast<double>(reservedBytes) : 0.0;
+    }
+};
+
+/**
+ * @class RemoteArena
+ * @brief Суб-аллокатор поверх MemoryManager::AllocateMemory
+ * @details VirtualAllocEx выделяет память с гранулярностью 64 KiB, поэтому отдельное выделение на каждый
+ * трамплин расходует адресное пространство 32-битного процесса и стоит системного вызова. Арена выделяет
+ * блоки BLOCK_SIZE и нарезает их на куски с размерами-степенями двойки от MIN_CHUNK до MAX_CHUNK. Кусок
+ * выровнен по своему размеру. Освобождённые куски возвращаются в список свободных своего класса и
+ * переиспользуются без обращения к процессу. Запросы больше MAX_CHUNK получают собственное выделение.
+ * Пулы Code и Data не смешиваются: исполняемые страницы не бывают доступны для записи, код в них пишется
+ * через WriteTransaction. Учёт ведётся только на нашей стороне, в памяти процесса заголовков нет.
+ * Менеджер памяти не хранится, он передаётся в вызовы. Не потокобезопасен.
+ */
+class RemoteArena
+{
+  public:
+    static constexpr size_t BLOCK_SIZE = 0x10000; ///< Размер блока (гранулярность VirtualAllocEx)
+    static constexpr size_t MIN_CHUNK  = 16;      ///< Наименьший класс размера
+    static constexpr size_t MAX_CHUNK  = 0x800;   ///< Наибольший класс размера
+    static constexpr size_t MAX_ALIGN  = 0x1000;  ///< Наибольшее выравнивание
+
+    RemoteArena() = default;
+
+    RemoteArena(const RemoteArena&)            = delete;
+    RemoteArena& operator=(const RemoteArena&) = delete;
+    RemoteArena(RemoteArena&&)                 = default;
+    RemoteArena& operator=(RemoteArena&&)      = default;
+
+    /**
+     * @brief Выделяет кусок памяти
+     * @param memory Менеджер памяти процесса
+     * @param pool Пул
+     * @param size Размер
+     * @param alignment Выравнивание (степень двойки, не больше MAX_ALIGN)
+     * @return Адрес в процессе или 0 при ошибке (см. error())
+     */
+    uintptr_t allocate(MemoryManager& memory, ArenaPool pool, size_t size, size_t alignment = MIN_CHUNK);
+
+    /**
+     * @brief Возвращает кусок в арену
+     * @return false если адрес не выделен ареной
+     * @details Куски блоков только возвращаются в список свободных; крупные выделения освобождаются в процессе
+     */
+    bool free(MemoryManager& memory, uintptr_t address);
+
+    /**
+     * @brief Освобождает в процессе все блоки и крупные выделения
+     * @return false если какое-либо выделение не освобождено (учёт арены очищается в любом случае)
+     */
+    bool release(MemoryManager& memory);
+
+    /**
+     * @brief Адрес является занятым куском арены
+     */
+    bool owns(uintptr_t address) const { return m_allocations.count(address) != 0; }
+
+    /**
+     * @brief Статистика пула
+     */
+    const RemoteArenaStats& stats(ArenaPool pool) const { return m_pools[static_cast<size_t>(pool)].stats; }
+
+    /**
+     * @brief Описание последней ошибки
+     */
+    const std::string& error() const { return m_error; }
+
+  private:
+    static constexpr size_t CLASS_COUNT = 8;           ///< Классы 16, 32, ..., 2048
+    static constexpr size_t LARGE       = CLASS_COUNT; ///< "Класс" крупного выделения
+
+    /**
+     * @brief Блок, нарезаемый с начала
+     */
+    struct Block
+    {
+        uintptr_t address{0}; ///< Начало блока
+        size_t    used{0};    ///< Нарезанная часть
+    };
+
+    /**
+     * @brief Пул с блоками и списками свободных кусков
+     */
+    struct Pool
+    {
+        std::vector<Block>                              blocks;    ///< Блоки (нарезается последний)
+        std::array<std::vector<uintptr_t>, CLASS_COUNT> freeLists; ///< Свободные куски по классам
+        std::vector<uintptr_t>                          large;     ///< Крупные выделения
+        RemoteArenaStats                                stats;     ///< Статистика
+    };
+
+    /**
+     * @brief Занятый кусок
+     */
+    struct Allocation
+    {
+        ArenaPool pool{ArenaPool::Code}; ///< Пул
+        uint8_t   sizeClass{0};          ///< Класс размера или LARGE
+        size_t    size{0};               ///< Размер куска (для LARGE - выделения, кратный странице)
+        size_t    requested{0};          ///< Запрошенный размер
+    };
+
+    /**
+     * @brief Права страниц пула
+     */
+    static DWORD protection(ArenaPool pool) { return pool == ArenaPool::Code ? PAGE_EXECUTE_READ : PAGE_READWRITE; }
+
+    /**
+     * @brief Нарезает кусок из последнего блока пула, выделяя новый блок при нехватке места
+     */
+    uintptr_t carve(MemoryManager& memory, ArenaPool pool, size_t chunk);
+
+    std::array<Pool, 2>                       m_pools;       ///< Пулы Code и Data
+    std::unordered_map<uintptr_t, Allocation> m_allocations; ///< Занятые куски по адресу
+    std::string                               m_error;       ///< Последняя ошибка
+};
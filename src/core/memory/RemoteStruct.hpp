@@ -0,0 +1,266 @@
+/**
+ * @file RemoteStruct.hpp
+ * @brief Декларативное описание структур целевого процесса
+ * @details Пример:
+ * @code
+ * using CharacterLayout = RemoteStruct<CharacterData,
+ *                                      RemoteField<&CharacterData::currentHealth, 0x48>,
+ *                                      RemoteField<&CharacterData::level, 0x88>>;
+ * CharacterData data;
+ * CharacterLayout::read(memory, playerAddress, data);
+ * @endcode
+ * Описание проверяется при компиляции: поля идут по возрастанию смещений и не пересекаются,
+ * типы полей тривиально копируемые и принадлежат описываемой структуре.
+ */
+#pragma once
+#include <array>
+#include <type_traits>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "MemoryManager.hpp"
+
+
+namespace remote_struct_detail
+{
+    /**
+     * @brief Разбор типа указателя на член класса
+     */
+    template <typename>
+    struct MemberPointerTraits;
+
+    template <typename C, typename V>
+    struct MemberPointerTraits<V C::*>
+    {
+        using Owner = C;
+        using Value = V;
+    };
+} // namespace remote_struct_detail
+
+/**
+ * @brief Поле удалённой структуры
+ * @tparam Member Указатель на член локальной структуры
+ * @tparam Offset Смещение поля от начала структуры в целевом процессе
+ */
+template <auto Member, uint32_t Offset>
+struct RemoteField
+{
+    using Owner = typename remote_struct_detail::MemberPointerTraits<decltype(Member)>::Owner;
+    using Value = typename remote_struct_detail::MemberPointerTraits<decltype(Member)>::Value;
+
+    static constexpr uint32_t OFFSET = Offset;        ///< Смещение в целевом процессе
+    static constexpr size_t   SIZE   = sizeof(Value); ///< Размер поля
+
+    static_assert(std::is_trivially_copyable_v<Value>, "RemoteField value must be trivially copyable");
+
+    /**
+     * @brief Копирует значение поля из буфера в локальную структуру
+     */
+    static void decode(const uint8_t* source, Owner& object) { std::memcpy(&(object.*Member), source, SIZE); }
+
+    /**
+     * @brief Копирует значение поля из локальной структуры в буфер
+     */
+    static void encode(uint8_t* destination, const Owner& object) { std::memcpy(destination, &(object.*Member), SIZE); }
+
+    /**
+     * @brief Проверяет, отличается ли поле в двух экземплярах структуры
+     */
+    static bool differs(const Owner& left, const Owner& right)
+    {
+        return std::memcmp(&(left.*Member), &(right.*Member), SIZE) != 0;
+    }
+};
+
+/**
+ * @class RemoteStruct
+ * @brief Отображение структуры целевого процесса на локальную структуру
+ * @tparam T Локальная структура
+ * @tparam Fields Поля RemoteField, по возрастанию смещений
+ * @details Чтение - один TryReadMemory минимального покрывающего диапазона [BEGIN, END)
+ * и раскладка полей через memcpy. Запись - только изменённых полей, соседние изменённые
+ * поля объединяются в одну запись.
+ */
+template <typename T, typename... Fields>
+class RemoteStruct
+{
+  public:
+    using Struct = T;
+
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields); ///< Количество полей
+
+    static_assert(FIELD_COUNT > 0, "RemoteStruct requires at least one field");
+    static_assert((std::is_same_v<typename Fields::Owner, T> && ...), "RemoteField must belong to the described struct");
+
+    static constexpr std::array<uint32_t, FIELD_COUNT> OFFSETS{Fields::OFFSET...}; ///< Смещения полей
+    static constexpr std::array<size_t, FIELD_COUNT>   SIZES{Fields::SIZE...};     ///< Размеры полей
+
+    static constexpr uint32_t BEGIN = OFFSETS.front(); ///< Начало покрывающего диапазона
+    static constexpr uint32_t END   = OFFSETS.back() + static_cast<uint32_t>(SIZES.back()); ///< Конец диапазона
+    static constexpr size_t   SIZE  = END - BEGIN; ///< Размер одного чтения
+
+    /**
+     * @brief Читает структуру одним обращением к памяти цели
+     * @param memory Менеджер памяти процесса
+     * @param address Адрес начала структуры в целевом процессе (смещения считаются от него)
+     * @param object Локальная структура; при ошибке не изменяется
+     * @return true если чтение успешно
+     */
+    static bool read(MemoryManager& memory, uintptr_t address, T& object)
+    {
+        std::array<uint8_t, SIZE> buffer;
+        if (memory.TryReadMemory(address + BEGIN, buffer.data(), SIZE) != ReadError::None)
+        {
+            return false;
+        }
+        decode(buffer.data(), object);
+        return true;
+    }
+
+    /**
+     * @brief Раскладывает поля из буфера, содержащего диапазон [BEGIN, END)
+     * @details Позволяет читать структуры через ReadBatch и декодировать их отдельно
+     */
+    static void decode(const uint8_t* buffer, T& object) { (Fields::decode(buffer + (Fields::OFFSET - BEGIN), object), ...); }
+
+    /**
+     * @brief Копирует одно поле по его индексу в описании
+     * @param index Индекс поля (0..FIELD_COUNT-1)
+     * @param source Значение поля (SIZES[index] байт)
+     * @details Нужен потребителям, получающим изменения по отдельным полям (WatchList)
+     */
+    static void decodeField(size_t index, const uint8_t* source, T& object)
+    {
+        size_t current = 0;
+        ((current++ == index ? Fields::decode(source, object) : void()), ...);
+    }
+
+    /**
+     * @brief Записывает поля, отличающиеся от последнего известного состояния цели
+     * @param memory Менеджер памяти процесса
+     * @param address Адрес начала структуры в целевом процессе
+     * @param object Новые значения
+     * @param remote Значения, которые сейчас находятся в памяти цели
+     * @return true если все изменённые поля записаны (или изменений нет)
+     */
+    static bool writeDirty(MemoryManager& memory, uintptr_t address, const T& object, const T& remote)
+    {
+        const std::array<bool, FIELD_COUNT> dirty{Fields::differs(object, remote)...};
+
+        std::array<uint8_t, SIZE> buffer;
+        (Fields::encode(buffer.data() + (Fields::OFFSET - BEGIN), object), ...);
+
+        bool success = true;
+        for (size_t first = 0; first < FIELD_COUNT;)
+        {
+            if (!dirty[first])
+            {
+                first++;
+                continue;
+            }
+
+            // Расширяем запись на следующие изменённые поля, если между ними нет зазора
+            size_t last = first;
+            while (last + 1 < FIELD_COUNT && dirty[last + 1] && OFFSETS[last + 1] == OFFSETS[last] + SIZES[last])
+            {
+                last++;
+            }
+
+            const uint32_t begin = OFFSETS[first];
+            const uint32_t end   = OFFSETS[last] + static_cast<uint32_t>(SIZES[last]);
+            success &= memory.WriteMemory(address + begin, buffer.data() + (begin - BEGIN), end - begin);
+
+            first = last + 1;
+        }
+        return success;
+    }
+
+  private:
+    /**
+     * @brief Проверяет, что поля идут по возрастанию смещений и не пересекаются
+     */
+    static constexpr bool fieldsOrdered()
+    {
+        for (size_t i = 1; i < FIELD_COUNT; i++)
+        {
+            if (OFFSETS[i] < OFFSETS[i - 1] + SIZES[i - 1])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(fieldsOrdered(), "RemoteStruct fields must be sorted by offset and must not overlap");
+};
+
+/**
+ * @class RemoteMirror
+ * @brief Локальная копия удалённой структуры с отслеживанием изменений
+ * @tparam Layout Описание RemoteStruct
+ * @details pull() читает структуру и запоминает состояние цели, edit() даёт изменить
+ * локальную копию, push() записывает только поля, изменённые после последнего pull()/push().
+ */
+template <typename Layout>
+class RemoteMirror
+{
+  public:
+    using Value = typename Layout::Struct;
+
+    /**
+     * @brief Читает структуру из памяти цели
+     * @param memory Менеджер памяти процесса
+     * @param address Адрес структуры в целевом процессе
+     * @return true если чтение успешно (локальные изменения при этом отбрасываются)
+     */
+    bool pull(MemoryManager& memory, uintptr_t address)
+    {
+        if (!Layout::read(memory, address, m_remote))
+        {
+            return false;
+        }
+        m_address = address;
+        m_value   = m_remote;
+        return true;
+    }
+
+    /**
+     * @brief Записывает изменённые поля в память цели
+     * @return true если все изменения записаны
+     */
+    bool push(MemoryManager& memory)
+    {
+        if (m_address == 0)
+        {
+            return false;
+        }
+        if (!Layout::writeDirty(memory, m_address, m_value, m_remote))
+        {
+            return false;
+        }
+        m_remote = m_value;
+        return true;
+    }
+
+    /**
+     * @brief Текущие значения
+     */
+    const Value& value() const { return m_value; }
+
+    /**
+     * @brief Значения для изменения перед push()
+     */
+    Value& edit() { return m_value; }
+
+    /**
+     * @brief Адрес структуры, прочитанной последним pull()
+     */
+    uintptr_t address() const { return m_address; }
+
+  private:
+    Value     m_value{};    ///< Локальная копия (с изменениями)
+    Value     m_remote{};   ///< Последнее известное состояние цели
+    uintptr_t m_address{0}; ///< Адрес структуры в целевом процессе
+};
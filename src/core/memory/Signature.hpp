@@ -0,0 +1,181 @@
+/**
+ * @file Signature.hpp
+ * @brief Сигнатуры в стиле IDA, разбираемые на этапе компиляции
+ * @details Пример:
+ * @code
+ * constexpr auto PLAYER_FUNC_SIG = "8B 0D ?? ?? ?? ?? 85 C9"_sig;
+ * uintptr_t address = memory.FindPattern(PLAYER_FUNC_SIG.toPattern());
+ * @endcode
+ * Ошибка в записи сигнатуры (неверный hex, лишний символ) - ошибка компиляции.
+ */
+#pragma once
+#include <array>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "PatternScanner.hpp"
+
+
+/**
+ * @brief Строковый литерал как параметр шаблона
+ */
+template <size_t N>
+struct SignatureLiteral
+{
+    char text[N]{};
+
+    consteval SignatureLiteral(const char (&literal)[N])
+    {
+        for (size_t i = 0; i < N; i++)
+        {
+            text[i] = literal[i];
+        }
+    }
+
+    /**
+     * @brief Длина строки без нуль-терминатора
+     */
+    static constexpr size_t length() { return N - 1; }
+};
+
+/**
+ * @brief Сигнатура фиксированной длины, полностью вычисленная при компиляции
+ * @tparam N Количество байт сигнатуры
+ */
+template <size_t N>
+struct Signature
+{
+    std::array<uint8_t, N> bytes{};         ///< Байты (wildcard = 0)
+    std::array<uint8_t, N> mask{};          ///< Маска (0xFF - значимый байт, 0x00 - wildcard)
+    size_t                 anchor{0};       ///< Смещение самого редкого значимого байта
+    size_t                 secondAnchor{0}; ///< Смещение второго опорного байта
+
+    /**
+     * @brief Количество байт сигнатуры
+     */
+    static constexpr size_t size() { return N; }
+
+    /**
+     * @brief Преобразует в BytePattern для PatternScanner/MemoryManager::FindPattern
+     * @details Опорные байты уже выбраны при компиляции и передаются как есть.
+     */
+    BytePattern toPattern() const
+    {
+        return BytePattern(std::vector<uint8_t>(bytes.begin(), bytes.end()),
+                           std::vector<uint8_t>(mask.begin(), mask.end()),
+                           anchor,
+                           secondAnchor);
+    }
+};
+
+namespace signature_detail
+{
+    /**
+     * @brief Значение шестнадцатеричной цифры (ошибка компиляции для неверного символа)
+     */
+    consteval uint8_t hexDigit(char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return static_cast<uint8_t>(c - '0');
+        }
+        if (c >= 'A' && c <= 'F')
+        {
+            return static_cast<uint8_t>(c - 'A' + 10);
+        }
+        if (c >= 'a' && c <= 'f')
+        {
+            return static_cast<uint8_t>(c - 'a' + 10);
+        }
+        throw "Invalid hex digit in signature";
+    }
+
+    /**
+     * @brief Количество токенов (байтов) в записи сигнатуры
+     * @details Токены разделяются пробелами; "?" и "??" - wildcard
+     */
+    template <SignatureLiteral Literal>
+    consteval size_t countTokens()
+    {
+        size_t count   = 0;
+        bool   inToken = false;
+        for (size_t i = 0; i < Literal.length(); i++)
+        {
+            const bool space = Literal.text[i] == ' ';
+            if (!space && !inToken)
+            {
+                count++;
+            }
+            inToken = !space;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Разбирает запись сигнатуры в байты, маску и опорные байты
+     */
+    template <SignatureLiteral Literal>
+    consteval auto parse()
+    {
+        constexpr size_t count = countTokens<Literal>();
+        static_assert(count > 0, "Signature must contain at least one byte");
+
+        Signature<count> result;
+        size_t           index = 0;
+
+        for (size_t i = 0; i < Literal.length();)
+        {
+            if (Literal.text[i] == ' ')
+            {
+                i++;
+                continue;
+            }
+
+            size_t end = i;
+            while (end < Literal.length() && Literal.text[end] != ' ')
+            {
+                end++;
+            }
+
+            const size_t tokenLength = end - i;
+            if (Literal.text[i] == '?')
+            {
+                if (tokenLength > 2 || (tokenLength == 2 && Literal.text[i + 1] != '?'))
+                {
+                    throw "Invalid wildcard in signature";
+                }
+                result.bytes[index] = 0x00;
+                result.mask[index]  = 0x00;
+            }
+            else
+            {
+                if (tokenLength != 2)
+                {
+                    throw "Signature byte must be two hex digits";
+                }
+                result.bytes[index] = static_cast<uint8_t>(hexDigit(Literal.text[i]) << 4 | hexDigit(Literal.text[i + 1]));
+                result.mask[index]  = 0xFF;
+            }
+
+            index++;
+            i = end;
+        }
+
+        if (!selectPatternAnchors(result.bytes.data(), result.mask.data(), count, result.anchor, result.secondAnchor))
+        {
+            throw "Signature must contain at least one significant byte";
+        }
+        return result;
+    }
+} // namespace signature_detail
+
+/**
+ * @brief Литерал сигнатуры: "8B 0D ?? ?? ?? ?? 85 C9"_sig
+ */
+template <SignatureLiteral Literal>
+consteval auto operator""_sig()
+{
+    return signature_detail::parse<Literal>();
+}
@@ -0,0 +1,125 @@
+#include "SignatureCache.hpp"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSettings>
+
+
+SignatureCache& SignatureCache::instance()
+{
+    static SignatureCache instance;
+    return instance;
+}
+
+SignatureCache::SignatureCache()
+{
+    const QString baseDir = QCoreApplication::instance() ? QCoreApplication::applicationDirPath() : QDir::currentPath();
+    m_filePath            = QDir(baseDir).filePath("cache/signatures.ini");
+}
+
+void SignatureCache::setFilePath(const QString& filePath)
+{
+    QMutexLocker locker(&m_mutex);
+    m_filePath = filePath;
+    m_images.clear();
+}
+
+QString SignatureCache::groupName(uint64_t imageHash)
+{
+    return QString("image_%1").arg(imageHash, 16, 16, QChar('0'));
+}
+
+std::string SignatureCache::entryKey(const std::string& key, uint64_t patternHash)
+{
+    return key + "." + QString("%1").arg(patternHash, 16, 16, QChar('0')).toStdString();
+}
+
+SignatureCache::Entries& SignatureCache::entriesFor(uint64_t imageHash)
+{
+    auto it = m_images.find(imageHash);
+    if (it != m_images.end())
+    {
+        return it->second;
+    }
+
+    Entries   entries;
+    QSettings settings(m_filePath, QSettings::IniFormat);
+    settings.beginGroup(groupName(imageHash));
+    for (const QString& key : settings.childKeys())
+    {
+        bool           ok  = false;
+        const uint32_t rva = settings.value(key).toString().toUInt(&ok, 16);
+        if (ok)
+        {
+            entries.emplace(key.toStdString(), rva);
+        }
+    }
+    settings.endGroup();
+
+    qDebug() << "Loaded" << entries.size() << "cached signatures for image" << groupName(imageHash);
+    return m_images.emplace(imageHash, std::move(entries)).first->second;
+}
+
+bool SignatureCache::lookup(uint64_t imageHash, const std::string& key, uint64_t patternHash, uint32_t& rva)
+{
+    QMutexLocker locker(&m_mutex);
+    const Entries& entries = entriesFor(imageHash);
+
+    auto it = entries.find(entryKey(key, patternHash));
+    if (it == entries.end())
+    {
+        m_stats.misses++;
+        return false;
+    }
+
+    m_stats.hits++;
+    rva = it->second;
+    return true;
+}
+
+void SignatureCache::store(uint64_t imageHash, const std::string& key, uint64_t patternHash, uint32_t rva)
+{
+    QMutexLocker      locker(&m_mutex);
+    const std::string entry = entryKey(key, patternHash);
+    entriesFor(imageHash)[entry] = rva;
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    QSettings settings(m_filePath, QSettings::IniFormat);
+    settings.beginGroup(groupName(imageHash));
+    settings.setValue(QString::fromStdString(entry), QString::number(rva, 16));
+    settings.endGroup();
+    settings.sync();
+}
+
+void SignatureCache::remove(uint64_t imageHash, const std::string& key, uint64_t patternHash)
+{
+    QMutexLocker      locker(&m_mutex);
+    const std::string entry = entryKey(key, patternHash);
+    entriesFor(imageHash).erase(entry);
+    m_stats.stale++;
+
+    QSettings settings(m_filePath, QSettings::IniFormat);
+    settings.beginGroup(groupName(imageHash));
+    settings.remove(QString::fromStdString(entry));
+    settings.endGroup();
+    settings.sync();
+}
+
+void SignatureCache::invalidate(uint64_t imageHash)
+{
+    QMutexLocker locker(&m_mutex);
+    m_images.erase(imageHash);
+
+    QSettings settings(m_filePath, QSettings::IniFormat);
+    settings.remove(groupName(imageHash));
+    settings.sync();
+}
+
+SignatureCache::Stats SignatureCache::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
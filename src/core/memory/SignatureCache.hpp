@@ -0,0 +1,110 @@
+/**
+ * @file SignatureCache.hpp
+ * @brief Постоянный кэш результатов поиска сигнатур
+ * @details Хранит смещения (RVA), найденные сканированием, с привязкой к хэшу образа модуля.
+ * Второй клиент с тем же run.exe или повторный запуск бота получает все смещения без сканирования.
+ */
+#pragma once
+#include <string>
+#include <unordered_map>
+
+#include <QMutex>
+#include <QString>
+
+#include <cstdint>
+
+
+/**
+ * @class SignatureCache
+ * @brief Общий для всех процессов кэш "хэш образа + ключ и хэш сигнатуры -> RVA"
+ * @details Синглтон (как LogManager): записи для одного и того же образа переиспользуются
+ * всеми MemoryManager в приложении. Данные хранятся в INI-файле (cache/signatures.ini рядом
+ * с исполняемым файлом), по группе на хэш образа. При изменении заголовков образа меняется хэш,
+ * при изменении байтов или маски сигнатуры - хэш сигнатуры, и старые записи перестают находиться.
+ * Хэш образа не покрывает байты секций, поэтому найденное смещение вызывающий проверяет по памяти
+ * и удаляет устаревшую запись через remove(). Потокобезопасен.
+ */
+class SignatureCache
+{
+  public:
+    /**
+     * @brief Статистика обращений к кэшу
+     */
+    struct Stats
+    {
+        uint64_t hits{0};   ///< Смещения, полученные из кэша
+        uint64_t misses{0}; ///< Смещения, которых не было в кэше
+        uint64_t stale{0};  ///< Найденные записи, удалённые из-за несовпадения с памятью (входят в hits)
+    };
+
+    /**
+     * @brief Получить единственный экземпляр кэша
+     */
+    static SignatureCache& instance();
+
+    /**
+     * @brief Ищет смещение сигнатуры
+     * @param imageHash Хэш образа модуля
+     * @param key Ключ сигнатуры
+     * @param patternHash Хэш байтов и маски сигнатуры
+     * @param rva Сюда записывается смещение от базы модуля
+     * @return true если запись найдена
+     */
+    bool lookup(uint64_t imageHash, const std::string& key, uint64_t patternHash, uint32_t& rva);
+
+    /**
+     * @brief Сохраняет смещение сигнатуры (в памяти и на диске)
+     * @param imageHash Хэш образа модуля
+     * @param key Ключ сигнатуры
+     * @param patternHash Хэш байтов и маски сигнатуры
+     * @param rva Смещение от базы модуля
+     */
+    void store(uint64_t imageHash, const std::string& key, uint64_t patternHash, uint32_t rva);
+
+    /**
+     * @brief Удаляет устаревшую запись сигнатуры (в памяти и на диске)
+     */
+    void remove(uint64_t imageHash, const std::string& key, uint64_t patternHash);
+
+    /**
+     * @brief Удаляет все записи для образа
+     */
+    void invalidate(uint64_t imageHash);
+
+    /**
+     * @brief Меняет путь к файлу кэша (по умолчанию cache/signatures.ini рядом с exe)
+     */
+    void setFilePath(const QString& filePath);
+
+    /**
+     * @brief Получает статистику кэша
+     */
+    Stats stats() const;
+
+  private:
+    SignatureCache();
+    SignatureCache(const SignatureCache&)            = delete;
+    SignatureCache& operator=(const SignatureCache&) = delete;
+
+    using Entries = std::unordered_map<std::string, uint32_t>;
+
+    /**
+     * @brief Возвращает записи образа, подгружая их с диска при первом обращении
+     */
+    Entries& entriesFor(uint64_t imageHash);
+
+    /**
+     * @brief Имя группы INI-файла для образа
+     */
+    static QString groupName(uint64_t imageHash);
+
+    /**
+     * @brief Ключ записи: ключ сигнатуры и хэш её байтов
+     */
+    static std::string entryKey(const std::string& key, uint64_t patternHash);
+
+    mutable QMutex                        m_mutex;    ///< Мьютекс для потокобезопасности
+    QString                               m_filePath; ///< Путь к INI-файлу
+    std::unordered_map<uint64_t, Entries> m_images;   ///< Загруженные записи по хэшу образа
+    Stats                                 m_stats;    ///< Статистика
+};
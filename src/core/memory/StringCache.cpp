@@ -0,0 +1,136 @@
+#include "StringCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "MemoryManager.hpp"
+
+
+namespace
+{
+    constexpr size_t PAGE_SIZE = 0x1000; ///< Граница, на которой чтение строки может оборваться
+} // namespace
+
+
+StringId StringCache::read(MemoryManager& memory, uintptr_t address, size_t maxLength)
+{
+    m_stats.lookups++;
+    maxLength = std::min(maxLength, MAX_LENGTH);
+
+    // Слово проверки не должно выходить за строку и её страницу
+    const size_t width = std::min({sizeof(uint64_t), maxLength, PAGE_SIZE - (address & (PAGE_SIZE - 1))});
+    uint64_t     validation = 0;
+    if (width == 0 || memory.TryReadMemory(address, &validation, width) != ReadError::None)
+    {
+        m_stats.failedReads++;
+        return INVALID_STRING;
+    }
+
+    auto it = m_entries.find(address);
+    if (it != m_entries.end() && it->second.validation == validation && it->second.maxLength == maxLength)
+    {
+        m_stats.hits++;
+        return it->second.id;
+    }
+    return refresh(memory, address, maxLength, validation);
+}
+
+StringId StringCache::read(MemoryManager& memory, uintptr_t address, size_t maxLength, uint64_t validation)
+{
+    const StringId id = cached(address, maxLength, validation);
+    return id != INVALID_STRING ? id : refresh(memory, address, std::min(maxLength, MAX_LENGTH), validation);
+}
+
+StringId StringCache::cached(uintptr_t address, size_t maxLength, uint64_t validation)
+{
+    m_stats.lookups++;
+    maxLength = std::min(maxLength, MAX_LENGTH);
+
+    auto it = m_entries.find(address);
+    if (it != m_entries.end() && it->second.validation == validation && it->second.maxLength == maxLength)
+    {
+        m_stats.hits++;
+        return it->second.id;
+    }
+    return INVALID_STRING;
+}
+
+StringId StringCache::store(uintptr_t address, size_t maxLength, uint64_t validation, std::string_view bytes)
+{
+    m_stats.refreshes++;
+    maxLength = std::min(maxLength, MAX_LENGTH);
+
+    bytes = bytes.substr(0, std::min(bytes.find('\0'), maxLength));
+    const StringId id  = intern(bytes);
+    m_entries[address] = Entry{validation, id, static_cast<uint32_t>(maxLength)};
+    return id;
+}
+
+StringId StringCache::refresh(MemoryManager& memory, uintptr_t address, size_t maxLength, uint64_t validation)
+{
+    m_stats.refreshes++;
+    if (m_buffer.size() < MAX_LENGTH)
+    {
+        m_buffer.resize(MAX_LENGTH);
+    }
+
+    // Короткая строка у конца региона: повторяем чтение до границы страницы
+    size_t length = maxLength;
+    if (memory.TryReadMemory(address, m_buffer.data(), length) != ReadError::None)
+    {
+        length = std::min(length, PAGE_SIZE - (address & (PAGE_SIZE - 1)));
+        if (length == maxLength || memory.TryReadMemory(address, m_buffer.data(), length) != ReadError::None)
+        {
+            m_stats.failedReads++;
+            m_entries.erase(address);
+            return INVALID_STRING;
+        }
+    }
+
+    const void* terminator = std::memchr(m_buffer.data(), '\0', length);
+    if (terminator)
+    {
+        length = static_cast<const char*>(terminator) - m_buffer.data();
+    }
+
+    const StringId id  = intern(std::string_view(m_buffer.data(), length));
+    m_entries[address] = Entry{validation, id, static_cast<uint32_t>(maxLength)};
+    return id;
+}
+
+StringId StringCache::intern(std::string_view text)
+{
+    auto it = m_lookup.find(text);
+    if (it != m_lookup.end())
+    {
+        return it->second;
+    }
+
+    const StringId id = static_cast<StringId>(m_strings.size());
+    m_strings.emplace_back(text);
+    m_lookup.emplace(std::string_view(m_strings.back()), id);
+    m_stats.bytes += text.size();
+    return id;
+}
+
+StringId StringCache::find(std::string_view text) const
+{
+    auto it = m_lookup.find(text);
+    return it != m_lookup.end() ? it->second : INVALID_STRING;
+}
+
+void StringCache::clear()
+{
+    m_entries.clear();
+    m_lookup.clear();
+    m_strings.clear();
+    m_stats = StringCacheStats{};
+}
+
+StringCacheStats StringCache::stats() const
+{
+    StringCacheStats stats = m_stats;
+    stats.entries          = m_entries.size();
+    stats.strings          = m_strings.size();
+    return stats;
+}
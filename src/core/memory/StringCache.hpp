@@ -0,0 +1,163 @@
+/**
+ * @file StringCache.hpp
+ * @brief Кэш строк целевого процесса с интернированием
+ * @details Пример (имя персонажа):
+ * @code
+ * StringCache names;
+ * const StringId id = names.read(memory, nameAddress, 12);
+ * if (id != INVALID_STRING) { std::string_view name = names.view(id); ... }
+ * @endcode
+ * Если строка читается в обход MemoryManager (например, через AsyncReader), запись кэша
+ * проверяется cached() до чтения и заполняется store() после него.
+ */
+#pragma once
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+class MemoryManager;
+
+
+/**
+ * @brief Идентификатор интернированной строки (стабилен до clear())
+ */
+using StringId = uint32_t;
+
+/**
+ * @brief Недействительный идентификатор (строку не удалось прочитать)
+ */
+inline constexpr StringId INVALID_STRING = UINT32_MAX;
+
+/**
+ * @brief Статистика StringCache
+ */
+struct StringCacheStats
+{
+    uint64_t lookups{0};     ///< Вызовы read()
+    uint64_t hits{0};        ///< Строка взята из кэша (слово проверки не изменилось)
+    uint64_t refreshes{0};   ///< Строка перечитана (новый адрес или изменилось слово проверки)
+    uint64_t failedReads{0}; ///< Неудачные чтения
+    size_t   entries{0};     ///< Адреса в кэше
+    size_t   strings{0};     ///< Интернированные строки
+    size_t   bytes{0};       ///< Символы интернированных строк
+};
+
+/**
+ * @class StringCache
+ * @brief Строки процесса по адресам с повторным чтением только при смене слова проверки
+ * @details Для каждого адреса хранится слово проверки и идентификатор строки. По умолчанию
+ * слово - первые 8 байт строки: обращение к закэшированному адресу читает только их, а строка
+ * целиком перечитывается, лишь если они изменились. Вызывающий код может передать собственное
+ * слово (GUID объекта, значение указателя на строку) - тогда попадание в кэш не читает память
+ * вовсе. Одинаковые строки интернируются в один идентификатор, поэтому имена можно сравнивать
+ * по StringId. Представления view() стабильны до clear(). В установившемся режиме (строки уже
+ * прочитаны) read() не выделяет память. Не потокобезопасен.
+ */
+class StringCache
+{
+  public:
+    static constexpr size_t MAX_LENGTH = 1024; ///< Максимальная длина читаемой строки
+
+    StringCache() = default;
+
+    StringCache(const StringCache&)            = delete;
+    StringCache& operator=(const StringCache&) = delete;
+    StringCache(StringCache&&)                 = default;
+    StringCache& operator=(StringCache&&)      = default;
+
+    /**
+     * @brief Читает строку; слово проверки - первые 8 байт строки
+     * @param memory Менеджер памяти процесса
+     * @param address Абсолютный адрес строки
+     * @param maxLength Максимальная длина без нуль-терминатора (не больше MAX_LENGTH)
+     * @return Идентификатор или INVALID_STRING при ошибке чтения
+     * @details Изменение строки дальше первых 8 байт без изменения начала не обнаруживается -
+     * для таких строк передавайте собственное слово проверки
+     */
+    StringId read(MemoryManager& memory, uintptr_t address, size_t maxLength);
+
+    /**
+     * @brief Читает строку, если слово проверки отличается от сохранённого для адреса
+     * @param validation Слово, меняющееся вместе со строкой (например, GUID владельца)
+     */
+    StringId read(MemoryManager& memory, uintptr_t address, size_t maxLength, uint64_t validation);
+
+    /**
+     * @brief Строка адреса, если слово проверки совпадает с сохранённым (память не читается)
+     * @return INVALID_STRING если строку нужно прочитать и передать в store()
+     */
+    StringId cached(uintptr_t address, size_t maxLength, uint64_t validation);
+
+    /**
+     * @brief Сохраняет прочитанную вызывающим кодом строку адреса
+     * @param bytes Прочитанные байты (обрезаются по первому нулю)
+     * @return Идентификатор интернированной строки
+     */
+    StringId store(uintptr_t address, size_t maxLength, uint64_t validation, std::string_view bytes);
+
+    /**
+     * @brief Интернирует строку
+     */
+    StringId intern(std::string_view text);
+
+    /**
+     * @brief Ищет интернированную строку
+     * @return INVALID_STRING если строка не встречалась
+     */
+    StringId find(std::string_view text) const;
+
+    /**
+     * @brief Текст строки (пустой для INVALID_STRING)
+     */
+    std::string_view view(StringId id) const
+    {
+        return id < m_strings.size() ? std::string_view(m_strings[id]) : std::string_view();
+    }
+
+    /**
+     * @brief Забывает адрес: следующий read() перечитает строку
+     */
+    void invalidate(uintptr_t address) { m_entries.erase(address); }
+
+    /**
+     * @brief Забывает все адреса, интернированные строки сохраняются
+     */
+    void clearEntries() { m_entries.clear(); }
+
+    /**
+     * @brief Удаляет всё; выданные идентификаторы и представления становятся недействительны
+     */
+    void clear();
+
+    /**
+     * @brief Статистика
+     */
+    StringCacheStats stats() const;
+
+  private:
+    /**
+     * @brief Закэшированный адрес
+     */
+    struct Entry
+    {
+        uint64_t validation{0};      ///< Слово проверки на момент чтения
+        StringId id{INVALID_STRING}; ///< Строка
+        uint32_t maxLength{0};       ///< Длина, с которой строка читалась
+    };
+
+    /**
+     * @brief Читает строку целиком и обновляет запись адреса
+     */
+    StringId refresh(MemoryManager& memory, uintptr_t address, size_t maxLength, uint64_t validation);
+
+    std::deque<std::string>                        m_strings; ///< Строки по идентификаторам (адреса не меняются)
+    std::unordered_map<std::string_view, StringId> m_lookup;  ///< Текст -> идентификатор (ключи ссылаются на m_strings)
+    std::unordered_map<uintptr_t, Entry>           m_entries; ///< Адрес -> строка
+    std::vector<char>                              m_buffer;  ///< Буфер чтения
+    StringCacheStats                               m_stats;   ///< Счётчики
+};
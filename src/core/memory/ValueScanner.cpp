@@ -0,0 +1,766 @@
+#include "ValueScanner.hpp"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "PatternScanner.hpp"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define MDBOT_VALUE_X86 1
+#include <immintrin.h>
+#endif
+
+// MSVC разрешает AVX2-интринсики без флагов компиляции, GCC/Clang требуют атрибут target
+#if defined(MDBOT_VALUE_X86) && !defined(_MSC_VER)
+#define MDBOT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MDBOT_TARGET_AVX2
+#endif
+
+
+#pragma region Kernels
+namespace
+{
+    constexpr size_t WORD_BITS = 64;                                    ///< Адресов в слове битовой карты
+    constexpr size_t MAX_WORDS = ValueScanner::PAGE_SIZE / WORD_BITS; ///< Слов на страницу при шаге 1
+
+    /**
+     * @brief Границы условий Exact/Range в типе значения
+     */
+    template <typename T>
+    struct Bounds
+    {
+        T low{};  ///< Нижняя граница (включительно)
+        T high{}; ///< Верхняя граница (включительно)
+    };
+
+    /**
+     * @brief Переводит условие Exact/Range в границы типа T
+     * @return false если ни одно значение типа не удовлетворяет условию
+     */
+    template <typename T>
+    bool makeBounds(const ValueScanQuery& query, Bounds<T>& bounds)
+    {
+        double low  = query.value;
+        double high = query.filter == ScanFilter::Range ? query.upper : query.value;
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (query.filter == ScanFilter::Exact)
+            {
+                low -= query.epsilon;
+                high += query.epsilon;
+            }
+            bounds.low  = static_cast<T>(low);
+            bounds.high = static_cast<T>(high);
+            return !(low > high);
+        }
+        else
+        {
+            // Целочисленные границы: округляем внутрь диапазона и обрезаем по типу
+            low  = std::max(std::ceil(low), 0.0);
+            high = std::min(std::floor(high), static_cast<double>(std::numeric_limits<T>::max()));
+            if (!(low <= high))
+            {
+                return false;
+            }
+            bounds.low  = static_cast<T>(low);
+            bounds.high = static_cast<T>(high);
+            return true;
+        }
+    }
+
+    template <typename T>
+    T loadValue(const uint8_t* data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Побитовое равенство (NaN с тем же представлением считается неизменившимся)
+     */
+    template <typename T>
+    bool sameBits(T left, T right)
+    {
+        return std::memcmp(&left, &right, sizeof(T)) == 0;
+    }
+
+    template <typename T, ScanFilter F>
+    bool test(T current, T previous, const Bounds<T>& bounds)
+    {
+        if constexpr (F == ScanFilter::Unknown)
+        {
+            return true;
+        }
+        else if constexpr (F == ScanFilter::Exact || F == ScanFilter::Range)
+        {
+            return bounds.low <= current && current <= bounds.high;
+        }
+        else if constexpr (F == ScanFilter::Changed)
+        {
+            return !sameBits(current, previous);
+        }
+        else if constexpr (F == ScanFilter::Unchanged)
+        {
+            return sameBits(current, previous);
+        }
+        else if constexpr (F == ScanFilter::Increased)
+        {
+            return current > previous;
+        }
+        else
+        {
+            return current < previous;
+        }
+    }
+
+#ifdef MDBOT_VALUE_X86
+    /**
+     * @brief AVX2: 64 значения uint32 в диапазоне [low, high] (беззнаковое x - low <= high - low)
+     */
+    MDBOT_TARGET_AVX2 uint64_t rangeWordU32(const uint8_t* data, uint32_t low, uint32_t high)
+    {
+        const __m256i lowVector  = _mm256_set1_epi32(static_cast<int>(low));
+        const __m256i spanVector = _mm256_set1_epi32(static_cast<int>(high - low));
+
+        uint64_t mask = 0;
+        for (size_t i = 0; i < WORD_BITS / 8; i++)
+        {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 32));
+            const __m256i delta = _mm256_sub_epi32(value, lowVector);
+            const __m256i in    = _mm256_cmpeq_epi32(_mm256_min_epu32(delta, spanVector), delta);
+            mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(in)))) << (i * 8);
+        }
+        return mask;
+    }
+
+    /**
+     * @brief AVX2: 64 значения float в диапазоне [low, high]
+     */
+    MDBOT_TARGET_AVX2 uint64_t rangeWordFloat(const uint8_t* data, float low, float high)
+    {
+        const __m256 lowVector  = _mm256_set1_ps(low);
+        const __m256 highVector = _mm256_set1_ps(high);
+
+        uint64_t mask = 0;
+        for (size_t i = 0; i < WORD_BITS / 8; i++)
+        {
+            const __m256 value = _mm256_loadu_ps(reinterpret_cast<const float*>(data + i * 32));
+            const __m256 in    = _mm256_and_ps(_mm256_cmp_ps(value, lowVector, _CMP_GE_OQ),
+                                            _mm256_cmp_ps(value, highVector, _CMP_LE_OQ));
+            mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_ps(in))) << (i * 8);
+        }
+        return mask;
+    }
+
+    /**
+     * @brief AVX2: побитовое равенство 64 четырёхбайтных значений с прошлыми
+     */
+    MDBOT_TARGET_AVX2 uint64_t equalWord32(const uint8_t* data, const uint8_t* previous)
+    {
+        uint64_t mask = 0;
+        for (size_t i = 0; i < WORD_BITS / 8; i++)
+        {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 32));
+            const __m256i old   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + i * 32));
+            const __m256i same  = _mm256_cmpeq_epi32(value, old);
+            mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(same)))) << (i * 8);
+        }
+        return mask;
+    }
+#endif
+
+    /**
+     * @brief Проверяет слово из 64 адресов
+     * @param data Значение первого адреса слова
+     * @param stride Шаг адресов
+     * @param candidates Кандидаты слова
+     * @param valid Адреса, значения которых целиком прочитаны и лежат в диапазоне поиска
+     * @param previous Прошлые значения кандидатов слова подряд (nullptr при первом поиске)
+     * @return Прошедшие проверку адреса
+     */
+    template <typename T, ScanFilter F>
+    uint64_t evaluateWord(const uint8_t*   data,
+                          size_t           stride,
+                          uint64_t         candidates,
+                          uint64_t         valid,
+                          const uint8_t*   previous,
+                          const Bounds<T>& bounds,
+                          bool             avx2)
+    {
+        constexpr bool usesPrevious = F != ScanFilter::Unknown && F != ScanFilter::Exact && F != ScanFilter::Range;
+
+        if constexpr (F == ScanFilter::Unknown)
+        {
+            return candidates & valid;
+        }
+
+        if (candidates == ~0ull && valid == ~0ull && stride == sizeof(T))
+        {
+#ifdef MDBOT_VALUE_X86
+            if (avx2)
+            {
+                if constexpr (std::is_same_v<T, uint32_t> && (F == ScanFilter::Exact || F == ScanFilter::Range))
+                {
+                    return rangeWordU32(data, bounds.low, bounds.high);
+                }
+                else if constexpr (std::is_same_v<T, float> && (F == ScanFilter::Exact || F == ScanFilter::Range))
+                {
+                    return rangeWordFloat(data, bounds.low, bounds.high);
+                }
+                else if constexpr (sizeof(T) == 4 && F == ScanFilter::Changed)
+                {
+                    return ~equalWord32(data, previous);
+                }
+                else if constexpr (sizeof(T) == 4 && F == ScanFilter::Unchanged)
+                {
+                    return equalWord32(data, previous);
+                }
+            }
+#endif
+            // Плотное слово без ветвлений: компилятор векторизует цикл для остальных типов
+            uint64_t mask = 0;
+            for (size_t j = 0; j < WORD_BITS; j++)
+            {
+                const T current = loadValue<T>(data + j * sizeof(T));
+                const T old     = usesPrevious ? loadValue<T>(previous + j * sizeof(T)) : T{};
+                mask |= static_cast<uint64_t>(test<T, F>(current, old, bounds)) << j;
+            }
+            return mask;
+        }
+
+        uint64_t mask = 0;
+        size_t   rank = 0;
+        for (uint64_t bits = candidates; bits; bits &= bits - 1, rank++)
+        {
+            const unsigned j = static_cast<unsigned>(std::countr_zero(bits));
+            if (!((valid >> j) & 1))
+            {
+                continue;
+            }
+
+            const T current = loadValue<T>(data + j * stride);
+            const T old     = usesPrevious ? loadValue<T>(previous + rank * sizeof(T)) : T{};
+            mask |= static_cast<uint64_t>(test<T, F>(current, old, bounds)) << j;
+        }
+        return mask;
+    }
+
+    template <typename T>
+    double toDouble(const uint8_t* data)
+    {
+        return static_cast<double>(loadValue<T>(data));
+    }
+} // namespace
+#pragma endregion Kernels
+
+#pragma region CandidateSet
+void ValueScanner::CandidateSet::append(CandidateSet&& other)
+{
+    if (pages.empty())
+    {
+        *this = std::move(other);
+        return;
+    }
+
+    for (CandidatePage page : other.pages)
+    {
+        if (page.encoding == PageEncoding::Offsets)
+        {
+            page.index += offsets.size();
+        }
+        else if (page.encoding == PageEncoding::Bitmap)
+        {
+            page.index += bitmaps.size();
+        }
+        page.valueIndex += values.size();
+        pages.push_back(page);
+    }
+
+    offsets.insert(offsets.end(), other.offsets.begin(), other.offsets.end());
+    bitmaps.insert(bitmaps.end(), other.bitmaps.begin(), other.bitmaps.end());
+    values.insert(values.end(), other.values.begin(), other.values.end());
+    count += other.count;
+}
+#pragma endregion CandidateSet
+
+#pragma region ValueScanner
+size_t ValueScanner::valueSize(ScanValueType type)
+{
+    switch (type)
+    {
+        case ScanValueType::UInt8:
+            return sizeof(uint8_t);
+        case ScanValueType::UInt16:
+            return sizeof(uint16_t);
+        case ScanValueType::UInt32:
+            return sizeof(uint32_t);
+        case ScanValueType::Float:
+            return sizeof(float);
+        case ScanValueType::Double:
+            return sizeof(double);
+    }
+    return 0;
+}
+
+void ValueScanner::reset()
+{
+    m_candidates = CandidateSet{};
+    m_stats      = ValueScanStats{};
+    m_error.clear();
+}
+
+bool ValueScanner::firstScan(MemoryManager& memory, const ValueScanOptions& options, const ValueScanQuery& query)
+{
+    reset();
+
+    if (query.filter != ScanFilter::Unknown && query.filter != ScanFilter::Exact && query.filter != ScanFilter::Range)
+    {
+        m_error = "Comparison with the previous value requires a previous scan";
+        return false;
+    }
+
+    m_options                = options;
+    const size_t size        = valueSize(options.type);
+    m_options.alignment      = options.alignment ? options.alignment : size;
+    const size_t alignment   = m_options.alignment;
+    if (alignment > 8 || !std::has_single_bit(alignment))
+    {
+        m_error = "Alignment must be 1, 2, 4 or 8";
+        return false;
+    }
+    if (options.start >= options.end)
+    {
+        m_error = "Empty address range";
+        return false;
+    }
+
+    // Страницы кандидатов совпадают со страницами памяти: перечитываются целиком при следующем поиске
+    m_options.start     = (options.start + alignment - 1) & ~(alignment - 1);
+    m_options.shardSize = std::max(PAGE_SIZE, (options.shardSize + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1));
+
+    const auto shards = memory.PlanScanShards(m_options.start & ~(PAGE_SIZE - 1), m_options.end, size - 1, m_options.shardSize);
+    runScan(memory, shards, {}, query);
+    return true;
+}
+
+bool ValueScanner::nextScan(MemoryManager& memory, const ValueScanQuery& query)
+{
+    m_error.clear();
+    if (!hasScan())
+    {
+        m_error = "First scan has not been performed";
+        return false;
+    }
+
+    // Соседние страницы с кандидатами читаются одним обращением
+    std::vector<MemoryManager::ScanShard> shards;
+    std::vector<PageRange>                pageRanges;
+    const auto&                           pages = m_candidates.pages;
+    for (size_t first = 0; first < pages.size();)
+    {
+        size_t last = first + 1;
+        while (last < pages.size() && pages[last].address == pages[last - 1].address + PAGE_SIZE &&
+               (last - first) * PAGE_SIZE < m_options.shardSize)
+        {
+            last++;
+        }
+
+        const size_t size = (last - first) * PAGE_SIZE;
+        shards.push_back(MemoryManager::ScanShard{pages[first].address, size, size});
+        pageRanges.emplace_back(first, last);
+        first = last;
+    }
+
+    runScan(memory, shards, pageRanges, query);
+    return true;
+}
+
+void ValueScanner::runScan(MemoryManager&                               memory,
+                           const std::vector<MemoryManager::ScanShard>& shards,
+                           const std::vector<PageRange>&                pageRanges,
+                           const ValueScanQuery&                        query)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<CandidateSet> outputs(shards.size());
+    std::atomic<uint64_t>     bytesRead{0};
+
+    const size_t failedShards = memory.RunShardsParallel(
+        shards,
+        m_options.threads,
+        false,
+        [&](size_t index, uintptr_t, const uint8_t* data, size_t size)
+        {
+            bytesRead.fetch_add(size, std::memory_order_relaxed);
+            const PageRange pages = pageRanges.empty() ? PageRange{0, 0} : pageRanges[index];
+            switch (m_options.type)
+            {
+                case ScanValueType::UInt8:
+                    dispatchShard<uint8_t>(shards[index], data, pages, query, outputs[index]);
+                    break;
+                case ScanValueType::UInt16:
+                    dispatchShard<uint16_t>(shards[index], data, pages, query, outputs[index]);
+                    break;
+                case ScanValueType::UInt32:
+                    dispatchShard<uint32_t>(shards[index], data, pages, query, outputs[index]);
+                    break;
+                case ScanValueType::Float:
+                    dispatchShard<float>(shards[index], data, pages, query, outputs[index]);
+                    break;
+                case ScanValueType::Double:
+                    dispatchShard<double>(shards[index], data, pages, query, outputs[index]);
+                    break;
+            }
+            return false;
+        });
+
+    // Шарды упорядочены по адресам - результат собирается простым дописыванием
+    size_t totalValues = 0;
+    for (const auto& output : outputs)
+    {
+        totalValues += output.values.size();
+    }
+
+    CandidateSet merged;
+    for (auto& output : outputs)
+    {
+        if (output.pages.empty())
+        {
+            continue;
+        }
+        const bool firstOutput = merged.pages.empty();
+        merged.append(std::move(output));
+        if (firstOutput)
+        {
+            merged.values.reserve(totalValues);
+        }
+    }
+    m_candidates = std::move(merged);
+
+    m_stats.scans++;
+    m_stats.bytesRead    = bytesRead.load();
+    m_stats.failedShards = failedShards;
+    m_stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    updateStorageStats();
+
+    qDebug() << "Value scan" << m_stats.scans << "read" << m_stats.bytesRead << "bytes in" << shards.size() << "shards,"
+             << m_stats.candidates << "candidates left in" << m_stats.milliseconds << "ms," << failedShards
+             << "shards unreadable";
+}
+
+template <typename T>
+void ValueScanner::dispatchShard(const MemoryManager::ScanShard& shard,
+                                 const uint8_t*                  data,
+                                 PageRange                       pages,
+                                 const ValueScanQuery&           query,
+                                 CandidateSet&                   output) const
+{
+    switch (query.filter)
+    {
+        case ScanFilter::Unknown:
+            scanShard<T, ScanFilter::Unknown>(shard, data, pages, query, output);
+            return;
+        case ScanFilter::Exact:
+            scanShard<T, ScanFilter::Exact>(shard, data, pages, query, output);
+            return;
+        case ScanFilter::Range:
+            scanShard<T, ScanFilter::Range>(shard, data, pages, query, output);
+            return;
+        case ScanFilter::Changed:
+            scanShard<T, ScanFilter::Changed>(shard, data, pages, query, output);
+            return;
+        case ScanFilter::Unchanged:
+            scanShard<T, ScanFilter::Unchanged>(shard, data, pages, query, output);
+            return;
+        case ScanFilter::Increased:
+            scanShard<T, ScanFilter::Increased>(shard, data, pages, query, output);
+            return;
+        case ScanFilter::Decreased:
+            scanShard<T, ScanFilter::Decreased>(shard, data, pages, query, output);
+            return;
+    }
+}
+
+template <typename T, ScanFilter F>
+void ValueScanner::scanShard(const MemoryManager::ScanShard& shard,
+                             const uint8_t*                  data,
+                             PageRange                       pages,
+                             const ValueScanQuery&           query,
+                             CandidateSet&                   output) const
+{
+    Bounds<T> bounds;
+    if constexpr (F == ScanFilter::Exact || F == ScanFilter::Range)
+    {
+        if (!makeBounds(query, bounds))
+        {
+            return;
+        }
+    }
+
+    const size_t stride        = m_options.alignment;
+    const size_t slotsPerPage  = PAGE_SIZE / stride;
+    const size_t wordsPerPage  = (slotsPerPage + WORD_BITS - 1) / WORD_BITS;
+    const bool   avx2          = PatternScanner::simdLevel() == PatternScanner::SimdLevel::AVX2;
+    const bool   firstScanMode = pages.first == pages.second;
+
+    std::array<uint64_t, MAX_WORDS> candidates;
+    std::array<uint64_t, MAX_WORDS> valid;
+    std::array<uint64_t, MAX_WORDS> survivors;
+
+    // Адреса страницы, значения которых целиком прочитаны и начинаются в [start, end)
+    const auto computeValid = [&](uintptr_t pageAddress, size_t available)
+    {
+        size_t firstSlot = 0;
+        if (pageAddress < m_options.start)
+        {
+            firstSlot = (m_options.start - pageAddress + stride - 1) / stride;
+        }
+
+        size_t endSlot = available >= sizeof(T) ? (available - sizeof(T)) / stride + 1 : 0;
+        endSlot        = std::min(endSlot, slotsPerPage);
+        if (m_options.end - pageAddress < PAGE_SIZE)
+        {
+            endSlot = std::min(endSlot, (m_options.end - pageAddress + stride - 1) / stride);
+        }
+
+        for (size_t w = 0; w < wordsPerPage; w++)
+        {
+            const size_t begin = w * WORD_BITS;
+            const size_t low   = std::clamp(firstSlot, begin, begin + WORD_BITS) - begin;
+            const size_t high  = std::clamp(endSlot, begin, begin + WORD_BITS) - begin;
+            uint64_t     word  = 0;
+            if (high > low)
+            {
+                word = (high - low == WORD_BITS ? ~0ull : ((1ull << (high - low)) - 1)) << low;
+            }
+            valid[w] = word;
+        }
+    };
+
+    const auto processPage = [&](uintptr_t pageAddress, const uint8_t* pageData, const uint8_t* previous)
+    {
+        const size_t valueStart = output.values.size();
+        uint32_t     count      = 0;
+
+        for (size_t w = 0; w < wordsPerPage; w++)
+        {
+            const uint8_t* wordData = pageData + w * WORD_BITS * stride;
+            survivors[w] = evaluateWord<T, F>(wordData, stride, candidates[w], valid[w], previous, bounds, avx2);
+            if (previous)
+            {
+                previous += std::popcount(candidates[w]) * sizeof(T);
+            }
+
+            const uint64_t mask = survivors[w];
+            if (!mask)
+            {
+                continue;
+            }
+            count += static_cast<uint32_t>(std::popcount(mask));
+
+            // Значения кандидатов хранятся подряд: для сравнения в следующем поиске
+            if (mask == ~0ull && stride == sizeof(T))
+            {
+                output.values.insert(output.values.end(), wordData, wordData + WORD_BITS * sizeof(T));
+                continue;
+            }
+            for (uint64_t bits = mask; bits; bits &= bits - 1)
+            {
+                const uint8_t* value = wordData + std::countr_zero(bits) * stride;
+                output.values.insert(output.values.end(), value, value + sizeof(T));
+            }
+        }
+
+        if (count == 0)
+        {
+            return;
+        }
+
+        CandidatePage page;
+        page.address    = pageAddress;
+        page.valueIndex = valueStart;
+        page.count      = count;
+
+        // Самое компактное представление: диапазон, список смещений или битовая карта
+        if (count == slotsPerPage)
+        {
+            page.encoding = PageEncoding::Full;
+        }
+        else if (count * sizeof(uint16_t) < wordsPerPage * sizeof(uint64_t))
+        {
+            page.encoding = PageEncoding::Offsets;
+            page.index    = output.offsets.size();
+            for (size_t w = 0; w < wordsPerPage; w++)
+            {
+                for (uint64_t bits = survivors[w]; bits; bits &= bits - 1)
+                {
+                    output.offsets.push_back(static_cast<uint16_t>(w * WORD_BITS + std::countr_zero(bits)));
+                }
+            }
+        }
+        else
+        {
+            page.encoding = PageEncoding::Bitmap;
+            page.index    = output.bitmaps.size();
+            output.bitmaps.insert(output.bitmaps.end(), survivors.begin(), survivors.begin() + wordsPerPage);
+        }
+
+        output.pages.push_back(page);
+        output.count += count;
+    };
+
+    if (firstScanMode)
+    {
+        candidates.fill(~0ull);
+        for (size_t offset = 0; offset < shard.size; offset += PAGE_SIZE)
+        {
+            computeValid(shard.address + offset, shard.readSize - offset);
+            processPage(shard.address + offset, data + offset, nullptr);
+        }
+        return;
+    }
+
+    for (size_t index = pages.first; index < pages.second; index++)
+    {
+        const CandidatePage& page   = m_candidates.pages[index];
+        const size_t         offset = page.address - shard.address;
+
+        switch (page.encoding)
+        {
+            case PageEncoding::Full:
+                candidates.fill(~0ull);
+                break;
+            case PageEncoding::Offsets:
+                candidates.fill(0);
+                for (size_t i = 0; i < page.count; i++)
+                {
+                    const uint16_t slot = m_candidates.offsets[page.index + i];
+                    candidates[slot / WORD_BITS] |= 1ull << (slot % WORD_BITS);
+                }
+                break;
+            case PageEncoding::Bitmap:
+                std::copy_n(m_candidates.bitmaps.begin() + page.index, wordsPerPage, candidates.begin());
+                break;
+        }
+
+        computeValid(page.address, shard.readSize - offset);
+        processPage(page.address, data + offset, m_candidates.values.data() + page.valueIndex);
+    }
+}
+
+std::vector<ValueScanResult> ValueScanner::results(size_t first, size_t limit) const
+{
+    std::vector<ValueScanResult> result;
+    const size_t                 size   = valueSize(m_options.type);
+    const size_t                 stride = m_options.alignment;
+
+    const auto convert = [&](const uint8_t* data)
+    {
+        switch (m_options.type)
+        {
+            case ScanValueType::UInt8:
+                return toDouble<uint8_t>(data);
+            case ScanValueType::UInt16:
+                return toDouble<uint16_t>(data);
+            case ScanValueType::UInt32:
+                return toDouble<uint32_t>(data);
+            case ScanValueType::Float:
+                return toDouble<float>(data);
+            case ScanValueType::Double:
+                return toDouble<double>(data);
+        }
+        return 0.0;
+    };
+
+    for (const CandidatePage& page : m_candidates.pages)
+    {
+        if (result.size() >= limit)
+        {
+            break;
+        }
+        if (first >= page.count)
+        {
+            first -= page.count;
+            continue;
+        }
+
+        size_t     rank = 0;
+        const auto emit = [&](size_t slot)
+        {
+            if (rank >= first && result.size() < limit)
+            {
+                result.push_back(ValueScanResult{page.address + slot * stride,
+                                                 convert(m_candidates.values.data() + page.valueIndex + rank * size)});
+            }
+            rank++;
+        };
+
+        switch (page.encoding)
+        {
+            case PageEncoding::Full:
+                for (size_t slot = 0; slot < page.count; slot++)
+                {
+                    emit(slot);
+                }
+                break;
+            case PageEncoding::Offsets:
+                for (size_t i = 0; i < page.count; i++)
+                {
+                    emit(m_candidates.offsets[page.index + i]);
+                }
+                break;
+            case PageEncoding::Bitmap:
+                for (size_t w = 0; w * WORD_BITS < PAGE_SIZE / stride; w++)
+                {
+                    for (uint64_t bits = m_candidates.bitmaps[page.index + w]; bits; bits &= bits - 1)
+                    {
+                        emit(w * WORD_BITS + std::countr_zero(bits));
+                    }
+                }
+                break;
+        }
+        first = 0;
+    }
+    return result;
+}
+
+void ValueScanner::updateStorageStats()
+{
+    m_stats.candidates  = m_candidates.count;
+    m_stats.pages       = m_candidates.pages.size();
+    m_stats.fullPages   = 0;
+    m_stats.sparsePages = 0;
+    m_stats.bitmapPages = 0;
+    for (const CandidatePage& page : m_candidates.pages)
+    {
+        switch (page.encoding)
+        {
+            case PageEncoding::Full:
+                m_stats.fullPages++;
+                break;
+            case PageEncoding::Offsets:
+                m_stats.sparsePages++;
+                break;
+            case PageEncoding::Bitmap:
+                m_stats.bitmapPages++;
+                break;
+        }
+    }
+
+    m_stats.storageBytes = m_candidates.pages.size() * sizeof(CandidatePage) +
+                           m_candidates.offsets.size() * sizeof(uint16_t) +
+                           m_candidates.bitmaps.size() * sizeof(uint64_t) + m_candidates.values.size();
+}
+#pragma endregion ValueScanner
@@ -0,0 +1,268 @@
+/**
+ * @file ValueScanner.hpp
+ * @brief Поиск адресов по значению с последовательным сужением (first scan / next scan)
+ * @details Пример поиска текущего здоровья:
+ * @code
+ * ValueScanner scanner;
+ * scanner.firstScan(memory, {.type = ScanValueType::UInt32}, {.filter = ScanFilter::Exact, .value = 4120});
+ * // ... персонаж получил урон ...
+ * scanner.nextScan(memory, {.filter = ScanFilter::Decreased});
+ * scanner.nextScan(memory, {.filter = ScanFilter::Exact, .value = 3870});
+ * for (const auto& result : scanner.results(0, 100)) { ... }
+ * @endcode
+ */
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MemoryManager.hpp"
+
+
+/**
+ * @brief Тип искомого значения
+ */
+enum class ScanValueType
+{
+    UInt8,
+    UInt16,
+    UInt32,
+    Float,
+    Double
+};
+
+/**
+ * @brief Условие отбора кандидатов
+ */
+enum class ScanFilter
+{
+    Unknown,   ///< Любое значение (первый поиск неизвестного значения - снимок всей памяти)
+    Exact,     ///< Равно value (для float/double - с допуском epsilon)
+    Range,     ///< value <= x <= upper
+    Changed,   ///< Изменилось с прошлого поиска
+    Unchanged, ///< Не изменилось с прошлого поиска
+    Increased, ///< Увеличилось с прошлого поиска
+    Decreased  ///< Уменьшилось с прошлого поиска
+};
+
+/**
+ * @brief Параметры одного шага поиска
+ */
+struct ValueScanQuery
+{
+    ScanFilter filter{ScanFilter::Exact}; ///< Условие
+    double     value{0};                  ///< Exact: значение; Range: нижняя граница
+    double     upper{0};                  ///< Range: верхняя граница
+    double     epsilon{0};                ///< Exact для float/double: допустимое отклонение
+};
+
+/**
+ * @brief Параметры первого поиска (действуют до reset())
+ */
+struct ValueScanOptions
+{
+    ScanValueType type{ScanValueType::UInt32}; ///< Тип значения
+    size_t        alignment{0};                ///< Шаг адресов: 1, 2, 4 или 8 (0 - размер типа)
+    uintptr_t     start{0};                    ///< Начало диапазона
+    uintptr_t     end{UINTPTR_MAX};            ///< Конец диапазона (не включительно)
+    unsigned      threads{0};                  ///< Количество потоков (0 - по числу ядер)
+    size_t        shardSize{0x400000};         ///< Размер задания одного потока (кратен странице)
+};
+
+/**
+ * @brief Найденный адрес и значение на момент последнего поиска
+ */
+struct ValueScanResult
+{
+    uintptr_t address{0}; ///< Адрес
+    double    value{0};   ///< Значение
+};
+
+/**
+ * @brief Статистика последнего поиска
+ */
+struct ValueScanStats
+{
+    size_t   scans{0};        ///< Количество выполненных поисков с последнего reset()
+    size_t   candidates{0};   ///< Оставшиеся кандидаты
+    size_t   pages{0};        ///< Страницы с кандидатами
+    size_t   fullPages{0};    ///< Страницы, где кандидаты - все адреса (хранятся диапазоном)
+    size_t   sparsePages{0};  ///< Страницы со списком смещений
+    size_t   bitmapPages{0};  ///< Страницы с битовой картой
+    size_t   storageBytes{0}; ///< Память под кандидатов и их значения
+    uint64_t bytesRead{0};    ///< Прочитано байт из процесса
+    size_t   failedShards{0}; ///< Шарды, которые не удалось прочитать (их кандидаты отброшены)
+    double   milliseconds{0}; ///< Длительность поиска
+};
+
+/**
+ * @class ValueScanner
+ * @brief Многопоточный поиск значений с хранением кандидатов по страницам
+ * @details Первый поиск обходит читаемую память шардами MemoryManager::RunShardsParallel.
+ * Кандидаты хранятся по страницам 4 KiB в одном из трёх видов: вся страница (диапазон без
+ * битовой карты), список 16-битных смещений (мало кандидатов) или битовая карта - выбирается
+ * самый компактный. Для каждого кандидата хранится значение на момент поиска, поэтому
+ * фильтры Changed/Increased/... сравнивают с прошлым значением без повторного снимка.
+ * Следующий поиск перечитывает только страницы с кандидатами, объединяя соседние страницы
+ * в одно чтение. Проверка ведётся словами по 64 адреса; плотные слова 4-байтных типов
+ * проверяются AVX2 (8 значений за сравнение), остальные - скалярно без ветвлений.
+ * Значение, выходящее за конец последней перечитанной страницы, отбрасывается
+ * (возможно только при шаге меньше размера типа).
+ */
+class ValueScanner
+{
+  public:
+    static constexpr size_t PAGE_SIZE = 0x1000; ///< Размер страницы кандидатов
+
+    /**
+     * @brief Первый поиск: сбрасывает прошлые результаты
+     * @param memory Менеджер памяти процесса
+     * @param options Тип, шаг и диапазон поиска
+     * @param query Условие: Unknown, Exact или Range
+     * @return false при неверных параметрах (см. error())
+     */
+    bool firstScan(MemoryManager& memory, const ValueScanOptions& options, const ValueScanQuery& query);
+
+    /**
+     * @brief Следующий поиск среди оставшихся кандидатов
+     * @param memory Менеджер памяти процесса
+     * @param query Любое условие
+     * @return false если первый поиск не выполнялся
+     */
+    bool nextScan(MemoryManager& memory, const ValueScanQuery& query);
+
+    /**
+     * @brief Сбрасывает результаты
+     */
+    void reset();
+
+    /**
+     * @brief Выполнялся ли первый поиск
+     */
+    bool hasScan() const { return m_stats.scans > 0; }
+
+    /**
+     * @brief Количество кандидатов
+     */
+    size_t count() const { return m_candidates.count; }
+
+    /**
+     * @brief Кандидаты по возрастанию адресов
+     * @param first Индекс первого кандидата
+     * @param limit Максимальное количество
+     */
+    std::vector<ValueScanResult> results(size_t first, size_t limit) const;
+
+    /**
+     * @brief Параметры текущей серии поисков
+     */
+    const ValueScanOptions& options() const { return m_options; }
+
+    /**
+     * @brief Статистика
+     */
+    const ValueScanStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Описание ошибки последнего вызова
+     */
+    const std::string& error() const { return m_error; }
+
+    /**
+     * @brief Размер значения типа в байтах
+     */
+    static size_t valueSize(ScanValueType type);
+
+  private:
+    /**
+     * @brief Способ хранения кандидатов страницы
+     */
+    enum class PageEncoding : uint8_t
+    {
+        Full,    ///< Все адреса страницы
+        Offsets, ///< Отсортированный список номеров адресов
+        Bitmap   ///< Битовая карта адресов
+    };
+
+    /**
+     * @brief Кандидаты одной страницы
+     */
+    struct CandidatePage
+    {
+        uintptr_t    address{0};                   ///< Начало страницы
+        size_t       valueIndex{0};                ///< Смещение значений в CandidateSet::values
+        size_t       index{0};                     ///< Начало в offsets или bitmaps
+        uint32_t     count{0};                     ///< Количество кандидатов
+        PageEncoding encoding{PageEncoding::Full}; ///< Способ хранения
+    };
+
+    /**
+     * @brief Набор кандидатов (общий результат или результат одного шарда)
+     */
+    struct CandidateSet
+    {
+        std::vector<CandidatePage> pages;    ///< Страницы по возрастанию адресов
+        std::vector<uint16_t>      offsets;  ///< Номера адресов страниц вида Offsets
+        std::vector<uint64_t>      bitmaps;  ///< Битовые карты страниц вида Bitmap
+        std::vector<uint8_t>       values;   ///< Значения кандидатов подряд, в порядке адресов
+        size_t                     count{0}; ///< Количество кандидатов
+
+        /**
+         * @brief Дописывает набор с большими адресами
+         */
+        void append(CandidateSet&& other);
+    };
+
+    /**
+     * @brief Диапазон страниц m_candidates [first, last), перечитываемый одним шардом
+     */
+    using PageRange = std::pair<size_t, size_t>;
+
+    /**
+     * @brief Выполняет шарды и собирает результат в m_candidates
+     * @param shards Шарды для чтения
+     * @param pageRanges Для следующего поиска - страницы каждого шарда; пусто для первого поиска
+     */
+    void runScan(MemoryManager&                               memory,
+                 const std::vector<MemoryManager::ScanShard>& shards,
+                 const std::vector<PageRange>&                pageRanges,
+                 const ValueScanQuery&                        query);
+
+    /**
+     * @brief Проверяет кандидатов одного прочитанного шарда
+     * @param shard Шард (собственная часть - shard.size байт)
+     * @param data Прочитанные байты шарда (shard.readSize)
+     * @param pages Страницы m_candidates шарда; пустой диапазон - первый поиск по всем адресам
+     * @param query Условие
+     * @param output Кандидаты, прошедшие проверку
+     */
+    template <typename T, ScanFilter F>
+    void scanShard(const MemoryManager::ScanShard& shard,
+                   const uint8_t*                  data,
+                   PageRange                       pages,
+                   const ValueScanQuery&           query,
+                   CandidateSet&                   output) const;
+
+    /**
+     * @brief Выбирает реализацию scanShard по типу и условию
+     */
+    template <typename T>
+    void dispatchShard(const MemoryManager::ScanShard& shard,
+                       const uint8_t*                  data,
+                       PageRange                       pages,
+                       const ValueScanQuery&           query,
+                       CandidateSet&                   output) const;
+
+    /**
+     * @brief Пересчитывает статистику хранения
+     */
+    void updateStorageStats();
+
+    ValueScanOptions m_options;    ///< Параметры текущей серии
+    CandidateSet     m_candidates; ///< Кандидаты
+    ValueScanStats   m_stats;      ///< Статистика
+    std::string      m_error;      ///< Ошибка последнего вызова
+};
@@ -0,0 +1,376 @@
+#include "WatchList.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "MemoryManager.hpp"
+#include "PatternScanner.hpp"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define MDBOT_WATCH_X86 1
+#include <immintrin.h>
+#endif
+
+// MSVC разрешает AVX2-интринсики без флагов компиляции, GCC/Clang требуют атрибут target
+#if defined(MDBOT_WATCH_X86) && !defined(_MSC_VER)
+#define MDBOT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MDBOT_TARGET_AVX2
+#endif
+
+
+#pragma region Kernels
+namespace
+{
+    static_assert(WatchList::BLOCK_SIZE == 32, "Diff kernels assume 32-byte blocks");
+
+    /**
+     * @brief Скалярное ядро: четыре 64-битных сравнения на блок
+     */
+    void diffScalar(const uint8_t* left, const uint8_t* right, size_t blockCount, std::vector<uint32_t>& blocks)
+    {
+        for (size_t block = 0; block < blockCount; block++)
+        {
+            const size_t offset = block * WatchList::BLOCK_SIZE;
+            uint64_t     delta  = 0;
+            for (size_t i = 0; i < WatchList::BLOCK_SIZE; i += sizeof(uint64_t))
+            {
+                uint64_t a, b;
+                std::memcpy(&a, left + offset + i, sizeof(a));
+                std::memcpy(&b, right + offset + i, sizeof(b));
+                delta |= a ^ b;
+            }
+            if (delta)
+            {
+                blocks.push_back(static_cast<uint32_t>(block));
+            }
+        }
+    }
+
+#ifdef MDBOT_WATCH_X86
+    /**
+     * @brief SSE2 ядро: два 16-байтных сравнения на блок
+     */
+    void diffSse2(const uint8_t* left, const uint8_t* right, size_t blockCount, std::vector<uint32_t>& blocks)
+    {
+        for (size_t block = 0; block < blockCount; block++)
+        {
+            const size_t  offset = block * WatchList::BLOCK_SIZE;
+            const __m128i low    = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left + offset)),
+                                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + offset)));
+            const __m128i high   = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left + offset + 16)),
+                                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + offset + 16)));
+            if (_mm_movemask_epi8(_mm_and_si128(low, high)) != 0xFFFF)
+            {
+                blocks.push_back(static_cast<uint32_t>(block));
+            }
+        }
+    }
+
+    /**
+     * @brief Загружает блок в AVX2-регистр
+     */
+    MDBOT_TARGET_AVX2 inline __m256i loadBlock(const uint8_t* data, size_t block)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + block * WatchList::BLOCK_SIZE));
+    }
+
+    /**
+     * @brief AVX2 ядро: блок - один регистр; четыре блока без изменений отсеиваются одним vptest
+     */
+    MDBOT_TARGET_AVX2 void diffAvx2(const uint8_t*         left,
+                                    const uint8_t*         right,
+                                    size_t                 blockCount,
+                                    std::vector<uint32_t>& blocks)
+    {
+        size_t block = 0;
+        for (; block + 4 <= blockCount; block += 4)
+        {
+            const __m256i delta0 = _mm256_xor_si256(loadBlock(left, block), loadBlock(right, block));
+            const __m256i delta1 = _mm256_xor_si256(loadBlock(left, block + 1), loadBlock(right, block + 1));
+            const __m256i delta2 = _mm256_xor_si256(loadBlock(left, block + 2), loadBlock(right, block + 2));
+            const __m256i delta3 = _mm256_xor_si256(loadBlock(left, block + 3), loadBlock(right, block + 3));
+
+            const __m256i any = _mm256_or_si256(_mm256_or_si256(delta0, delta1), _mm256_or_si256(delta2, delta3));
+            if (_mm256_testz_si256(any, any))
+            {
+                continue;
+            }
+
+            const __m256i deltas[4] = {delta0, delta1, delta2, delta3};
+            for (size_t i = 0; i < 4; i++)
+            {
+                if (!_mm256_testz_si256(deltas[i], deltas[i]))
+                {
+                    blocks.push_back(static_cast<uint32_t>(block + i));
+                }
+            }
+        }
+
+        for (; block < blockCount; block++)
+        {
+            const __m256i delta = _mm256_xor_si256(loadBlock(left, block), loadBlock(right, block));
+            if (!_mm256_testz_si256(delta, delta))
+            {
+                blocks.push_back(static_cast<uint32_t>(block));
+            }
+        }
+    }
+#endif
+
+    /**
+     * @brief Выравнивание значения поля в буфере (естественное, не больше 8 байт)
+     */
+    uint32_t fieldAlignment(uint32_t size)
+    {
+        uint32_t alignment = 1;
+        while (alignment < 8 && alignment * 2 <= size)
+        {
+            alignment *= 2;
+        }
+        return alignment;
+    }
+} // namespace
+#pragma endregion Kernels
+
+#pragma region WatchList
+WatchId WatchList::add(uintptr_t address, size_t size)
+{
+    if (size == 0 || size > UINT32_MAX)
+    {
+        return INVALID_WATCH;
+    }
+
+    WatchId id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = static_cast<WatchId>(m_watches.size());
+        m_watches.emplace_back();
+    }
+
+    Watch& watch  = m_watches[id];
+    watch         = Watch{};
+    watch.address = address;
+    watch.size    = static_cast<uint32_t>(size);
+    watch.active  = true;
+
+    m_watchCount++;
+    m_layoutDirty = true;
+    return id;
+}
+
+bool WatchList::remove(WatchId id)
+{
+    if (!contains(id))
+    {
+        return false;
+    }
+
+    m_watches[id].active = false;
+    m_freeIds.push_back(id);
+    m_watchCount--;
+    m_layoutDirty = true;
+    return true;
+}
+
+bool WatchList::setAddress(WatchId id, uintptr_t address)
+{
+    if (!contains(id))
+    {
+        return false;
+    }
+
+    Watch& watch = m_watches[id];
+    if (watch.address != address)
+    {
+        watch.address = address;
+        watch.fresh   = true;
+        m_layoutDirty = true;
+    }
+    return true;
+}
+
+void WatchList::clear()
+{
+    m_watches.clear();
+    m_freeIds.clear();
+    m_order.clear();
+    m_blockFirst.clear();
+    m_requests.clear();
+    m_current.clear();
+    m_previous.clear();
+    m_changedBlocks.clear();
+    m_changes.clear();
+    m_watchCount  = 0;
+    m_layoutDirty = false;
+}
+
+void WatchList::rebuildLayout()
+{
+    std::vector<WatchId> order;
+    order.reserve(m_watchCount);
+    for (WatchId id = 0; id < m_watches.size(); id++)
+    {
+        if (m_watches[id].active)
+        {
+            order.push_back(id);
+        }
+    }
+
+    // Запросы идут по возрастанию адресов: планировщик ReadBatch пропускает сортировку,
+    // а соседние в памяти цели поля оказываются рядом в буфере
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [this](WatchId a, WatchId b) { return m_watches[a].address < m_watches[b].address; });
+
+    uint32_t              end = 0;
+    std::vector<uint32_t> offsets(m_watches.size(), 0);
+    for (WatchId id : order)
+    {
+        const uint32_t alignment = fieldAlignment(m_watches[id].size);
+        offsets[id]              = (end + alignment - 1) & ~(alignment - 1);
+        end                      = offsets[id] + m_watches[id].size;
+    }
+
+    const size_t blockCount = (end + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const size_t bufferSize = blockCount * BLOCK_SIZE;
+
+    // Промежутки между полями остаются нулевыми в обоих буферах и не дают ложных отличий
+    std::vector<uint8_t> current(bufferSize, 0);
+    for (WatchId id : order)
+    {
+        Watch& watch = m_watches[id];
+        if (!watch.fresh)
+        {
+            std::memcpy(current.data() + offsets[id], m_current.data() + watch.offset, watch.size);
+        }
+        watch.offset = offsets[id];
+    }
+
+    m_current = std::move(current);
+    m_previous.assign(bufferSize, 0);
+    m_order = std::move(order);
+
+    m_requests.resize(m_order.size());
+    for (size_t i = 0; i < m_order.size(); i++)
+    {
+        const Watch& watch = m_watches[m_order[i]];
+        m_requests[i]      = ReadRequest{watch.address, watch.size, nullptr, false};
+    }
+
+    m_blockFirst.assign(blockCount, 0);
+    size_t position = 0;
+    for (size_t block = 0; block < blockCount; block++)
+    {
+        const size_t blockStart = block * BLOCK_SIZE;
+        while (position < m_order.size() &&
+               m_watches[m_order[position]].offset + m_watches[m_order[position]].size <= blockStart)
+        {
+            position++;
+        }
+        m_blockFirst[block] = static_cast<uint32_t>(position);
+    }
+
+    m_stats.watches    = m_watchCount;
+    m_stats.bufferSize = bufferSize;
+    m_layoutDirty      = false;
+}
+
+std::span<const WatchId> WatchList::poll(MemoryManager& memory)
+{
+    if (m_layoutDirty)
+    {
+        rebuildLayout();
+    }
+
+    m_changes.clear();
+    m_changedBlocks.clear();
+    m_stats.polls++;
+    m_stats.failedReads = 0;
+
+    // m_previous получает значения прошлого опроса, новые читаются на их место
+    std::swap(m_current, m_previous);
+    for (size_t i = 0; i < m_order.size(); i++)
+    {
+        m_requests[i].destination = m_current.data() + m_watches[m_order[i]].offset;
+    }
+
+    if (!m_requests.empty())
+    {
+        memory.ReadBatch(m_requests);
+    }
+
+    for (size_t i = 0; i < m_order.size(); i++)
+    {
+        const WatchId id    = m_order[i];
+        Watch&        watch = m_watches[id];
+        const bool    valid = m_requests[i].succeeded;
+
+        if (!valid)
+        {
+            // Непрочитанное поле сохраняет прошлое значение, чтобы не попасть в сравнение
+            std::memcpy(m_current.data() + watch.offset, m_previous.data() + watch.offset, watch.size);
+            m_stats.failedReads++;
+        }
+
+        if (watch.fresh || watch.valid != valid)
+        {
+            watch.fresh        = false;
+            watch.reportedPoll = m_stats.polls;
+            m_changes.push_back(id);
+        }
+        watch.valid = valid;
+    }
+
+    diffBlocks(m_current.data(), m_previous.data(), m_current.size() / BLOCK_SIZE, m_changedBlocks);
+
+    for (uint32_t block : m_changedBlocks)
+    {
+        const uint32_t blockEnd = (block + 1) * static_cast<uint32_t>(BLOCK_SIZE);
+        for (size_t i = m_blockFirst[block]; i < m_order.size(); i++)
+        {
+            const WatchId id    = m_order[i];
+            Watch&        watch = m_watches[id];
+            if (watch.offset >= blockEnd)
+            {
+                break;
+            }
+
+            // Поле на стыке блоков или с изменённой доступностью уже добавлено
+            if (watch.reportedPoll != m_stats.polls &&
+                std::memcmp(m_current.data() + watch.offset, m_previous.data() + watch.offset, watch.size) != 0)
+            {
+                watch.reportedPoll = m_stats.polls;
+                m_changes.push_back(id);
+            }
+        }
+    }
+
+    m_stats.changedBlocks = m_changedBlocks.size();
+    m_stats.changes       = m_changes.size();
+    return m_changes;
+}
+
+void WatchList::diffBlocks(const uint8_t* left, const uint8_t* right, size_t blockCount, std::vector<uint32_t>& blocks)
+{
+    switch (PatternScanner::simdLevel())
+    {
+#ifdef MDBOT_WATCH_X86
+        case PatternScanner::SimdLevel::AVX2:
+            diffAvx2(left, right, blockCount, blocks);
+            return;
+        case PatternScanner::SimdLevel::SSE2:
+            diffSse2(left, right, blockCount, blocks);
+            return;
+#endif
+        default:
+            diffScalar(left, right, blockCount, blocks);
+            return;
+    }
+}
+#pragma endregion WatchList
@@ -0,0 +1,196 @@
+/**
+ * @file WatchList.hpp
+ * @brief Отслеживание изменений набора полей целевого процесса
+ * @details Пример:
+ * @code
+ * WatchList watches;
+ * const WatchId health = watches.add<uint32_t>(playerAddress + 0x48);
+ * for (WatchId id : watches.poll(memory))
+ * {
+ *     if (id == health) { ... watches.value<uint32_t>(health) ... }
+ * }
+ * @endcode
+ */
+#pragma once
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ReadBatch.hpp"
+
+class MemoryManager;
+
+
+/**
+ * @brief Идентификатор наблюдаемого поля (стабилен до remove())
+ */
+using WatchId = uint32_t;
+
+/**
+ * @brief Недействительный идентификатор
+ */
+inline constexpr WatchId INVALID_WATCH = UINT32_MAX;
+
+/**
+ * @brief Статистика WatchList
+ */
+struct WatchListStats
+{
+    size_t   watches{0};       ///< Активные наблюдения
+    size_t   bufferSize{0};    ///< Размер буфера значений (с выравниванием)
+    size_t   changedBlocks{0}; ///< Блоки, отличившиеся в последнем опросе
+    size_t   changes{0};       ///< Изменившиеся поля в последнем опросе
+    size_t   failedReads{0};   ///< Поля, не прочитанные в последнем опросе
+    uint64_t polls{0};         ///< Количество опросов
+};
+
+/**
+ * @class WatchList
+ * @brief Набор наблюдаемых полей с пакетным чтением и SIMD-сравнением
+ * @details Значения всех полей лежат в одном сплошном буфере. Опрос - один
+ * MemoryManager::ReadBatch в текущий буфер и сравнение с предыдущим блоками по 32 байта
+ * (AVX2/SSE2, уровень выбирает PatternScanner::simdLevel()). Точная проверка полей выполняется
+ * только в отличившихся блоках, поэтому стоимость опроса без изменений - один проход сравнения.
+ * Поле, которое не удалось прочитать, сохраняет прошлое значение и считается изменившимся
+ * только при смене доступности (см. isValid()). Новое поле и поле с новым адресом
+ * попадают в изменения при ближайшем опросе.
+ */
+class WatchList
+{
+  public:
+    /**
+     * @brief Размер блока сравнения
+     */
+    static constexpr size_t BLOCK_SIZE = 32;
+
+    /**
+     * @brief Добавляет наблюдаемое поле
+     * @param address Адрес в целевом процессе
+     * @param size Размер поля в байтах
+     * @return Идентификатор поля
+     */
+    WatchId add(uintptr_t address, size_t size);
+
+    /**
+     * @brief Добавляет наблюдаемое поле типа T
+     */
+    template <typename T>
+    WatchId add(uintptr_t address)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "WatchList requires a trivially copyable type");
+        return add(address, sizeof(T));
+    }
+
+    /**
+     * @brief Удаляет поле; идентификатор может быть выдан повторно
+     * @return false если идентификатор недействителен
+     */
+    bool remove(WatchId id);
+
+    /**
+     * @brief Переносит поле на новый адрес (например, после смены указателя на структуру)
+     * @return false если идентификатор недействителен
+     */
+    bool setAddress(WatchId id, uintptr_t address);
+
+    /**
+     * @brief Удаляет все поля
+     */
+    void clear();
+
+    /**
+     * @brief Количество активных полей
+     */
+    size_t size() const { return m_watchCount; }
+
+    /**
+     * @brief Проверяет, что идентификатор выдан и не удалён
+     */
+    bool contains(WatchId id) const { return id < m_watches.size() && m_watches[id].active; }
+
+    /**
+     * @brief Читает все поля и возвращает изменившиеся с прошлого опроса
+     * @param memory Менеджер памяти процесса
+     * @return Идентификаторы изменившихся полей (действительны до следующего вызова, порядок не определён)
+     */
+    std::span<const WatchId> poll(MemoryManager& memory);
+
+    /**
+     * @brief Изменения последнего опроса
+     */
+    std::span<const WatchId> changes() const { return m_changes; }
+
+    /**
+     * @brief Последнее прочитанное значение поля (size байт)
+     */
+    const uint8_t* data(WatchId id) const { return m_current.data() + m_watches[id].offset; }
+
+    /**
+     * @brief Последнее прочитанное значение поля как T
+     */
+    template <typename T>
+    T value(WatchId id) const
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "WatchList requires a trivially copyable type");
+        T result{};
+        std::memcpy(&result, data(id), sizeof(T) < m_watches[id].size ? sizeof(T) : m_watches[id].size);
+        return result;
+    }
+
+    /**
+     * @brief Было ли поле прочитано в последнем опросе
+     */
+    bool isValid(WatchId id) const { return m_watches[id].valid; }
+
+    /**
+     * @brief Статистика
+     */
+    const WatchListStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Находит блоки по BLOCK_SIZE байт, в которых буферы различаются
+     * @param left Первый буфер
+     * @param right Второй буфер
+     * @param blockCount Количество блоков (размер буферов - blockCount * BLOCK_SIZE)
+     * @param blocks Индексы отличающихся блоков (дописываются в конец)
+     */
+    static void diffBlocks(const uint8_t* left, const uint8_t* right, size_t blockCount, std::vector<uint32_t>& blocks);
+
+  private:
+    /**
+     * @brief Наблюдаемое поле
+     */
+    struct Watch
+    {
+        uintptr_t address{0};      ///< Адрес в целевом процессе
+        uint64_t  reportedPoll{0}; ///< Номер опроса, в котором поле последний раз попало в изменения
+        uint32_t  size{0};         ///< Размер
+        uint32_t  offset{0};       ///< Смещение значения в буфере
+        bool      active{false};   ///< Поле не удалено
+        bool      valid{false};    ///< Последнее чтение успешно
+        bool      fresh{true};     ///< Поле новое или перенесено и ещё не было опрошено
+    };
+
+    /**
+     * @brief Перестраивает раскладку буферов после добавления/удаления полей
+     * @details Прошлые значения сохранившихся полей переносятся на новые смещения
+     */
+    void rebuildLayout();
+
+    std::vector<Watch>       m_watches;            ///< Поля по идентификаторам
+    std::vector<WatchId>     m_freeIds;            ///< Освобождённые идентификаторы
+    std::vector<WatchId>     m_order;              ///< Активные поля по возрастанию адреса (и смещения в буфере)
+    std::vector<uint32_t>    m_blockFirst;         ///< Первый элемент m_order, пересекающий блок
+    std::vector<ReadRequest> m_requests;           ///< Запросы чтения (параллельно m_order)
+    std::vector<uint8_t>     m_current;            ///< Значения последнего опроса
+    std::vector<uint8_t>     m_previous;           ///< Значения предыдущего опроса
+    std::vector<uint32_t>    m_changedBlocks;      ///< Отличившиеся блоки последнего опроса
+    std::vector<WatchId>     m_changes;            ///< Изменившиеся поля последнего опроса
+    WatchListStats           m_stats;              ///< Статистика
+    size_t                   m_watchCount{0};      ///< Количество активных полей
+    bool                     m_layoutDirty{false}; ///< Раскладка устарела
+};
@@ -0,0 +1,293 @@
+#include "WriteTransaction.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "MemoryManager.hpp"
+
+
+namespace
+{
+    constexpr uintptr_t PAGE_SIZE = 0x1000; ///< Гранулярность прав доступа
+
+    /**
+     * @brief Права с разрешённой записью, сохраняющие исполнение
+     */
+    DWORD writableProtection(DWORD protection)
+    {
+        constexpr DWORD executable = PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+        return (protection & executable) ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE;
+    }
+} // namespace
+
+
+bool WriteTransaction::write(uintptr_t address, const void* data, size_t size)
+{
+    if (m_committed)
+    {
+        m_error = "Transaction is already committed";
+        return false;
+    }
+    if (size == 0)
+    {
+        return true;
+    }
+    if (address + size < address)
+    {
+        m_error = "Write range overflows the address space";
+        return false;
+    }
+
+    const uintptr_t end = address + size;
+
+    // Диапазоны, пересекающиеся с записью или касающиеся её, сливаются в один
+    auto first = std::lower_bound(m_ranges.begin(),
+                                  m_ranges.end(),
+                                  address,
+                                  [](const Range& range, uintptr_t value) { return range.address + range.data.size() < value; });
+    auto last = first;
+    while (last != m_ranges.end() && last->address <= end)
+    {
+        ++last;
+    }
+
+    if (first == last)
+    {
+        Range range;
+        range.address = address;
+        range.data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        m_ranges.insert(first, std::move(range));
+        m_stats.bytes += size;
+    }
+    else
+    {
+        const uintptr_t mergedStart = std::min(address, first->address);
+        const uintptr_t mergedEnd   = std::max(end, std::prev(last)->address + std::prev(last)->data.size());
+
+        Range merged;
+        merged.address = mergedStart;
+        merged.data.resize(mergedEnd - mergedStart);
+        for (auto it = first; it != last; ++it)
+        {
+            std::memcpy(merged.data.data() + (it->address - mergedStart), it->data.data(), it->data.size());
+            m_stats.bytes -= it->data.size();
+        }
+        std::memcpy(merged.data.data() + (address - mergedStart), data, size);
+
+        m_stats.bytes += merged.data.size();
+        *first = std::move(merged);
+        m_ranges.erase(std::next(first), last);
+    }
+
+    m_captured = false;
+    m_stats.writes++;
+    m_stats.ranges = m_ranges.size();
+    return true;
+}
+
+bool WriteTransaction::writeString(uintptr_t address, std::string_view text)
+{
+    std::vector<char> bytes(text.begin(), text.end());
+    bytes.push_back('\0');
+    return write(address, bytes.data(), bytes.size());
+}
+
+bool WriteTransaction::capture(MemoryManager& memory)
+{
+    if (m_committed)
+    {
+        return true; // Исходные байты уже прочитаны перед записью
+    }
+
+    for (Range& range : m_ranges)
+    {
+        range.original.resize(range.data.size());
+        if (memory.TryReadMemory(range.address, range.original.data(), range.original.size()) != ReadError::None)
+        {
+            m_error = "Failed to read original bytes";
+            for (Range& clean : m_ranges)
+            {
+                clean.original.clear();
+            }
+            return false;
+        }
+    }
+
+    m_captured = true;
+    return true;
+}
+
+bool WriteTransaction::original(uintptr_t address, void* buffer, size_t size) const
+{
+    if (!m_captured)
+    {
+        return false;
+    }
+
+    for (const Range& range : m_ranges)
+    {
+        if (address >= range.address && address + size <= range.address + range.data.size())
+        {
+            std::memcpy(buffer, range.original.data() + (address - range.address), size);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WriteTransaction::commit(MemoryManager& memory)
+{
+    m_error.clear();
+    m_stats.writeCalls        = 0;
+    m_stats.protectionChanges = 0;
+
+    if (m_committed)
+    {
+        m_error = "Transaction is already committed";
+        return false;
+    }
+    if (m_ranges.empty())
+    {
+        return true;
+    }
+    if (!m_captured && !capture(memory))
+    {
+        return false;
+    }
+
+    std::vector<ProtectionSpan> spans;
+    if (!unprotect(memory, spans))
+    {
+        reprotect(memory, spans);
+        return false;
+    }
+
+    const size_t written = writeRanges(memory, false, m_ranges.size());
+    if (written != m_ranges.size())
+    {
+        // Частично применённый пакет возвращается к исходным байтам
+        m_error = "Failed to write memory";
+        writeRanges(memory, true, written);
+        reprotect(memory, spans);
+        return false;
+    }
+
+    if (!reprotect(memory, spans))
+    {
+        m_error = "Failed to restore memory protection";
+    }
+    m_committed = true;
+    return true;
+}
+
+bool WriteTransaction::rollback(MemoryManager& memory)
+{
+    m_error.clear();
+    m_stats.writeCalls        = 0;
+    m_stats.protectionChanges = 0;
+
+    if (!m_committed)
+    {
+        m_error = "Transaction is not committed";
+        return false;
+    }
+
+    std::vector<ProtectionSpan> spans;
+    if (!unprotect(memory, spans))
+    {
+        reprotect(memory, spans);
+        return false;
+    }
+
+    const bool restored = writeRanges(memory, true, m_ranges.size()) == m_ranges.size();
+    reprotect(memory, spans);
+    if (!restored)
+    {
+        m_error = "Failed to restore original bytes";
+        return false;
+    }
+
+    m_committed = false;
+    return true;
+}
+
+void WriteTransaction::clear()
+{
+    m_ranges.clear();
+    m_captured  = false;
+    m_committed = false;
+    m_stats     = WriteTransactionStats{};
+    m_error.clear();
+}
+
+bool WriteTransaction::unprotect(MemoryManager& memory, std::vector<ProtectionSpan>& spans)
+{
+    // Каждая страница проверяется один раз; соседние страницы с одинаковыми правами
+    // объединяются в участок с одной сменой прав
+    uintptr_t nextPage = 0;
+    for (const Range& range : m_ranges)
+    {
+        const uintptr_t end = range.address + range.data.size();
+        for (uintptr_t page = std::max(range.address & ~(PAGE_SIZE - 1), nextPage); page < end; page += PAGE_SIZE)
+        {
+            const DWORD protection = memory.GetMemoryProtection(page);
+            if (protection == 0)
+            {
+                m_error = "Write range is not mapped";
+                return false;
+            }
+            if (isWritableProtection(protection))
+            {
+                continue;
+            }
+
+            if (!spans.empty() && spans.back().address + spans.back().size == page &&
+                spans.back().protection == protection)
+            {
+                spans.back().size += PAGE_SIZE;
+            }
+            else
+            {
+                spans.push_back(ProtectionSpan{page, PAGE_SIZE, protection});
+            }
+        }
+        nextPage = (end + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    }
+
+    for (size_t i = 0; i < spans.size(); i++)
+    {
+        if (!memory.SetMemoryProtection(spans[i].address, spans[i].size, writableProtection(spans[i].protection)))
+        {
+            m_error = "Failed to change memory protection";
+            spans.resize(i); // Восстанавливать нужно только изменённые участки
+            return false;
+        }
+        m_stats.protectionChanges++;
+    }
+    return true;
+}
+
+bool WriteTransaction::reprotect(MemoryManager& memory, const std::vector<ProtectionSpan>& spans)
+{
+    bool result = true;
+    for (const ProtectionSpan& span : spans)
+    {
+        result &= memory.SetMemoryProtection(span.address, span.size, span.protection);
+    }
+    return result;
+}
+
+size_t WriteTransaction::writeRanges(MemoryManager& memory, bool original, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const Range& range = m_ranges[i];
+        const auto&  bytes = original ? range.original : range.data;
+        m_stats.writeCalls++;
+        if (!memory.WriteMemory(range.address, bytes.data(), bytes.size()))
+        {
+            return i;
+        }
+    }
+    return count;
+}
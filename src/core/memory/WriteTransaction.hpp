@@ -0,0 +1,184 @@
+/**
+ * @file WriteTransaction.hpp
+ * @brief Пакетная запись в память процесса с откатом
+ * @details Пример (несколько полей - одно согласованное изменение):
+ * @code
+ * WriteTransaction transaction;
+ * transaction.write<uint32_t>(unit + 0x48, targetLow);
+ * transaction.write<uint32_t>(unit + 0x4C, targetHigh);
+ * if (!transaction.commit(memory)) { ... transaction.error() ... }
+ * // ...
+ * transaction.rollback(memory); // исходные байты возвращаются
+ * @endcode
+ */
+#pragma once
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Platform.hpp"
+
+class MemoryManager;
+
+
+/**
+ * @brief Статистика WriteTransaction
+ */
+struct WriteTransactionStats
+{
+    size_t writes{0};            ///< Вызовы write() с последнего clear()
+    size_t ranges{0};            ///< Непрерывные диапазоны после слияния
+    size_t bytes{0};             ///< Байты в диапазонах
+    size_t writeCalls{0};        ///< Вызовы WriteMemory при последнем commit()/rollback()
+    size_t protectionChanges{0}; ///< Смены прав доступа при последнем commit()/rollback() (без восстановления)
+};
+
+/**
+ * @class WriteTransaction
+ * @brief Журнал записей: накопление, слияние, запись одним пакетом и откат
+ * @details write() только накапливает байты: пересекающиеся и соседние записи сливаются в
+ * непрерывные диапазоны (более поздняя запись перекрывает раннюю). commit() читает исходные
+ * байты всех диапазонов, снимает защиту один раз на каждый непрерывный участок страниц без
+ * права записи, пишет каждый диапазон одним вызовом WriteMemory и возвращает прежние права.
+ * Если запись обрывается на середине, уже записанные диапазоны возвращаются к исходным байтам,
+ * так что процесс не остаётся в промежуточном состоянии. rollback() после commit() возвращает
+ * исходные байты тем же способом. Диапазоны с промежутком между ними не объединяются: перезапись
+ * промежутка прочитанными ранее байтами могла бы затереть изменения, сделанные клиентом.
+ * Менеджер памяти не хранится, он передаётся в commit()/rollback().
+ */
+class WriteTransaction
+{
+  public:
+    /**
+     * @brief Добавляет запись
+     * @param address Адрес в целевом процессе
+     * @param data Байты
+     * @param size Размер
+     * @return false после commit() (до rollback()/clear()) или при переполнении адреса
+     */
+    bool write(uintptr_t address, const void* data, size_t size);
+
+    /**
+     * @brief Добавляет запись значения типа T
+     */
+    template <typename T>
+    bool write(uintptr_t address, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "WriteTransaction requires a trivially copyable type");
+        return write(address, &value, sizeof(T));
+    }
+
+    /**
+     * @brief Добавляет запись массива
+     */
+    template <typename T>
+    bool writeArray(uintptr_t address, std::span<const T> values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "WriteTransaction requires a trivially copyable type");
+        return write(address, values.data(), values.size_bytes());
+    }
+
+    /**
+     * @brief Добавляет запись строки с нуль-терминатором
+     */
+    bool writeString(uintptr_t address, std::string_view text);
+
+    /**
+     * @brief Читает исходные байты накопленных диапазонов заранее (например, для трамплина)
+     * @details commit() делает это сам, если capture() не вызывался
+     * @return false если какой-либо диапазон не прочитан
+     */
+    bool capture(MemoryManager& memory);
+
+    /**
+     * @brief Копирует исходные байты участка, попадающего в накопленные диапазоны
+     * @return false если участок не покрыт одним диапазоном или исходные байты ещё не прочитаны
+     */
+    bool original(uintptr_t address, void* buffer, size_t size) const;
+
+    /**
+     * @brief Записывает все накопленные диапазоны
+     * @return false при ошибке; память остаётся в исходном состоянии (см. error())
+     */
+    bool commit(MemoryManager& memory);
+
+    /**
+     * @brief Возвращает исходные байты после commit()
+     * @return false если commit() не выполнялся или запись не удалась
+     */
+    bool rollback(MemoryManager& memory);
+
+    /**
+     * @brief Удаляет накопленные записи (без отката)
+     */
+    void clear();
+
+    /**
+     * @brief Нет накопленных записей
+     */
+    bool empty() const { return m_ranges.empty(); }
+
+    /**
+     * @brief Записи применены (commit() без последующего rollback())
+     */
+    bool isCommitted() const { return m_committed; }
+
+    /**
+     * @brief Статистика
+     */
+    const WriteTransactionStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Описание последней ошибки
+     */
+    const std::string& error() const { return m_error; }
+
+  private:
+    /**
+     * @brief Непрерывный диапазон записи
+     */
+    struct Range
+    {
+        uintptr_t            address{0}; ///< Начало
+        std::vector<uint8_t> data;       ///< Новые байты
+        std::vector<uint8_t> original;   ///< Исходные байты (пусто до capture())
+    };
+
+    /**
+     * @brief Участок страниц, права которого меняются на время записи
+     */
+    struct ProtectionSpan
+    {
+        uintptr_t address{0};    ///< Начало (граница страницы)
+        size_t    size{0};       ///< Размер (кратен странице)
+        DWORD     protection{0}; ///< Исходные права
+    };
+
+    /**
+     * @brief Снимает защиту от записи со страниц диапазонов
+     * @param spans Изменённые участки (для последующего восстановления)
+     */
+    bool unprotect(MemoryManager& memory, std::vector<ProtectionSpan>& spans);
+
+    /**
+     * @brief Возвращает исходные права участков
+     */
+    bool reprotect(MemoryManager& memory, const std::vector<ProtectionSpan>& spans);
+
+    /**
+     * @brief Пишет новые или исходные байты диапазонов [0, count)
+     * @return Количество записанных диапазонов
+     */
+    size_t writeRanges(MemoryManager& memory, bool original, size_t count);
+
+    std::vector<Range>    m_ranges;           ///< Диапазоны по возрастанию адресов, без пересечений и касаний
+    bool                  m_captured{false};  ///< Исходные байты прочитаны
+    bool                  m_committed{false}; ///< Записи применены
+    WriteTransactionStats m_stats;            ///< Статистика
+    std::string           m_error;            ///< Последняя ошибка
+};
@@ -0,0 +1,248 @@
+#include "DumpFileBackend.hpp"
+
+#include <iterator>
+
+#include <QByteArray>
+#include <QFile>
+
+
+using namespace dump_format;
+
+DumpFileBackend::DumpFileBackend(const std::string& filePath)
+    : m_file(std::make_unique<QFile>(QString::fromStdString(filePath)))
+{
+    if (!m_file->open(QIODevice::ReadOnly))
+    {
+        m_error = "Cannot open dump file " + filePath;
+        SetLastError(ERROR_FILE_NOT_FOUND);
+        return;
+    }
+
+    m_mappingSize = static_cast<uint64_t>(m_file->size());
+    m_mapping     = m_file->map(0, m_file->size());
+    if (!m_mapping)
+    {
+        m_error = "Cannot map dump file " + filePath;
+        SetLastError(ERROR_ACCESS_DENIED);
+        return;
+    }
+
+    m_open = parse();
+    if (!m_open)
+    {
+        SetLastError(ERROR_INVALID_PARAMETER);
+        m_regions.clear();
+        m_blocks.clear();
+        m_modules.clear();
+    }
+}
+
+DumpFileBackend::~DumpFileBackend()                                     = default;
+DumpFileBackend::DumpFileBackend(DumpFileBackend&&) noexcept            = default;
+DumpFileBackend& DumpFileBackend::operator=(DumpFileBackend&&) noexcept = default;
+
+bool DumpFileBackend::parse()
+{
+    uint64_t position = 0;
+    auto     take     = [this, &position](void* destination, uint64_t size)
+    {
+        if (m_mappingSize - position < size)
+        {
+            return false;
+        }
+        std::memcpy(destination, m_mapping + position, size);
+        position += size;
+        return true;
+    };
+
+    DumpHeader header;
+    if (!take(&header, sizeof(header)) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        m_error = "Not a dump file";
+        return false;
+    }
+    if (header.version != VERSION)
+    {
+        m_error = "Unsupported dump version " + std::to_string(header.version);
+        return false;
+    }
+    if (header.blockSize == 0 || header.blockSize % DATA_ALIGNMENT != 0)
+    {
+        m_error = "Invalid block size";
+        return false;
+    }
+    m_processId = header.processId;
+    m_blockSize = header.blockSize;
+
+    std::vector<DumpRegionRecord> records(header.regionCount);
+    m_blocks.resize(header.blockCount);
+    if (!take(records.data(), records.size() * sizeof(DumpRegionRecord))
+        || !take(m_blocks.data(), m_blocks.size() * sizeof(DumpBlockRecord)))
+    {
+        m_error = "Truncated region or block table";
+        return false;
+    }
+
+    for (const auto& record : records)
+    {
+        const uint64_t blocks = blockCountFor(record.size, m_blockSize);
+        if (record.size == 0 || record.base + record.size < record.base || record.firstBlock > m_blocks.size()
+            || m_blocks.size() - record.firstBlock < blocks)
+        {
+            m_error = "Invalid region record";
+            return false;
+        }
+
+        m_regions.push_back(Region{MemoryRegion{static_cast<uintptr_t>(record.base),
+                                                static_cast<size_t>(record.size),
+                                                record.protection,
+                                                MEM_COMMIT,
+                                                record.type},
+                                   record.firstBlock});
+    }
+
+    for (const auto& block : m_blocks)
+    {
+        if (block.fileOffset > m_mappingSize || m_mappingSize - block.fileOffset < block.storedSize)
+        {
+            m_error = "Block data out of file bounds";
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < header.moduleCount; i++)
+    {
+        DumpModuleRecord record;
+        if (!take(&record, sizeof(record)))
+        {
+            m_error = "Truncated module table";
+            return false;
+        }
+
+        std::vector<char16_t> name(record.nameLength);
+        if (!take(name.data(), name.size() * sizeof(char16_t)))
+        {
+            m_error = "Truncated module name";
+            return false;
+        }
+        m_modules.push_back(ModuleInfo{std::wstring(name.begin(), name.end()),
+                                       static_cast<uintptr_t>(record.base),
+                                       static_cast<size_t>(record.size)});
+    }
+
+    std::sort(m_regions.begin(),
+              m_regions.end(),
+              [](const Region& left, const Region& right) { return left.info.base < right.info.base; });
+    for (size_t i = 1; i < m_regions.size(); i++)
+    {
+        if (m_regions[i - 1].info.end() > m_regions[i].info.base)
+        {
+            m_error = "Overlapping regions in dump";
+            return false;
+        }
+    }
+
+    m_decompressed = std::make_unique<DecompressedBlock[]>(m_blocks.size());
+    return true;
+}
+
+const DumpFileBackend::Region* DumpFileBackend::find(uintptr_t address) const
+{
+    auto it = std::upper_bound(m_regions.begin(),
+                               m_regions.end(),
+                               address,
+                               [](uintptr_t value, const Region& region) { return value < region.info.base; });
+    if (it == m_regions.begin())
+    {
+        return nullptr;
+    }
+    --it;
+    return it->info.contains(address) ? &*it : nullptr;
+}
+
+const uint8_t* DumpFileBackend::blockData(uint32_t index, size_t length) const
+{
+    const DumpBlockRecord& block = m_blocks[index];
+    if (!(block.flags & BLOCK_COMPRESSED))
+    {
+        return block.storedSize == length ? m_mapping + block.fileOffset : nullptr;
+    }
+
+    DecompressedBlock& decompressed = m_decompressed[index];
+    std::call_once(decompressed.once,
+                   [&]
+                   {
+                       const QByteArray data = qUncompress(m_mapping + block.fileOffset, block.storedSize);
+                       if (static_cast<size_t>(data.size()) == length)
+                       {
+                           decompressed.data.assign(data.begin(), data.end());
+                       }
+                   });
+    return decompressed.data.empty() ? nullptr : decompressed.data.data();
+}
+
+const uint8_t* DumpFileBackend::locate(uintptr_t address, size_t& available) const
+{
+    const Region* region = find(address);
+    if (!region)
+    {
+        return nullptr;
+    }
+
+    const size_t   inRegion    = address - region->info.base;
+    const uint32_t blockIndex  = region->firstBlock + static_cast<uint32_t>(inRegion / m_blockSize);
+    const size_t   inBlock     = inRegion % m_blockSize;
+    const size_t   blockLength = std::min<size_t>(m_blockSize, region->info.size - (inRegion - inBlock));
+
+    const uint8_t* data = blockData(blockIndex, blockLength);
+    if (!data)
+    {
+        return nullptr;
+    }
+
+    available = blockLength - inBlock;
+    return data + inBlock;
+}
+
+bool DumpFileBackend::query(uintptr_t address, MemoryRegion& region) const
+{
+    if (const Region* found = find(address))
+    {
+        region = found->info;
+        return true;
+    }
+
+    // Между регионами снимка - свободная память
+    auto next = std::upper_bound(m_regions.begin(),
+                                 m_regions.end(),
+                                 address,
+                                 [](uintptr_t value, const Region& r) { return value < r.info.base; });
+    const uintptr_t freeStart = next == m_regions.begin() ? 0 : std::prev(next)->info.end();
+    const uintptr_t freeEnd   = next == m_regions.end() ? UINTPTR_MAX : next->info.base;
+    region                    = MemoryRegion{freeStart, freeEnd - freeStart, PAGE_NOACCESS, MEM_FREE, 0};
+    return true;
+}
+
+bool DumpFileBackend::protect(uintptr_t, size_t, DWORD, DWORD&)
+{
+    SetLastError(ERROR_ACCESS_DENIED);
+    return false;
+}
+
+uintptr_t DumpFileBackend::allocate(uintptr_t, size_t, DWORD)
+{
+    SetLastError(ERROR_ACCESS_DENIED);
+    return 0;
+}
+
+bool DumpFileBackend::release(uintptr_t)
+{
+    SetLastError(ERROR_ACCESS_DENIED);
+    return false;
+}
+
+bool DumpFileBackend::enumerateModules(std::vector<ModuleInfo>& modules) const
+{
+    modules.insert(modules.end(), m_modules.begin(), m_modules.end());
+    return true;
+}
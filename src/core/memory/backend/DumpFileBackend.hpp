@@ -0,0 +1,157 @@
+/**
+ * @file DumpFileBackend.hpp
+ * @brief Бэкенд поверх снимка памяти процесса (только чтение)
+ */
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "core/memory/MemoryRegion.hpp"
+#include "core/memory/Platform.hpp"
+#include "core/memory/snapshot/DumpFormat.hpp"
+
+class QFile;
+
+
+/**
+ * @class DumpFileBackend
+ * @brief Только читаемый "процесс", восстановленный из снимка (см. DumpFormat.hpp)
+ * @details Файл отображается в память целиком (QFile::map), при открытии разбираются только
+ * таблицы регионов, блоков и модулей, поэтому открытие снимка любого размера занимает
+ * миллисекунды. Несжатые блоки читаются прямо из отображения, view() отдаёт на них
+ * указатель без копирования. Сжатые блоки распаковываются один раз при первом обращении.
+ * Запись, выделение памяти и смена прав доступа возвращают ERROR_ACCESS_DENIED.
+ * Чтение потокобезопасно.
+ */
+class DumpFileBackend
+{
+  public:
+    /**
+     * @brief Открывает снимок
+     * @param filePath Путь к файлу снимка
+     * @details При ошибке isOpen() возвращает false, а error() содержит описание
+     */
+    explicit DumpFileBackend(const std::string& filePath);
+    ~DumpFileBackend();
+
+    DumpFileBackend(DumpFileBackend&&) noexcept;
+    DumpFileBackend& operator=(DumpFileBackend&&) noexcept;
+
+    bool               isOpen() const { return m_open; }
+    DWORD              processId() const { return m_processId; }
+    const std::string& error() const { return m_error; }
+
+    /**
+     * @brief Читает данные из регионов снимка
+     */
+    bool read(uintptr_t address, void* buffer, size_t size) const
+    {
+        auto*  out    = static_cast<uint8_t*>(buffer);
+        size_t offset = 0;
+        while (offset < size)
+        {
+            size_t         available = 0;
+            const uint8_t* data      = locate(address + offset, available);
+            if (!data)
+            {
+                SetLastError(ERROR_PARTIAL_COPY);
+                return false;
+            }
+
+            const size_t chunk = std::min(size - offset, available);
+            std::memcpy(out + offset, data, chunk);
+            offset += chunk;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Указатель на данные снимка без копирования
+     * @return Указатель на size байт по адресу или nullptr, если диапазон пересекает
+     * границу блока или не содержится в снимке
+     */
+    const uint8_t* view(uintptr_t address, size_t size) const
+    {
+        size_t         available = 0;
+        const uint8_t* data      = locate(address, available);
+        return data && available >= size ? data : nullptr;
+    }
+
+    /**
+     * @brief Запись в снимок невозможна
+     */
+    bool write(uintptr_t, const void*, size_t)
+    {
+        SetLastError(ERROR_ACCESS_DENIED);
+        return false;
+    }
+
+    bool      query(uintptr_t address, MemoryRegion& region) const;
+    bool      protect(uintptr_t address, size_t size, DWORD protection, DWORD& oldProtection);
+    uintptr_t allocate(uintptr_t address, size_t size, DWORD protection);
+    bool      release(uintptr_t address);
+    bool      enumerateModules(std::vector<ModuleInfo>& modules) const;
+
+  private:
+    /**
+     * @brief Регион снимка и его первый блок
+     */
+    struct Region
+    {
+        MemoryRegion info;          ///< Описание региона
+        uint32_t     firstBlock{0}; ///< Индекс первого блока в m_blocks
+    };
+
+    /**
+     * @brief Распакованный блок
+     */
+    struct DecompressedBlock
+    {
+        std::once_flag       once; ///< Распаковка выполняется один раз
+        std::vector<uint8_t> data; ///< Данные (пусто при ошибке распаковки)
+    };
+
+    /**
+     * @brief Находит данные по адресу
+     * @param address Адрес в процессе
+     * @param available Сюда записывается количество байт до конца блока
+     * @return Указатель на данные или nullptr
+     */
+    const uint8_t* locate(uintptr_t address, size_t& available) const;
+
+    /**
+     * @brief Находит регион, содержащий адрес (бинарный поиск)
+     */
+    const Region* find(uintptr_t address) const;
+
+    /**
+     * @brief Возвращает данные блока, распаковывая при необходимости
+     * @param index Индекс блока
+     * @param length Ожидаемый размер несжатых данных блока
+     */
+    const uint8_t* blockData(uint32_t index, size_t length) const;
+
+    /**
+     * @brief Разбирает заголовок и таблицы снимка
+     */
+    bool parse();
+
+    std::unique_ptr<QFile>                    m_file;             ///< Открытый файл снимка
+    const uint8_t*                            m_mapping{nullptr}; ///< Отображение файла
+    uint64_t                                  m_mappingSize{0};   ///< Размер отображения
+    uint32_t                                  m_blockSize{0};     ///< Размер несжатого блока
+    std::vector<Region>                       m_regions;          ///< Регионы по возрастанию адреса
+    std::vector<dump_format::DumpBlockRecord> m_blocks;           ///< Таблица блоков
+    std::unique_ptr<DecompressedBlock[]>      m_decompressed;     ///< Распакованные сжатые блоки
+    std::vector<ModuleInfo>                   m_modules;          ///< Модули
+    DWORD                                     m_processId{0};     ///< PID процесса на момент снятия
+    bool                                      m_open{false};      ///< Снимок успешно открыт
+    std::string                               m_error;            ///< Описание ошибки открытия
+};
@@ -0,0 +1,152 @@
+#include "InProcessBackend.hpp"
+
+
+bool InProcessBackend::addRegion(const void* data, size_t size, DWORD protection, DWORD type)
+{
+    return addRegionAt(reinterpret_cast<uintptr_t>(data), data, size, protection, type);
+}
+
+bool InProcessBackend::addRegionAt(uintptr_t base, const void* data, size_t size, DWORD protection, DWORD type)
+{
+    if (size == 0)
+    {
+        return false;
+    }
+
+    // Новый регион не должен пересекаться ни с предыдущим, ни со следующим
+    auto next = m_regions.lower_bound(base);
+    if (next != m_regions.end() && next->first < base + size)
+    {
+        return false;
+    }
+    if (next != m_regions.begin() && std::prev(next)->second.region.end() > base)
+    {
+        return false;
+    }
+
+    const MemoryRegion region{base, size, protection, MEM_COMMIT, type};
+    m_regions.emplace(base, Mapping{region, reinterpret_cast<uintptr_t>(data)});
+    return true;
+}
+
+void InProcessBackend::addModule(const std::wstring& name, const void* base, size_t size)
+{
+    addModuleAt(name, reinterpret_cast<uintptr_t>(base), size);
+}
+
+void InProcessBackend::addModuleAt(const std::wstring& name, uintptr_t base, size_t size)
+{
+    m_modules.push_back(ModuleInfo{name, base, size});
+}
+
+bool InProcessBackend::query(uintptr_t address, MemoryRegion& region) const
+{
+    auto      next      = m_regions.upper_bound(address);
+    uintptr_t freeStart = 0;
+    if (next != m_regions.begin())
+    {
+        const MemoryRegion& previous = std::prev(next)->second.region;
+        if (previous.contains(address))
+        {
+            region = previous;
+            return true;
+        }
+        freeStart = previous.end();
+    }
+
+    // Адрес между регионами - свободная память до следующего региона
+    const uintptr_t freeEnd = next != m_regions.end() ? next->first : UINTPTR_MAX;
+    region                  = MemoryRegion{freeStart, freeEnd - freeStart, PAGE_NOACCESS, MEM_FREE, 0};
+    return true;
+}
+
+bool InProcessBackend::protect(uintptr_t address, size_t size, DWORD protection, DWORD& oldProtection)
+{
+    const uintptr_t end = address + size;
+
+    // Диапазон должен быть полностью покрыт регионами
+    for (uintptr_t current = address; current < end;)
+    {
+        auto it = m_regions.upper_bound(current);
+        if (it == m_regions.begin() || !std::prev(it)->second.region.contains(current))
+        {
+            SetLastError(ERROR_INVALID_ADDRESS);
+            return false;
+        }
+        current = std::prev(it)->second.region.end();
+    }
+
+    oldProtection = std::prev(m_regions.upper_bound(address))->second.region.protection;
+
+    // Разрезаем регионы по границам диапазона, как это делает VirtualProtect
+    for (uintptr_t current = address; current < end;)
+    {
+        const Mapping       mapping = std::prev(m_regions.upper_bound(current))->second;
+        const MemoryRegion& region  = mapping.region;
+        m_regions.erase(region.base);
+
+        // Части региона сохраняют отображение на тот же буфер
+        const auto part = [&](uintptr_t from, uintptr_t to, DWORD partProtection)
+        {
+            const MemoryRegion piece{from, to - from, partProtection, region.state, region.type};
+            m_regions.emplace(from, Mapping{piece, mapping.host + (from - region.base)});
+        };
+
+        if (region.base < address)
+        {
+            part(region.base, address, region.protection);
+        }
+
+        const uintptr_t partStart = std::max(region.base, address);
+        const uintptr_t partEnd   = std::min(region.end(), end);
+        part(partStart, partEnd, protection);
+
+        if (region.end() > end)
+        {
+            part(end, region.end(), region.protection);
+        }
+        current = partEnd;
+    }
+    return true;
+}
+
+uintptr_t InProcessBackend::allocate(uintptr_t address, size_t size, DWORD protection)
+{
+    constexpr size_t PAGE = 0x1000;
+
+    // Размещение по заданному адресу в собственном процессе не поддерживается
+    if (address != 0 || size == 0)
+    {
+        SetLastError(ERROR_INVALID_ADDRESS);
+        return 0;
+    }
+
+    const size_t alignedSize = (size + PAGE - 1) & ~(PAGE - 1);
+    Allocation   allocation{std::make_unique<uint8_t[]>(alignedSize + PAGE - 1), alignedSize};
+    const auto   base = (reinterpret_cast<uintptr_t>(allocation.storage.get()) + PAGE - 1) & ~(uintptr_t(PAGE) - 1);
+
+    addRegion(reinterpret_cast<const void*>(base), alignedSize, protection, MEM_PRIVATE);
+    m_allocations.emplace(base, std::move(allocation));
+    return base;
+}
+
+bool InProcessBackend::release(uintptr_t address)
+{
+    auto it = m_allocations.find(address);
+    if (it == m_allocations.end())
+    {
+        SetLastError(ERROR_INVALID_ADDRESS);
+        return false;
+    }
+
+    // protect() мог разрезать выделение на несколько регионов
+    m_regions.erase(m_regions.lower_bound(address), m_regions.lower_bound(address + it->second.size));
+    m_allocations.erase(it);
+    return true;
+}
+
+bool InProcessBackend::enumerateModules(std::vector<ModuleInfo>& modules) const
+{
+    modules.insert(modules.end(), m_modules.begin(), m_modules.end());
+    return true;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file InProcessBackend.hpp
+ * @brief Бэкенд поверх памяти собственного процесса
+ */
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "core/memory/MemoryRegion.hpp"
+#include "core/memory/Platform.hpp"
+
+
+/**
+ * @class InProcessBackend
+ * @brief "Процесс" из зарегистрированных буферов текущего процесса
+ * @details Адреса - обычные указатели текущего процесса, но доступны только зарегистрированные
+ * через addRegion() диапазоны: чтение вне них завершается ошибкой, а не падением. Буфер можно
+ * зарегистрировать и по другому адресу (addRegionAt), чтобы воспроизвести раскладку 32-битного
+ * клиента со статическими адресами при любой разрядности утилиты.
+ * Это позволяет собрать из обычных буферов модель процесса (регионы, модули, права
+ * доступа) и прогонять на ней сканеры, кэши и нагрузочные тесты без целевой игры.
+ * allocate() выделяет выровненные по странице буферы, protect() меняет учётные права.
+ * Чтение потокобезопасно, пока набор регионов не меняется.
+ */
+class InProcessBackend
+{
+  public:
+    InProcessBackend() = default;
+
+    InProcessBackend(const InProcessBackend&)            = delete;
+    InProcessBackend& operator=(const InProcessBackend&) = delete;
+    InProcessBackend(InProcessBackend&&) noexcept            = default;
+    InProcessBackend& operator=(InProcessBackend&&) noexcept = default;
+
+    bool  isOpen() const { return true; }
+    DWORD processId() const { return 0; }
+
+    /**
+     * @brief Регистрирует буфер как регион памяти
+     * @param data Начало буфера (буфер должен жить дольше бэкенда)
+     * @param size Размер буфера
+     * @param protection Права доступа (PAGE_*)
+     * @param type Тип региона (MEM_PRIVATE, MEM_IMAGE)
+     * @return false если диапазон пересекается с уже зарегистрированным
+     */
+    bool addRegion(const void* data, size_t size, DWORD protection = PAGE_READWRITE, DWORD type = MEM_PRIVATE);
+
+    /**
+     * @brief Регистрирует буфер как регион памяти по заданному адресу
+     * @param address Адрес региона в модели процесса
+     * @param data Начало буфера (буфер должен жить дольше бэкенда)
+     * @param size Размер буфера
+     * @param protection Права доступа (PAGE_*)
+     * @param type Тип региона (MEM_PRIVATE, MEM_IMAGE)
+     * @return false если диапазон пересекается с уже зарегистрированным
+     */
+    bool addRegionAt(uintptr_t   address,
+                     const void* data,
+                     size_t      size,
+                     DWORD       protection = PAGE_READWRITE,
+                     DWORD       type       = MEM_PRIVATE);
+
+    /**
+     * @brief Регистрирует модуль (регионы образа добавляются отдельно через addRegion)
+     */
+    void addModule(const std::wstring& name, const void* base, size_t size);
+
+    /**
+     * @brief Регистрирует модуль по адресу модели процесса (регионы - через addRegionAt)
+     */
+    void addModuleAt(const std::wstring& name, uintptr_t base, size_t size);
+
+    /**
+     * @brief Читает данные из зарегистрированных регионов
+     */
+    bool read(uintptr_t address, void* buffer, size_t size) const
+    {
+        auto* out = static_cast<uint8_t*>(buffer);
+        return copy(address,
+                    size,
+                    false,
+                    [out](uintptr_t source, size_t offset, size_t length)
+                    { std::memcpy(out + offset, reinterpret_cast<const void*>(source), length); });
+    }
+
+    /**
+     * @brief Записывает данные в зарегистрированные регионы с правами на запись
+     */
+    bool write(uintptr_t address, const void* buffer, size_t size)
+    {
+        const auto* in = static_cast<const uint8_t*>(buffer);
+        return copy(address,
+                    size,
+                    true,
+                    [in](uintptr_t destination, size_t offset, size_t length)
+                    { std::memcpy(reinterpret_cast<void*>(destination), in + offset, length); });
+    }
+
+    bool      query(uintptr_t address, MemoryRegion& region) const;
+    bool      protect(uintptr_t address, size_t size, DWORD protection, DWORD& oldProtection);
+    uintptr_t allocate(uintptr_t address, size_t size, DWORD protection);
+    bool      release(uintptr_t address);
+    bool      enumerateModules(std::vector<ModuleInfo>& modules) const;
+
+  private:
+    /**
+     * @brief Проходит по регионам, покрывающим [address, address + size), и копирует данные
+     * @tparam Copy void(uintptr_t hostAddress, size_t offset, size_t length)
+     * @details Диапазон должен быть непрерывно покрыт регионами с нужными правами, иначе
+     * ничего не копируется и выставляется ERROR_PARTIAL_COPY
+     */
+    template <typename Copy>
+    bool copy(uintptr_t address, size_t size, bool forWrite, Copy&& onCopy) const
+    {
+        // Сначала проверяем весь диапазон, чтобы не оставлять частично скопированных данных
+        uintptr_t current = address;
+        size_t    left    = size;
+        while (left > 0)
+        {
+            auto it = m_regions.upper_bound(current);
+            if (it == m_regions.begin())
+            {
+                SetLastError(ERROR_PARTIAL_COPY);
+                return false;
+            }
+            --it;
+
+            const MemoryRegion& region  = it->second.region;
+            const bool          allowed = forWrite ? isWritableProtection(region.protection)
+                                                   : isReadableProtection(region.protection);
+            if (!region.contains(current) || !allowed)
+            {
+                SetLastError(ERROR_PARTIAL_COPY);
+                return false;
+            }
+
+            const size_t chunk = std::min<size_t>(left, region.end() - current);
+            current += chunk;
+            left -= chunk;
+        }
+
+        for (size_t offset = 0; offset < size;)
+        {
+            const uintptr_t target  = address + offset;
+            const Mapping&  mapping = std::prev(m_regions.upper_bound(target))->second;
+            const size_t    chunk   = std::min<size_t>(size - offset, mapping.region.end() - target);
+            onCopy(mapping.host + (target - mapping.region.base), offset, chunk);
+            offset += chunk;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Регион и адрес его начала в памяти текущего процесса
+     */
+    struct Mapping
+    {
+        MemoryRegion region;  ///< Регион в модели процесса
+        uintptr_t    host{0}; ///< Адрес буфера, на который отображено начало региона
+    };
+
+    /**
+     * @brief Буфер, выделенный allocate()
+     */
+    struct Allocation
+    {
+        std::unique_ptr<uint8_t[]> storage; ///< Память с запасом на выравнивание
+        size_t                     size{0}; ///< Размер выровненной части
+    };
+
+    std::map<uintptr_t, Mapping>    m_regions;     ///< Регионы по базовому адресу
+    std::map<uintptr_t, Allocation> m_allocations; ///< Буферы allocate() по выровненному адресу
+    std::vector<ModuleInfo>         m_modules;     ///< Зарегистрированные модули
+};
@@ -0,0 +1,175 @@
+#include "LinuxBackend.hpp"
+
+#ifdef __linux__
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <signal.h>
+
+
+LinuxBackend::LinuxBackend(DWORD processId) : m_processId(processId)
+{
+    m_open = kill(static_cast<pid_t>(processId), 0) == 0 || errno == EPERM;
+    if (!m_open)
+    {
+        SetLastError(ERROR_INVALID_PARAMETER);
+    }
+}
+
+bool LinuxBackend::readMappings(std::vector<Mapping>& mappings) const
+{
+    std::ifstream maps("/proc/" + std::to_string(m_processId) + "/maps");
+    if (!maps)
+    {
+        SetLastError(ERROR_ACCESS_DENIED);
+        return false;
+    }
+
+    // Формат строки: "start-end perms offset dev inode [path]"
+    std::string line;
+    while (std::getline(maps, line))
+    {
+        std::istringstream stream(line);
+        std::string        range, perms, offset, device, inode;
+        if (!(stream >> range >> perms >> offset >> device >> inode))
+        {
+            continue;
+        }
+
+        const size_t dash = range.find('-');
+        if (dash == std::string::npos || perms.size() < 3)
+        {
+            continue;
+        }
+
+        Mapping mapping;
+        mapping.start = static_cast<uintptr_t>(std::stoull(range.substr(0, dash), nullptr, 16));
+        mapping.end   = static_cast<uintptr_t>(std::stoull(range.substr(dash + 1), nullptr, 16));
+
+        const bool readable   = perms[0] == 'r';
+        const bool writable   = perms[1] == 'w';
+        const bool executable = perms[2] == 'x';
+        if (executable)
+        {
+            mapping.protection = writable ? PAGE_EXECUTE_READWRITE : (readable ? PAGE_EXECUTE_READ : PAGE_EXECUTE);
+        }
+        else if (readable)
+        {
+            mapping.protection = writable ? PAGE_READWRITE : PAGE_READONLY;
+        }
+        else
+        {
+            mapping.protection = PAGE_NOACCESS;
+        }
+
+        std::getline(stream >> std::ws, mapping.path);
+        mappings.push_back(std::move(mapping));
+    }
+    return true;
+}
+
+bool LinuxBackend::query(uintptr_t address, MemoryRegion& region) const
+{
+    std::vector<Mapping> mappings;
+    if (!readMappings(mappings))
+    {
+        return false;
+    }
+
+    // Отображения в maps упорядочены по адресу; промежуток перед первым подходящим - свободный регион
+    uintptr_t freeStart = 0;
+    for (const auto& mapping : mappings)
+    {
+        if (address < mapping.start)
+        {
+            region = MemoryRegion{freeStart, mapping.start - freeStart, PAGE_NOACCESS, MEM_FREE, 0};
+            return true;
+        }
+        if (address < mapping.end)
+        {
+            region = toRegion(mapping);
+            return true;
+        }
+        freeStart = mapping.end;
+    }
+
+    region = MemoryRegion{freeStart, UINTPTR_MAX - freeStart, PAGE_NOACCESS, MEM_FREE, 0};
+    return true;
+}
+
+bool LinuxBackend::enumerateRegions(uintptr_t start, uintptr_t end, std::vector<MemoryRegion>& regions) const
+{
+    std::vector<Mapping> mappings;
+    if (!readMappings(mappings))
+    {
+        return false;
+    }
+
+    for (const auto& mapping : mappings)
+    {
+        if (mapping.end > start && mapping.start < end)
+        {
+            regions.push_back(toRegion(mapping));
+        }
+    }
+    return true;
+}
+
+MemoryRegion LinuxBackend::toRegion(const Mapping& mapping)
+{
+    const bool file = !mapping.path.empty() && mapping.path.front() == '/';
+    return MemoryRegion{
+        mapping.start, mapping.end - mapping.start, mapping.protection, MEM_COMMIT, file ? MEM_IMAGE : MEM_PRIVATE};
+}
+
+bool LinuxBackend::protect(uintptr_t, size_t, DWORD, DWORD&)
+{
+    SetLastError(ERROR_NOT_SUPPORTED);
+    return false;
+}
+
+uintptr_t LinuxBackend::allocate(uintptr_t, size_t, DWORD)
+{
+    SetLastError(ERROR_NOT_SUPPORTED);
+    return 0;
+}
+
+bool LinuxBackend::release(uintptr_t)
+{
+    SetLastError(ERROR_NOT_SUPPORTED);
+    return false;
+}
+
+bool LinuxBackend::enumerateModules(std::vector<ModuleInfo>& modules) const
+{
+    std::vector<Mapping> mappings;
+    if (!readMappings(mappings))
+    {
+        return false;
+    }
+
+    // Модуль - все отображения одного файла: от первого до последнего
+    for (const auto& mapping : mappings)
+    {
+        if (mapping.path.empty() || mapping.path.front() != '/')
+        {
+            continue;
+        }
+
+        const std::string  fileName = mapping.path.substr(mapping.path.find_last_of('/') + 1);
+        const std::wstring name(fileName.begin(), fileName.end());
+
+        auto it = std::find_if(modules.begin(), modules.end(), [&name](const ModuleInfo& m) { return m.name == name; });
+        if (it == modules.end())
+        {
+            modules.push_back(ModuleInfo{name, mapping.start, mapping.end - mapping.start});
+        }
+        else
+        {
+            it->size = std::max<size_t>(it->size, mapping.end - it->base);
+        }
+    }
+    return true;
+}
+#endif
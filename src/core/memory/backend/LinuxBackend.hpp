@@ -0,0 +1,131 @@
+/**
+ * @file LinuxBackend.hpp
+ * @brief Доступ к памяти другого процесса в Linux (process_vm_readv + /proc/<pid>/maps)
+ * @details Позволяет запускать движок памяти на Linux, в том числе против клиента под Wine:
+ * образ run.exe виден в /proc/<pid>/maps как обычное файловое отображение.
+ */
+#pragma once
+#ifdef __linux__
+#include <string>
+#include <vector>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "core/memory/MemoryRegion.hpp"
+#include "core/memory/Platform.hpp"
+
+
+/**
+ * @class LinuxBackend
+ * @brief Бэкенд поверх process_vm_readv/process_vm_writev
+ * @details Карта регионов читается из /proc/<pid>/maps, промежутки между отображениями
+ * возвращаются как MEM_FREE. Права доступа переводятся во флаги PAGE_*. Выделение памяти
+ * и смена прав доступа в чужом процессе без ptrace невозможны и возвращают ERROR_NOT_SUPPORTED.
+ * Ошибки сообщаются через SetLastError() кодами WinAPI.
+ */
+class LinuxBackend
+{
+  public:
+    /**
+     * @brief Подключается к процессу
+     * @param processId PID процесса
+     * @details При отсутствии процесса isOpen() возвращает false
+     */
+    explicit LinuxBackend(DWORD processId);
+
+    bool  isOpen() const { return m_open; }
+    DWORD processId() const { return m_processId; }
+
+    /**
+     * @brief Читает память процесса (все байты или ничего)
+     */
+    bool read(uintptr_t address, void* buffer, size_t size) const
+    {
+        iovec local{buffer, size};
+        iovec remote{reinterpret_cast<void*>(address), size};
+        return finish(process_vm_readv(static_cast<pid_t>(m_processId), &local, 1, &remote, 1, 0), size);
+    }
+
+    /**
+     * @brief Записывает память процесса (с учётом прав доступа страниц)
+     */
+    bool write(uintptr_t address, const void* buffer, size_t size)
+    {
+        iovec local{const_cast<void*>(buffer), size};
+        iovec remote{reinterpret_cast<void*>(address), size};
+        return finish(process_vm_writev(static_cast<pid_t>(m_processId), &local, 1, &remote, 1, 0), size);
+    }
+
+    bool      query(uintptr_t address, MemoryRegion& region) const;
+
+    /**
+     * @brief Регионы, пересекающиеся с [start, end), за один разбор /proc/<pid>/maps
+     * @details Необязательный метод бэкенда: MemoryManager::EnumerateRegions использует его вместо
+     * query() на каждый регион, который каждый раз перечитывал бы maps целиком
+     */
+    bool enumerateRegions(uintptr_t start, uintptr_t end, std::vector<MemoryRegion>& regions) const;
+
+    bool      protect(uintptr_t address, size_t size, DWORD protection, DWORD& oldProtection);
+    uintptr_t allocate(uintptr_t address, size_t size, DWORD protection);
+    bool      release(uintptr_t address);
+    bool      enumerateModules(std::vector<ModuleInfo>& modules) const;
+
+  private:
+    /**
+     * @brief Строка /proc/<pid>/maps
+     */
+    struct Mapping
+    {
+        uintptr_t   start{0};      ///< Начало отображения
+        uintptr_t   end{0};        ///< Конец отображения (не включительно)
+        DWORD       protection{0}; ///< Права доступа (PAGE_*)
+        std::string path;          ///< Путь к файлу или псевдоимя ([heap], [stack])
+    };
+
+    /**
+     * @brief Читает все отображения процесса
+     */
+    bool readMappings(std::vector<Mapping>& mappings) const;
+
+    /**
+     * @brief Регион, соответствующий отображению
+     */
+    static MemoryRegion toRegion(const Mapping& mapping);
+
+    /**
+     * @brief Переводит результат process_vm_* в bool и код ошибки WinAPI
+     */
+    static bool finish(ssize_t transferred, size_t size)
+    {
+        if (transferred == static_cast<ssize_t>(size))
+        {
+            return true;
+        }
+        if (transferred >= 0)
+        {
+            SetLastError(ERROR_PARTIAL_COPY);
+        }
+        else if (errno == EPERM)
+        {
+            SetLastError(ERROR_ACCESS_DENIED);
+        }
+        else if (errno == ESRCH)
+        {
+            SetLastError(ERROR_INVALID_HANDLE);
+        }
+        else
+        {
+            SetLastError(ERROR_PARTIAL_COPY);
+        }
+        return false;
+    }
+
+    DWORD m_processId{0}; ///< PID процесса
+    bool  m_open{false};  ///< Процесс существует
+};
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file MemoryBackend.hpp
+ * @brief Набор бэкендов доступа к памяти для MemoryManager
+ * @details Бэкенд - класс с одинаковым набором невиртуальных методов (см. концепт
+ * MemoryBackendType). MemoryManager хранит std::variant бэкендов и обращается к нему
+ * через std::visit: вызов - переход по индексу альтернативы с встроенным телом read(),
+ * без косвенного вызова через таблицу виртуальных функций.
+ */
+#pragma once
+#include <concepts>
+#include <variant>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "DumpFileBackend.hpp"
+#include "InProcessBackend.hpp"
+#include "LinuxBackend.hpp"
+#include "Win32Backend.hpp"
+
+
+/**
+ * @brief Требования к бэкенду памяти
+ */
+template <typename Backend>
+concept MemoryBackendType = requires(Backend                  backend,
+                                     const Backend&           constBackend,
+                                     uintptr_t                address,
+                                     void*                    buffer,
+                                     const void*              source,
+                                     size_t                   size,
+                                     DWORD                    protection,
+                                     DWORD&                   oldProtection,
+                                     MemoryRegion&            region,
+                                     std::vector<ModuleInfo>& modules) {
+    { constBackend.isOpen() } -> std::same_as<bool>;
+    { constBackend.processId() } -> std::same_as<DWORD>;
+    { constBackend.read(address, buffer, size) } -> std::same_as<bool>;
+    { backend.write(address, source, size) } -> std::same_as<bool>;
+    { constBackend.query(address, region) } -> std::same_as<bool>;
+    { backend.protect(address, size, protection, oldProtection) } -> std::same_as<bool>;
+    { backend.allocate(address, size, protection) } -> std::same_as<uintptr_t>;
+    { backend.release(address) } -> std::same_as<bool>;
+    { constBackend.enumerateModules(modules) } -> std::same_as<bool>;
+};
+
+#if defined(_WIN32)
+using ProcessBackend = Win32Backend; ///< Бэкенд для чужого процесса на текущей платформе
+#elif defined(__linux__)
+using ProcessBackend = LinuxBackend; ///< Бэкенд для чужого процесса на текущей платформе
+#else
+#error "No process memory backend for this platform"
+#endif
+
+/**
+ * @brief Любой из доступных бэкендов
+ */
+using MemoryBackend = std::variant<ProcessBackend, InProcessBackend, DumpFileBackend>;
+
+static_assert(MemoryBackendType<ProcessBackend>);
+static_assert(MemoryBackendType<InProcessBackend>);
+static_assert(MemoryBackendType<DumpFileBackend>);
@@ -0,0 +1,106 @@
+#include "Win32Backend.hpp"
+
+#ifdef _WIN32
+#include <TlHelp32.h>
+
+
+Win32Backend::Win32Backend(DWORD processId) : m_processId(processId)
+{
+    // Запрашиваем все необходимые права для работы с процессом
+    m_handle = OpenProcess(PROCESS_QUERY_INFORMATION | // Для получения информации о процессе
+                               PROCESS_VM_READ |       // Для чтения памяти
+                               PROCESS_VM_WRITE |      // Для записи в память
+                               PROCESS_VM_OPERATION |  // Для VirtualAllocEx/VirtualFreeEx
+                               PROCESS_CREATE_THREAD | // Для CreateRemoteThread
+                               PROCESS_SUSPEND_RESUME, // Для управления потоками
+                           FALSE,
+                           processId);
+}
+
+Win32Backend::~Win32Backend()
+{
+    if (m_handle)
+    {
+        CloseHandle(m_handle);
+    }
+}
+
+Win32Backend::Win32Backend(Win32Backend&& other) noexcept : m_handle(other.m_handle), m_processId(other.m_processId)
+{
+    other.m_handle    = nullptr;
+    other.m_processId = 0;
+}
+
+Win32Backend& Win32Backend::operator=(Win32Backend&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_handle)
+        {
+            CloseHandle(m_handle);
+        }
+        m_handle          = other.m_handle;
+        m_processId       = other.m_processId;
+        other.m_handle    = nullptr;
+        other.m_processId = 0;
+    }
+    return *this;
+}
+
+bool Win32Backend::query(uintptr_t address, MemoryRegion& region) const
+{
+    MEMORY_BASIC_INFORMATION mbi;
+    if (VirtualQueryEx(m_handle, (LPCVOID)address, &mbi, sizeof(mbi)) != sizeof(mbi))
+    {
+        return false;
+    }
+
+    region = MemoryRegion{reinterpret_cast<uintptr_t>(mbi.BaseAddress),
+                          mbi.RegionSize,
+                          static_cast<uint32_t>(mbi.Protect),
+                          static_cast<uint32_t>(mbi.State),
+                          static_cast<uint32_t>(mbi.Type)};
+    return true;
+}
+
+bool Win32Backend::protect(uintptr_t address, size_t size, DWORD protection, DWORD& oldProtection)
+{
+    return VirtualProtectEx(m_handle, (LPVOID)address, size, protection, &oldProtection) != FALSE;
+}
+
+uintptr_t Win32Backend::allocate(uintptr_t address, size_t size, DWORD protection)
+{
+    return reinterpret_cast<uintptr_t>(
+        VirtualAllocEx(m_handle, (LPVOID)address, size, MEM_COMMIT | MEM_RESERVE, protection));
+}
+
+bool Win32Backend::release(uintptr_t address)
+{
+    return VirtualFreeEx(m_handle, (LPVOID)address, 0, MEM_RELEASE) != FALSE;
+}
+
+bool Win32Backend::enumerateModules(std::vector<ModuleInfo>& modules) const
+{
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, m_processId);
+    if (snapshot == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    MODULEENTRY32W moduleEntry;
+    moduleEntry.dwSize = sizeof(moduleEntry);
+
+    if (Module32FirstW(snapshot, &moduleEntry))
+    {
+        do
+        {
+            modules.push_back(ModuleInfo{moduleEntry.szModule,
+                                         reinterpret_cast<uintptr_t>(moduleEntry.modBaseAddr),
+                                         moduleEntry.modBaseSize});
+        } while (Module32NextW(snapshot, &moduleEntry));
+    }
+
+    CloseHandle(snapshot);
+    return true;
+}
+#endif
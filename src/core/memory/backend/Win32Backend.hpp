@@ -0,0 +1,69 @@
+/**
+ * @file Win32Backend.hpp
+ * @brief Доступ к памяти другого процесса через WinAPI
+ */
+#pragma once
+#ifdef _WIN32
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/memory/MemoryRegion.hpp"
+#include "core/memory/Platform.hpp"
+
+
+/**
+ * @class Win32Backend
+ * @brief Бэкенд поверх OpenProcess/ReadProcessMemory/VirtualQueryEx
+ * @details Владеет handle процесса. Ошибки сообщаются через GetLastError().
+ */
+class Win32Backend
+{
+  public:
+    /**
+     * @brief Открывает процесс с правами на чтение, запись и управление памятью
+     * @param processId ID процесса
+     * @details При ошибке isOpen() возвращает false, причина - в GetLastError()
+     */
+    explicit Win32Backend(DWORD processId);
+    ~Win32Backend();
+
+    Win32Backend(const Win32Backend&)            = delete;
+    Win32Backend& operator=(const Win32Backend&) = delete;
+    Win32Backend(Win32Backend&& other) noexcept;
+    Win32Backend& operator=(Win32Backend&& other) noexcept;
+
+    bool   isOpen() const { return m_handle != nullptr; }
+    DWORD  processId() const { return m_processId; }
+    HANDLE handle() const { return m_handle; }
+
+    /**
+     * @brief Читает память процесса (все байты или ничего)
+     */
+    bool read(uintptr_t address, void* buffer, size_t size) const
+    {
+        SIZE_T bytesRead;
+        return ReadProcessMemory(m_handle, (LPCVOID)address, buffer, size, &bytesRead) && bytesRead == size;
+    }
+
+    /**
+     * @brief Записывает память процесса
+     */
+    bool write(uintptr_t address, const void* buffer, size_t size)
+    {
+        SIZE_T bytesWritten;
+        return WriteProcessMemory(m_handle, (LPVOID)address, buffer, size, &bytesWritten) && bytesWritten == size;
+    }
+
+    bool      query(uintptr_t address, MemoryRegion& region) const;
+    bool      protect(uintptr_t address, size_t size, DWORD protection, DWORD& oldProtection);
+    uintptr_t allocate(uintptr_t address, size_t size, DWORD protection);
+    bool      release(uintptr_t address);
+    bool      enumerateModules(std::vector<ModuleInfo>& modules) const;
+
+  private:
+    HANDLE m_handle{nullptr}; ///< Handle процесса
+    DWORD  m_processId{0};    ///< ID процесса
+};
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file DumpFormat.hpp
+ * @brief Формат файла снимка памяти процесса
+ * @details Все поля little-endian фиксированной ширины, чтобы снимок 32-битного клиента
+ * открывался и в 64-битной сборке. Файл рассчитан на отображение в память (mmap):
+ * @code
+ * DumpHeader
+ * DumpRegionRecord[regionCount]
+ * DumpBlockRecord[blockCount]
+ * DumpModuleRecord[moduleCount], за каждой записью - имя (nameLength символов UTF-16)
+ * данные блоков (несжатые блоки выровнены по странице)
+ * @endcode
+ * Данные региона разбиты на блоки по blockSize байт (последний блок может быть короче).
+ * Несжатые блоки читаются прямо из отображения без копирования, сжатые (qCompress)
+ * распаковываются при первом обращении.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+
+namespace dump_format
+{
+    constexpr char     MAGIC[8]           = {'M', 'D', 'B', 'D', 'U', 'M', 'P', '\0'}; ///< Сигнатура файла
+    constexpr uint32_t VERSION            = 2;                                          ///< Версия формата
+    constexpr uint32_t DEFAULT_BLOCK_SIZE = 0x10000;                                    ///< Размер блока по умолчанию
+    constexpr uint32_t DATA_ALIGNMENT     = 0x1000;                                     ///< Выравнивание несжатых блоков
+
+    constexpr uint32_t BLOCK_COMPRESSED = 0x1; ///< Флаг блока: данные сжаты qCompress
+
+#pragma pack(push, 1)
+    /**
+     * @brief Заголовок снимка
+     */
+    struct DumpHeader
+    {
+        char     magic[8];    ///< MAGIC
+        uint32_t version;     ///< VERSION
+        uint32_t processId;   ///< PID процесса на момент снятия
+        uint32_t regionCount; ///< Количество регионов
+        uint32_t blockCount;  ///< Количество блоков данных
+        uint32_t moduleCount; ///< Количество модулей
+        uint32_t blockSize;   ///< Размер несжатого блока (кратен DATA_ALIGNMENT)
+    };
+
+    /**
+     * @brief Описание региона
+     */
+    struct DumpRegionRecord
+    {
+        uint64_t base;       ///< Адрес региона в процессе
+        uint64_t size;       ///< Размер региона
+        uint32_t protection; ///< Права доступа (PAGE_*)
+        uint32_t type;       ///< Тип региона (MEM_*)
+        uint32_t firstBlock; ///< Индекс первого блока данных региона
+        uint32_t reserved;   ///< Зарезервировано (0)
+    };
+
+    /**
+     * @brief Описание блока данных
+     */
+    struct DumpBlockRecord
+    {
+        uint64_t fileOffset; ///< Смещение данных блока от начала файла
+        uint32_t storedSize; ///< Размер данных блока в файле
+        uint32_t flags;      ///< BLOCK_COMPRESSED
+    };
+
+    /**
+     * @brief Описание модуля
+     */
+    struct DumpModuleRecord
+    {
+        uint64_t base;       ///< Базовый адрес образа
+        uint64_t size;       ///< Размер образа
+        uint32_t nameLength; ///< Длина имени в символах UTF-16
+    };
+#pragma pack(pop)
+
+    /**
+     * @brief Количество блоков, на которые делится регион
+     */
+    constexpr uint64_t blockCountFor(uint64_t regionSize, uint32_t blockSize)
+    {
+        return (regionSize + blockSize - 1) / blockSize;
+    }
+} // namespace dump_format
@@ -0,0 +1,206 @@
+#include "DumpWriter.hpp"
+
+#include <QDebug>
+#include <QFile>
+
+#include <algorithm>
+#include <cstring>
+
+
+using namespace dump_format;
+
+DumpWriter::DumpWriter(DumpOptions options) : m_options(options)
+{
+    if (m_options.blockSize == 0 || m_options.blockSize % DATA_ALIGNMENT != 0)
+    {
+        m_options.blockSize = DEFAULT_BLOCK_SIZE;
+    }
+}
+
+bool DumpWriter::capture(MemoryManager& memory, std::span<const MemoryRegion> regions, const QString& filePath)
+{
+    m_regions.clear();
+    m_blocks.clear();
+    m_stats = DumpStats{};
+    m_error.clear();
+
+    constexpr size_t     PAGE = DATA_ALIGNMENT;
+    std::vector<uint8_t> block(m_options.blockSize);
+    std::vector<uint8_t> segment;
+
+    for (const auto& region : regions)
+    {
+        uintptr_t segmentBase = region.base;
+        segment.clear();
+
+        for (size_t offset = 0; offset < region.size; offset += m_options.blockSize)
+        {
+            const uintptr_t address = region.base + offset;
+            const size_t    size    = std::min<size_t>(m_options.blockSize, region.size - offset);
+
+            if (memory.TryReadMemory(address, block.data(), size) == ReadError::None)
+            {
+                segment.insert(segment.end(), block.begin(), block.begin() + size);
+                continue;
+            }
+
+            // Блок читается не целиком - дочитываем постранично, нечитаемые страницы режут регион
+            for (size_t page = 0; page < size; page += PAGE)
+            {
+                const size_t pageSize = std::min(PAGE, size - page);
+                if (memory.TryReadMemory(address + page, block.data(), pageSize) == ReadError::None)
+                {
+                    segment.insert(segment.end(), block.begin(), block.begin() + pageSize);
+                    continue;
+                }
+
+                m_stats.unreadablePages++;
+                flushSegment(region, segmentBase, segment);
+                segmentBase = address + page + pageSize;
+            }
+        }
+        flushSegment(region, segmentBase, segment);
+    }
+
+    const auto modules = memory.GetModules();
+    if (!writeFile(filePath, memory.GetProcessId(), modules))
+    {
+        qDebug() << "Failed to write dump" << filePath << ":" << m_error;
+        return false;
+    }
+
+    qDebug() << "Dump written to" << filePath << "regions:" << m_stats.regions << "blocks:" << m_stats.blocks
+             << "captured bytes:" << m_stats.bytesCaptured << "file size:" << m_stats.fileSize;
+    return true;
+}
+
+void DumpWriter::flushSegment(const MemoryRegion& source, uintptr_t base, std::vector<uint8_t>& data)
+{
+    if (data.empty())
+    {
+        return;
+    }
+
+    MemoryRegion region = source;
+    region.base         = base;
+    region.size         = data.size();
+    m_regions.push_back(CapturedRegion{region, static_cast<uint32_t>(m_blocks.size())});
+
+    for (size_t offset = 0; offset < data.size(); offset += m_options.blockSize)
+    {
+        const size_t size = std::min<size_t>(m_options.blockSize, data.size() - offset);
+        QByteArray   raw(reinterpret_cast<const char*>(data.data() + offset), static_cast<qsizetype>(size));
+
+        if (m_options.compress)
+        {
+            // Несжимаемые блоки храним как есть, чтобы читать их без распаковки
+            QByteArray packed = qCompress(raw, m_options.compressionLevel);
+            if (packed.size() < raw.size())
+            {
+                m_blocks.push_back(CapturedBlock{std::move(packed), true});
+                m_stats.compressedBlocks++;
+                continue;
+            }
+        }
+        m_blocks.push_back(CapturedBlock{std::move(raw), false});
+    }
+
+    m_stats.regions++;
+    m_stats.bytesCaptured += data.size();
+    data.clear();
+}
+
+bool DumpWriter::writeFile(const QString& filePath, DWORD processId, const std::vector<ModuleInfo>& modules)
+{
+    m_stats.blocks = m_blocks.size();
+
+    // Раскладка: заголовок и таблицы, затем данные блоков с выравниванием несжатых по странице
+    uint64_t tablesSize = sizeof(DumpHeader) + m_regions.size() * sizeof(DumpRegionRecord)
+                          + m_blocks.size() * sizeof(DumpBlockRecord);
+    for (const auto& module : modules)
+    {
+        tablesSize += sizeof(DumpModuleRecord) + module.name.size() * sizeof(char16_t);
+    }
+
+    auto align = [](uint64_t value) { return (value + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT; };
+
+    std::vector<DumpBlockRecord> blockRecords;
+    blockRecords.reserve(m_blocks.size());
+    uint64_t offset = align(tablesSize);
+    for (const auto& block : m_blocks)
+    {
+        if (!block.compressed)
+        {
+            offset = align(offset);
+        }
+        blockRecords.push_back(DumpBlockRecord{offset,
+                                               static_cast<uint32_t>(block.data.size()),
+                                               block.compressed ? BLOCK_COMPRESSED : 0u});
+        offset += block.data.size();
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        m_error = file.errorString();
+        return false;
+    }
+
+    DumpHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version     = VERSION;
+    header.processId   = processId;
+    header.regionCount = static_cast<uint32_t>(m_regions.size());
+    header.blockCount  = static_cast<uint32_t>(m_blocks.size());
+    header.moduleCount = static_cast<uint32_t>(modules.size());
+    header.blockSize   = m_options.blockSize;
+
+    QByteArray tables;
+    tables.reserve(static_cast<qsizetype>(tablesSize));
+    auto put = [&tables](const void* data, size_t size)
+    { tables.append(static_cast<const char*>(data), static_cast<qsizetype>(size)); };
+
+    put(&header, sizeof(header));
+    for (const auto& captured : m_regions)
+    {
+        const DumpRegionRecord record{captured.region.base,
+                                      captured.region.size,
+                                      captured.region.protection,
+                                      captured.region.type,
+                                      captured.firstBlock,
+                                      0};
+        put(&record, sizeof(record));
+    }
+    put(blockRecords.data(), blockRecords.size() * sizeof(DumpBlockRecord));
+    for (const auto& module : modules)
+    {
+        const DumpModuleRecord record{module.base, module.size, static_cast<uint32_t>(module.name.size())};
+        put(&record, sizeof(record));
+        for (wchar_t c : module.name)
+        {
+            const char16_t unit = static_cast<char16_t>(c);
+            put(&unit, sizeof(unit));
+        }
+    }
+
+    bool written = file.write(tables) == tables.size();
+    for (size_t i = 0; written && i < m_blocks.size(); i++)
+    {
+        // Дополняем нулями до смещения блока
+        const qint64 padding = static_cast<qint64>(blockRecords[i].fileOffset) - file.pos();
+        if (padding > 0)
+        {
+            written = file.write(QByteArray(padding, '\0')) == padding;
+        }
+        written = written && file.write(m_blocks[i].data) == m_blocks[i].data.size();
+    }
+
+    if (!written)
+    {
+        m_error = file.errorString();
+        return false;
+    }
+
+    m_stats.fileSize = static_cast<uint64_t>(file.pos());
+    return true;
+}
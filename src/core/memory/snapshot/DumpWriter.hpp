@@ -0,0 +1,112 @@
+/**
+ * @file DumpWriter.hpp
+ * @brief Снятие снимка памяти процесса в файл (см. DumpFormat.hpp)
+ */
+#pragma once
+#include <span>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <QByteArray>
+#include <QString>
+
+#include "core/memory/MemoryManager.hpp"
+#include "DumpFormat.hpp"
+
+
+/**
+ * @brief Параметры снятия снимка
+ */
+struct DumpOptions
+{
+    bool     compress{false};                            ///< Сжимать блоки (qCompress)
+    int      compressionLevel{-1};                       ///< Уровень сжатия zlib (-1 - по умолчанию)
+    uint32_t blockSize{dump_format::DEFAULT_BLOCK_SIZE}; ///< Размер блока (кратен 4 KiB)
+};
+
+/**
+ * @brief Итоги снятия снимка
+ */
+struct DumpStats
+{
+    size_t   regions{0};          ///< Записанные регионы (после разбиения по нечитаемым страницам)
+    size_t   blocks{0};           ///< Записанные блоки
+    size_t   compressedBlocks{0}; ///< Блоки, сохранённые сжатыми
+    size_t   unreadablePages{0};  ///< Пропущенные нечитаемые страницы
+    uint64_t bytesCaptured{0};    ///< Прочитано байт из процесса
+    uint64_t fileSize{0};         ///< Размер файла снимка
+};
+
+/**
+ * @class DumpWriter
+ * @brief Читает набор регионов процесса и сохраняет их в файл снимка
+ * @details Регион читается блоками; если блок не читается целиком, он дочитывается
+ * постранично, а нечитаемые страницы разрезают регион на части. Снимок собирается
+ * в памяти и записывается одним проходом, поэтому пиковое потребление памяти
+ * равно размеру данных снимка (меньше при сжатии).
+ */
+class DumpWriter
+{
+  public:
+    /**
+     * @brief Конструктор
+     * @param options Параметры снимка
+     */
+    explicit DumpWriter(DumpOptions options = {});
+
+    /**
+     * @brief Снимает регионы процесса в файл
+     * @param memory Менеджер памяти процесса (любой бэкенд)
+     * @param regions Регионы для снятия (например, из MemoryManager::EnumerateRegions)
+     * @param filePath Путь к файлу снимка
+     * @return true если снимок записан
+     */
+    bool capture(MemoryManager& memory, std::span<const MemoryRegion> regions, const QString& filePath);
+
+    /**
+     * @brief Итоги последнего снятия
+     */
+    const DumpStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Описание ошибки последнего снятия
+     */
+    const QString& error() const { return m_error; }
+
+  private:
+    /**
+     * @brief Регион снимка и его блоки
+     */
+    struct CapturedRegion
+    {
+        MemoryRegion region;     ///< Описание региона
+        uint32_t     firstBlock; ///< Индекс первого блока
+    };
+
+    /**
+     * @brief Блок, подготовленный к записи
+     */
+    struct CapturedBlock
+    {
+        QByteArray data;       ///< Данные (сжатые или нет)
+        bool       compressed; ///< Флаг сжатия
+    };
+
+    /**
+     * @brief Закрывает непрерывный участок: режет его на блоки и добавляет регион
+     */
+    void flushSegment(const MemoryRegion& source, uintptr_t base, std::vector<uint8_t>& data);
+
+    /**
+     * @brief Записывает собранный снимок в файл
+     */
+    bool writeFile(const QString& filePath, DWORD processId, const std::vector<ModuleInfo>& modules);
+
+    DumpOptions                 m_options; ///< Параметры
+    std::vector<CapturedRegion> m_regions; ///< Собранные регионы
+    std::vector<CapturedBlock>  m_blocks;  ///< Собранные блоки
+    DumpStats                   m_stats;   ///< Итоги
+    QString                     m_error;   ///< Описание ошибки
+};
@@ -10,6 +10,12 @@
 BotCore::BotCore(DWORD processId, QObject* parent) : QObject(parent)
 {
     m_context.processId = processId; // Сохраняем ID процесса
+    m_characterWatches.fill(INVALID_WATCH);
+    m_entities.reserve(4096); // Объектов в зоне видимости клиента заметно меньше: индекс GUID не перестраивается
+
+    m_tickTimer = new QTimer(this);
+    m_tickTimer->setInterval(TICK_INTERVAL_MS);
+    connect(m_tickTimer, &QTimer::timeout, this, &BotCore::tick);
 
     try
     {
@@ -26,6 +32,7 @@ BotCore::BotCore(DWORD processId, QObject* parent) : QObject(parent)
 BotCore::~BotCore()
 {
     LogManager::instance().debug("BotCore destructor called", "Core");
+    m_tickTimer->stop();
     disable();
 }
 
@@ -62,6 +69,7 @@ bool BotCore::initialize()
     }
 
     m_initialized = true;
+    m_tickTimer->start(); // Процесс подключен: тик идёт до уничтожения BotCore, независимо от enable()/disable()
     LogManager::instance().info(QString("BotCore initialized for process: %1, window: 0x%2")
                                     .arg(m_context.processId)
                                     .arg(QString::number((quintptr)m_context.windowHandle, 16)),
@@ -89,6 +97,141 @@ void BotCore::disable()
     }
 }
 
+void BotCore::watchCharacter(uintptr_t address)
+{
+    for (size_t i = 0; i < CharacterLayout::FIELD_COUNT; i++)
+    {
+        const uintptr_t fieldAddress = address + CharacterLayout::OFFSETS[i];
+        if (m_characterWatches[i] == INVALID_WATCH)
+        {
+            m_characterWatches[i] = m_watches.add(fieldAddress, CharacterLayout::SIZES[i]);
+        }
+        else
+        {
+            m_watches.setAddress(m_characterWatches[i], fieldAddress);
+        }
+    }
+    m_context.character.eaxRegister = static_cast<uint32_t>(address);
+}
+
+void BotCore::pollWatches()
+{
+    if (!m_memory || m_watches.size() == 0)
+    {
+        return;
+    }
+
+    const auto changes = m_watches.poll(*m_memory);
+    if (changes.empty())
+    {
+        return;
+    }
+
+    for (WatchId id : changes)
+    {
+        for (size_t i = 0; i < CharacterLayout::FIELD_COUNT; i++)
+        {
+            if (m_characterWatches[i] == id && m_watches.isValid(id))
+            {
+                CharacterLayout::decodeField(i, m_watches.data(id), m_context.character);
+            }
+        }
+    }
+
+    m_changes.assign(changes.begin(), changes.end());
+    emit watchesChanged(m_changes);
+}
+
+void BotCore::tick()
+{
+    if (!m_memory)
+    {
+        return;
+    }
+
+    // Один тик - одна эпоха: кэш страниц, звенья PointerChain и карта регионов стареют по ней
+    m_memory->BeginTick();
+    pollWatches();
+    refreshObjects();
+    if (m_enabled)
+    {
+        selectTarget();
+    }
+}
+
+void BotCore::refreshObjects()
+{
+    if (!m_memory)
+    {
+        return;
+    }
+
+    // Персонаж не в мире - не ошибка, таблица просто пуста
+    if (!m_refresh.tick(*m_memory, m_objects, m_entities, m_grid))
+    {
+        return;
+    }
+
+    if (!m_refresh.error().empty())
+    {
+        LogManager::instance().debug(QString("Object refresh: %1").arg(QString::fromStdString(m_refresh.error())),
+                                     "Core");
+    }
+    emit objectsUpdated();
+}
+
+void BotCore::selectTarget()
+{
+    const EntityIndex local = m_entities.find(m_objects.localGuid());
+    if (local == INVALID_ENTITY)
+    {
+        if (m_target != EntityHandle{})
+        {
+            m_target = EntityHandle{};
+            emit targetChanged();
+        }
+        return;
+    }
+
+    const float x       = m_entities.x()[local];
+    const float y       = m_entities.y()[local];
+    const auto  inRange = [&](EntityIndex index)
+    {
+        const float dx = m_entities.x()[index] - x;
+        const float dy = m_entities.y()[index] - y;
+        return m_entities.health()[index] > 0 && dx * dx + dy * dy <= TARGET_RANGE * TARGET_RANGE;
+    };
+
+    // Текущая цель жива и рядом - не переключаемся
+    const EntityIndex current = m_entities.resolve(m_target);
+    if (current != INVALID_ENTITY && inRange(current))
+    {
+        return;
+    }
+
+    SpatialFilter units;
+    units.types         = SpatialFilter::typeBit(ObjectType::Unit);
+    units.excludedFlags = UnitFlags::NOT_SELECTABLE;
+    units.exclude       = local;
+    m_grid.nearest(m_entities, x, y, TARGET_CANDIDATES, TARGET_RANGE, units, m_candidates);
+
+    EntityHandle target;
+    for (EntityIndex index : m_candidates)
+    {
+        if (m_entities.health()[index] > 0)
+        {
+            target = m_entities.handle(index);
+            break;
+        }
+    }
+
+    if (target != m_target)
+    {
+        m_target = target;
+        emit targetChanged();
+    }
+}
+
 namespace
 {
     struct EnumWindowsData
@@ -302,23 +445,13 @@ bool BotCore::setupHooks()
 //             LogManager::instance().debug(
 //                 QString("Updating character data from EAX: 0x%1").arg(QString::number(regs.eax, 16)), "Core");
 //
-//             // Читаем данные персонажа из памяти
-//             m_context.character.currentHealth = m_memory->Read<uint32_t>(regs.eax +
-//             CharacterData::CURRENT_HP_OFFSET); m_context.character.currentMana = m_memory->Read<uint32_t>(regs.eax +
-//             CharacterData::CURRENT_MANA_OFFSET); m_context.character.maxHealth = m_memory->Read<uint32_t>(regs.eax +
-//             CharacterData::MAX_HP_OFFSET); m_context.character.maxMana = m_memory->Read<uint32_t>(regs.eax +
-//             CharacterData::MAX_MANA_OFFSET); m_context.character.level = m_memory->Read<uint32_t>(regs.eax +
-//             CharacterData::LEVEL_OFFSET); m_context.character.eaxRegister = regs.eax;
-//
-//             LogManager::instance().debug(QString("Character data updated - Level: %1, HP: %2/%3, Mana: %4/%5")
-//                                              .arg(m_context.character.level)
-//                                              .arg(m_context.character.currentHealth)
-//                                              .arg(m_context.character.maxHealth)
-//                                              .arg(m_context.character.currentMana)
-//                                              .arg(m_context.character.maxMana),
-//                                          "Core");
-//
-//             emit contextUpdated();
+//             // Поля персонажа опрашиваются списком наблюдения: в UI уходят только изменения
+//             if (m_context.character.eaxRegister != regs.eax)
+//             {
+//                 watchCharacter(regs.eax);
+//                 emit contextUpdated();
+//             }
+//             pollWatches();
 //         }
 //         catch (const std::exception& e)
 //         {
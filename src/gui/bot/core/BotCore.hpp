@@ -3,10 +3,19 @@
 
 #include <QObject>
 #include <QString>
+#include <QTimer>
+
+#include <array>
+#include <vector>
 
 #include "character/CharacterData.hpp"
+#include "entities/EntityTable.hpp"
+#include "entities/RefreshPlanner.hpp"
+#include "entities/SpatialGrid.hpp"
+#include "objects/ObjectWalker.hpp"
 // #include "core/hooks/RegisterHook.hpp" // Временно отключен
 #include "core/memory/MemoryManager.hpp"
+#include "core/memory/WatchList.hpp"
 
 
 /**
@@ -56,6 +65,7 @@ class BotCore : public QObject
      * - Поиск окна процесса
      * - Установку хуков
      * - Подготовку менеджера памяти
+     * - Запуск тика бота (tick()): он идёт до уничтожения BotCore, в том числе при выключенном боте
      */
     bool initialize();
 
@@ -83,6 +93,61 @@ class BotCore : public QObject
      */
     const BotContext& context() const { return m_context; }
 
+    /**
+     * @brief Привязывает наблюдение за полями персонажа к структуре игрока
+     * @param address Адрес структуры игрока (значение EAX в хуке)
+     * @details Поля CharacterLayout добавляются в список наблюдения при первом вызове
+     * и переносятся на новый адрес при последующих
+     */
+    void watchCharacter(uintptr_t address);
+
+    /**
+     * @brief Идентификатор наблюдения за полем персонажа
+     * @return INVALID_WATCH если watchCharacter() ещё не вызывался
+     */
+    WatchId characterWatch(CharacterField field) const { return m_characterWatches[static_cast<size_t>(field)]; }
+
+    /**
+     * @brief Список наблюдаемых полей
+     */
+    const WatchList& watches() const { return m_watches; }
+
+    /**
+     * @brief Менеджер памяти процесса
+     */
+    std::shared_ptr<MemoryManager> memory() const { return m_memory; }
+
+    /**
+     * @brief Объекты последнего обхода списка (обходится раз в несколько тиков; актуальные поля - в entities())
+     */
+    const ObjectWalker& objects() const { return m_objects; }
+
+    /**
+     * @brief Состояние видимых объектов по колонкам (обновляется refreshObjects())
+     */
+    const EntityTable& entities() const { return m_entities; }
+
+    /**
+     * @brief Пространственный индекс над entities()
+     */
+    const SpatialGrid& grid() const { return m_grid; }
+
+    /**
+     * @brief План обновления entities() (счётчики чтений по уровням)
+     */
+    const RefreshPlanner& refresh() const { return m_refresh; }
+
+    /**
+     * @brief Текущая цель бота (выбирается в tick(), пока бот включен)
+     * @details Устаревшая ручка (цель исчезла) разрешается в INVALID_ENTITY, см. EntityTable::resolve()
+     */
+    EntityHandle target() const { return m_target; }
+
+    /**
+     * @brief Перечитать сущность целиком (уровень, фракцию, флаги...) в следующем refreshObjects()
+     */
+    void requestEntity(EntityHandle handle) { m_refresh.request(handle); }
+
     // /**
     //  * @brief Обработчик обновления регистров
     //  * @param regs Структура с значениями регистров
@@ -93,16 +158,38 @@ class BotCore : public QObject
   public slots:
     /**
      * @brief Включение бота
-     * @details Активирует хуки и начинает обработку данных
+     * @details Активирует хуки и начинает обработку данных: тик начинает выбирать цель
      */
     void enable();
 
     /**
      * @brief Выключение бота
-     * @details Деактивирует хуки и останавливает обработку
+     * @details Деактивирует хуки и останавливает обработку; тик продолжает обновлять память и объекты для UI
      */
     void disable();
 
+    /**
+     * @brief Опрос наблюдаемых полей
+     * @details Читает все поля одним пакетом, переносит изменившиеся поля персонажа в контекст
+     * и испускает watchesChanged() только если что-то изменилось
+     */
+    void pollWatches();
+
+    /**
+     * @brief Тик бота
+     * @details Вызывается таймером m_tickTimer: открывает новый тик чтения MemoryManager::BeginTick(),
+     * опрашивает наблюдаемые поля pollWatches(), обновляет объекты refreshObjects() и, если бот включен,
+     * выбирает цель selectTarget()
+     */
+    void tick();
+
+    /**
+     * @brief Обновляет объекты вокруг персонажа на один тик
+     * @details Перечитывает сущности по плану refresh(), обновляет entities() и grid() и испускает
+     * objectsUpdated(), если менеджер объектов доступен
+     */
+    void refreshObjects();
+
   signals:
     /**
      * @brief Сигнал изменения состояния
@@ -116,7 +203,34 @@ class BotCore : public QObject
      */
     void contextUpdated();
 
+    /**
+     * @brief Сигнал изменения наблюдаемых полей
+     * @param changes Идентификаторы изменившихся полей (см. characterWatch())
+     */
+    void watchesChanged(const std::vector<WatchId>& changes);
+
+    /**
+     * @brief Сигнал обновления снимка объектов (см. objects())
+     */
+    void objectsUpdated();
+
+    /**
+     * @brief Сигнал смены цели бота (см. target())
+     */
+    void targetChanged();
+
   private:
+    static constexpr int    TICK_INTERVAL_MS  = 100;   ///< Период тика бота
+    static constexpr float  TARGET_RANGE      = 40.0f; ///< Радиус выбора цели в ярдах
+    static constexpr size_t TARGET_CANDIDATES = 8;     ///< Ближайшие существа, среди которых ищется живая цель
+
+    /**
+     * @brief Выбирает цель бота
+     * @details Живая цель в радиусе TARGET_RANGE сохраняется; иначе берётся ближайшее живое существо,
+     * которое можно выбрать (запрос SpatialGrid::nearest()). При смене цели испускает targetChanged()
+     */
+    void selectTarget();
+
     /**
      * @brief Поиск хэндла окна процесса
      * @return true если окно найдено
@@ -130,9 +244,19 @@ class BotCore : public QObject
     bool setupHooks();
 
   private:
-    BotContext                     m_context;            ///< Контекст бота
-    bool                           m_initialized{false}; ///< Флаг инициализации
-    bool                           m_enabled{false};     ///< Флаг активности
-    std::shared_ptr<MemoryManager> m_memory;             ///< Менеджер памяти
+    BotContext                                        m_context;            ///< Контекст бота
+    bool                                              m_initialized{false}; ///< Флаг инициализации
+    bool                                              m_enabled{false};     ///< Флаг активности
+    std::shared_ptr<MemoryManager>                    m_memory;             ///< Менеджер памяти
+    WatchList                                         m_watches;            ///< Наблюдаемые поля
+    std::vector<WatchId>                              m_changes;            ///< Изменения последнего опроса
+    std::array<WatchId, CharacterLayout::FIELD_COUNT> m_characterWatches;   ///< Наблюдения за полями персонажа (по CharacterField)
+    ObjectWalker                                      m_objects;            ///< Обход менеджера объектов
+    EntityTable                                       m_entities;           ///< Состояние видимых объектов
+    SpatialGrid                                       m_grid;               ///< Индекс по координатам
+    RefreshPlanner                                    m_refresh;            ///< План обновления сущностей
+    QTimer*                                           m_tickTimer{nullptr}; ///< Таймер тика бота
+    EntityHandle                                      m_target;             ///< Цель бота
+    std::vector<EntityIndex>                          m_candidates;         ///< Результат запроса цели (переиспользуется)
     // std::unique_ptr<RegisterHook> m_registerHook; ///< Хук регистров - временно отключен
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include <cstdint>
 
+#include "core/memory/RemoteStruct.hpp"
+
 /**
  * @brief Структура данных персонажа в WoW
  * @details Содержит основные характеристики персонажа, такие как:
@@ -27,4 +29,31 @@ struct CharacterData {
 
     // Смещение функции обработки данных игрока относительно базового адреса run.exe
     static constexpr uint32_t PLAYER_FUNC_OFFSET = 0x2DBE77; ///< Смещение для хука функции обработки данных игрока
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Описание структуры игрока в памяти WoW
+ * @details Все поля читаются одним чтением диапазона [CURRENT_HP_OFFSET, LEVEL_OFFSET + 4)
+ */
+using CharacterLayout = RemoteStruct<CharacterData,
+                                     RemoteField<&CharacterData::currentHealth, CharacterData::CURRENT_HP_OFFSET>,
+                                     RemoteField<&CharacterData::currentMana, CharacterData::CURRENT_MANA_OFFSET>,
+                                     RemoteField<&CharacterData::maxHealth, CharacterData::MAX_HP_OFFSET>,
+                                     RemoteField<&CharacterData::maxMana, CharacterData::MAX_MANA_OFFSET>,
+                                     RemoteField<&CharacterData::level, CharacterData::LEVEL_OFFSET>>;
+
+/**
+ * @brief Индексы полей CharacterLayout (порядок совпадает с описанием)
+ */
+enum class CharacterField : size_t
+{
+    CurrentHealth,
+    CurrentMana,
+    MaxHealth,
+    MaxMana,
+    Level,
+    Count
+};
+
+static_assert(static_cast<size_t>(CharacterField::Count) == CharacterLayout::FIELD_COUNT,
+              "CharacterField must list every CharacterLayout field");
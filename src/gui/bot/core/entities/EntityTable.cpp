@@ -0,0 +1,219 @@
+#include "EntityTable.hpp"
+
+#include <algorithm>
+
+
+void EntityTable::reserve(size_t capacity)
+{
+    forEachColumn([capacity](auto& column) { column.reserve(capacity); });
+    m_index.reserve(capacity);
+}
+
+void EntityTable::clear()
+{
+    for (uint32_t slot : m_handles)
+    {
+        release(slot);
+    }
+    forEachColumn([](auto& column) { column.clear(); });
+    m_index.clear();
+}
+
+EntityIndex EntityTable::append(const ObjectSnapshot& object)
+{
+    if (m_index.contains(object.guid))
+    {
+        return INVALID_ENTITY;
+    }
+    push(object);
+    return static_cast<EntityIndex>(size() - 1);
+}
+
+size_t EntityTable::append(std::span<const ObjectSnapshot> objects)
+{
+    grow(objects.size());
+
+    const size_t before = size();
+    for (const ObjectSnapshot& object : objects)
+    {
+        if (!m_index.contains(object.guid))
+        {
+            push(object);
+        }
+    }
+    return size() - before;
+}
+
+void EntityTable::update(EntityIndex index, const ObjectSnapshot& object)
+{
+    m_types[index]       = object.type;
+    m_addresses[index]   = object.address;
+    m_descriptors[index] = object.descriptors;
+    m_entries[index]     = object.entry;
+    m_x[index]           = object.x;
+    m_y[index]           = object.y;
+    m_z[index]           = object.z;
+    m_facing[index]      = object.facing;
+    m_health[index]      = object.health;
+    m_maxHealth[index]   = object.maxHealth;
+    m_level[index]       = object.level;
+    m_faction[index]     = object.faction;
+    m_flags[index]       = object.flags;
+    m_targets[index]     = object.target;
+}
+
+EntityIndex EntityTable::remove(EntityIndex index)
+{
+    const EntityIndex last = static_cast<EntityIndex>(size() - 1);
+    m_index.erase(m_guids[index]);
+    release(m_handles[index]);
+
+    if (index == last)
+    {
+        forEachColumn([](auto& column) { column.pop_back(); });
+        return INVALID_ENTITY;
+    }
+
+    forEachColumn(
+        [index](auto& column)
+        {
+            column[index] = column.back();
+            column.pop_back();
+        });
+    m_index.assign(m_guids[index], index);
+    m_rowOf[m_handles[index]] = index;
+    return last;
+}
+
+EntitySyncStats EntityTable::sync(std::span<const ObjectSnapshot> objects, WalkDetail detail)
+{
+    EntitySyncStats stats;
+
+    m_seen.assign(size(), 0);
+    m_spawn.clear();
+    for (const ObjectSnapshot& object : objects)
+    {
+        const EntityIndex index = find(object.guid);
+        if (index == INVALID_ENTITY)
+        {
+            m_spawn.push_back(&object);
+            continue;
+        }
+        m_seen[index] = 1;
+        if (detail == WalkDetail::Full || m_addresses[index] != object.address || m_types[index] != object.type ||
+            m_descriptors[index] != object.descriptors)
+        {
+            update(index, object);
+            stats.updated++;
+        }
+    }
+
+    // С конца: на место удалённой строки переносится последняя, а она уже проверена
+    for (size_t i = m_seen.size(); i-- > 0;)
+    {
+        if (!m_seen[i])
+        {
+            remove(static_cast<EntityIndex>(i));
+            stats.despawned++;
+        }
+    }
+
+    grow(m_spawn.size());
+    for (const ObjectSnapshot* object : m_spawn)
+    {
+        // Повтор GUID в одном обходе (объект пересоздан в том же тике) - берётся первый
+        if (!m_index.contains(object->guid))
+        {
+            push(*object);
+            stats.spawned++;
+        }
+    }
+    return stats;
+}
+
+EntityIndex EntityTable::find(uint64_t guid) const
+{
+    const EntityIndex* index = m_index.find(guid);
+    return index != nullptr ? *index : INVALID_ENTITY;
+}
+
+EntityIndex EntityTable::resolve(EntityHandle handle) const
+{
+    if (handle.slot >= m_generations.size() || m_generations[handle.slot] != handle.generation)
+    {
+        return INVALID_ENTITY;
+    }
+    return m_rowOf[handle.slot];
+}
+
+ObjectSnapshot EntityTable::row(EntityIndex index) const
+{
+    ObjectSnapshot object;
+    object.guid        = m_guids[index];
+    object.type        = m_types[index];
+    object.address     = m_addresses[index];
+    object.descriptors = m_descriptors[index];
+    object.entry       = m_entries[index];
+    object.x           = m_x[index];
+    object.y           = m_y[index];
+    object.z           = m_z[index];
+    object.facing      = m_facing[index];
+    object.health      = m_health[index];
+    object.maxHealth   = m_maxHealth[index];
+    object.level       = m_level[index];
+    object.faction     = m_faction[index];
+    object.flags       = m_flags[index];
+    object.target      = m_targets[index];
+    return object;
+}
+
+void EntityTable::grow(size_t count)
+{
+    const size_t required = size() + count;
+    if (required > m_guids.capacity())
+    {
+        reserve(std::max(required, m_guids.capacity() * 2));
+    }
+}
+
+void EntityTable::push(const ObjectSnapshot& object)
+{
+    const EntityIndex index = static_cast<EntityIndex>(size());
+    uint32_t          slot  = static_cast<uint32_t>(m_generations.size());
+    if (m_freeSlots.empty())
+    {
+        m_generations.push_back(0);
+        m_rowOf.push_back(index);
+    }
+    else
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_rowOf[slot] = index;
+    }
+
+    m_index.insert(object.guid, index);
+    m_guids.push_back(object.guid);
+    m_types.push_back(object.type);
+    m_addresses.push_back(object.address);
+    m_descriptors.push_back(object.descriptors);
+    m_entries.push_back(object.entry);
+    m_x.push_back(object.x);
+    m_y.push_back(object.y);
+    m_z.push_back(object.z);
+    m_facing.push_back(object.facing);
+    m_health.push_back(object.health);
+    m_maxHealth.push_back(object.maxHealth);
+    m_level.push_back(object.level);
+    m_faction.push_back(object.faction);
+    m_flags.push_back(object.flags);
+    m_targets.push_back(object.target);
+    m_handles.push_back(slot);
+}
+
+void EntityTable::release(uint32_t slot)
+{
+    m_generations[slot]++;
+    m_rowOf[slot] = INVALID_ENTITY;
+    m_freeSlots.push_back(slot);
+}
@@ -0,0 +1,223 @@
+/**
+ * @file EntityTable.hpp
+ * @brief Таблица сущностей в колоночном виде (structure of arrays)
+ * @details Пример (обновление таблицы после обхода и проход по одной колонке):
+ * @code
+ * EntityTable entities;
+ * if (walker.walk(memory))
+ * {
+ *     entities.sync(walker.objects());
+ * }
+ * const auto health = entities.health();
+ * for (size_t i = 0; i < health.size(); i++) { ... }
+ * @endcode
+ */
+#pragma once
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "GuidMap.hpp"
+#include "gui/bot/core/objects/ObjectWalker.hpp"
+
+
+/**
+ * @brief Плотный индекс строки EntityTable
+ */
+using EntityIndex = uint32_t;
+
+constexpr EntityIndex INVALID_ENTITY = std::numeric_limits<EntityIndex>::max(); ///< Нет сущности
+
+/**
+ * @brief Ссылка на сущность, которая не меняется при переносе строк
+ * @details Ручка устаревает, когда сущность удаляется из таблицы: EntityTable::resolve() возвращает
+ * INVALID_ENTITY, даже если ячейку ручки уже заняла другая сущность (у неё другое поколение)
+ */
+struct EntityHandle
+{
+    uint32_t slot{UINT32_MAX}; ///< Ячейка в таблице ручек
+    uint32_t generation{0};    ///< Поколение ячейки на момент выдачи ручки
+
+    bool operator==(const EntityHandle&) const = default;
+};
+
+/**
+ * @brief Итог EntityTable::sync()
+ */
+struct EntitySyncStats
+{
+    size_t updated{0};   ///< Строки, обновлённые из снимка (после полного обхода - все оставшиеся в списке)
+    size_t spawned{0};   ///< Добавленные сущности
+    size_t despawned{0}; ///< Удалённые сущности
+};
+
+/**
+ * @class EntityTable
+ * @brief Состояние всех видимых объектов: по колонке на поле, строка - сущность
+ * @details Каждое поле хранится отдельным плотным массивом, поэтому запрос, которому нужны только
+ * координаты или только здоровье, проходит ровно по этим колонкам и не тянет в кэш остальные поля.
+ * Индексы плотные: [0, size()). Индекс сущности не меняется, пока она в таблице, за одним исключением:
+ * remove() переносит последнюю строку на место удалённой (swap-remove) и возвращает её прежний индекс,
+ * чтобы внешние ссылки на индексы можно было исправить. Новые сущности дописываются в конец.
+ * Для ссылок, которые хранятся дольше одного обновления, есть ручки (handle()): ячейка ручки знает текущую
+ * строку сущности, а поколение ячейки растёт при каждом удалении, поэтому устаревшая ручка
+ * распознаётся за O(1). Не потокобезопасна.
+ */
+class EntityTable
+{
+  public:
+    /**
+     * @brief Количество сущностей
+     */
+    size_t size() const { return m_guids.size(); }
+    bool   empty() const { return m_guids.empty(); }
+
+    /**
+     * @brief Резервирует место во всех колонках и в индексе GUID
+     */
+    void reserve(size_t capacity);
+
+    /**
+     * @brief Удаляет все сущности (ёмкость колонок сохраняется)
+     */
+    void clear();
+
+    /**
+     * @brief Добавляет сущность
+     * @return Индекс новой строки или INVALID_ENTITY, если сущность с таким GUID уже есть
+     */
+    EntityIndex append(const ObjectSnapshot& object);
+
+    /**
+     * @brief Добавляет сущности пачкой (колонки растут один раз)
+     * @return Количество добавленных; объекты с GUID, уже имеющимся в таблице, пропускаются
+     */
+    size_t append(std::span<const ObjectSnapshot> objects);
+
+    /**
+     * @brief Перезаписывает строку значениями снимка (GUID строки не меняется)
+     */
+    void update(EntityIndex index, const ObjectSnapshot& object);
+
+    /**
+     * @brief Удаляет строку, перенося на её место последнюю
+     * @return Прежний индекс перенесённой строки (теперь она находится по index) или INVALID_ENTITY,
+     * если удалялась последняя строка
+     */
+    EntityIndex remove(EntityIndex index);
+
+    /**
+     * @brief Приводит таблицу к результату обхода списка объектов
+     * @param detail С какой детализацией получен снимок. После обхода WalkDetail::Headers поля известных
+     * объектов в снимке могут быть старше таблицы, поэтому строка обновляется, только если у объекта
+     * сменились адрес, тип или блок дескрипторов (такой объект обходчик читает целиком)
+     * @details Существующие сущности обновляются на месте, исчезнувшие удаляются, новые дописываются одной пачкой
+     */
+    EntitySyncStats sync(std::span<const ObjectSnapshot> objects, WalkDetail detail = WalkDetail::Full);
+
+    /**
+     * @brief Индекс сущности по GUID
+     * @return INVALID_ENTITY если сущности нет
+     */
+    EntityIndex find(uint64_t guid) const;
+
+    /**
+     * @brief Ручка сущности в строке index
+     */
+    EntityHandle handle(EntityIndex index) const { return {m_handles[index], m_generations[m_handles[index]]}; }
+
+    /**
+     * @brief Текущая строка сущности по ручке, за O(1)
+     * @return INVALID_ENTITY если сущность удалена (ручка устарела)
+     */
+    EntityIndex resolve(EntityHandle handle) const;
+
+    /**
+     * @brief Собирает строку в структуру (для отладки и UI; для обработки используйте колонки)
+     */
+    ObjectSnapshot row(EntityIndex index) const;
+
+    // Колонки (длина каждой - size())
+    std::span<const uint64_t>   guids() const { return m_guids; }
+    std::span<const ObjectType> types() const { return m_types; }
+    std::span<const uint32_t>   addresses() const { return m_addresses; }
+    std::span<const uint32_t>   descriptors() const { return m_descriptors; }
+    std::span<const uint32_t>   entries() const { return m_entries; }
+    std::span<const float>      x() const { return m_x; }
+    std::span<const float>      y() const { return m_y; }
+    std::span<const float>      z() const { return m_z; }
+    std::span<const float>      facing() const { return m_facing; }
+    std::span<const uint32_t>   health() const { return m_health; }
+    std::span<const uint32_t>   maxHealth() const { return m_maxHealth; }
+    std::span<const uint32_t>   level() const { return m_level; }
+    std::span<const uint32_t>   faction() const { return m_faction; }
+    std::span<const uint32_t>   flags() const { return m_flags; }
+    std::span<const uint64_t>   targets() const { return m_targets; }
+
+  private:
+    /**
+     * @brief Вызывает f для каждой колонки
+     */
+    template <typename F>
+    void forEachColumn(F&& f)
+    {
+        f(m_guids);
+        f(m_types);
+        f(m_addresses);
+        f(m_descriptors);
+        f(m_entries);
+        f(m_x);
+        f(m_y);
+        f(m_z);
+        f(m_facing);
+        f(m_health);
+        f(m_maxHealth);
+        f(m_level);
+        f(m_faction);
+        f(m_flags);
+        f(m_targets);
+        f(m_handles);
+    }
+
+    /**
+     * @brief Готовит колонки к добавлению count строк (с геометрическим ростом ёмкости)
+     */
+    void grow(size_t count);
+
+    /**
+     * @brief Дописывает строку без проверки GUID
+     */
+    void push(const ObjectSnapshot& object);
+
+    /**
+     * @brief Освобождает ячейку ручки удаляемой сущности (ручки на неё устаревают)
+     */
+    void release(uint32_t slot);
+
+    std::vector<uint64_t>   m_guids;       ///< GUID
+    std::vector<ObjectType> m_types;       ///< Тип объекта
+    std::vector<uint32_t>   m_addresses;   ///< Адрес объекта в памяти клиента
+    std::vector<uint32_t>   m_descriptors; ///< Адрес блока дескрипторов
+    std::vector<uint32_t>   m_entries;     ///< Идентификатор шаблона
+    std::vector<float>      m_x;           ///< Координата X
+    std::vector<float>      m_y;           ///< Координата Y
+    std::vector<float>      m_z;           ///< Координата Z
+    std::vector<float>      m_facing;      ///< Направление
+    std::vector<uint32_t>   m_health;      ///< Текущее здоровье
+    std::vector<uint32_t>   m_maxHealth;   ///< Максимальное здоровье
+    std::vector<uint32_t>   m_level;       ///< Уровень
+    std::vector<uint32_t>   m_faction;     ///< Шаблон фракции
+    std::vector<uint32_t>   m_flags;       ///< UNIT_FIELD_FLAGS
+    std::vector<uint64_t>   m_targets;     ///< GUID цели
+    std::vector<uint32_t>   m_handles;     ///< Ячейка ручки
+
+    GuidMap<EntityIndex>               m_index;       ///< GUID -> индекс строки
+    std::vector<EntityIndex>           m_rowOf;       ///< Ячейка ручки -> строка
+    std::vector<uint32_t>              m_generations; ///< Поколение ячейки ручки
+    std::vector<uint32_t>              m_freeSlots;   ///< Свободные ячейки ручек
+    std::vector<uint8_t>               m_seen;        ///< Отметки sync() (переиспользуются)
+    std::vector<const ObjectSnapshot*> m_spawn;       ///< Новые объекты sync() (переиспользуются)
+};
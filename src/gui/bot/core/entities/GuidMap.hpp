@@ -0,0 +1,320 @@
+/**
+ * @file GuidMap.hpp
+ * @brief Хэш-таблица с открытой адресацией для 64-битных GUID
+ * @details Пример:
+ * @code
+ * GuidMap<EntityIndex> index(4096); // ёмкость резервируется один раз
+ * index.assign(guid, row);
+ * if (const EntityIndex* found = index.find(guid)) { ... }
+ * index.erase(guid);
+ * @endcode
+ */
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define MDBOT_GUIDMAP_X86 1
+#include <immintrin.h>
+#endif
+
+
+/**
+ * @class GuidMap
+ * @brief Плоская хэш-таблица GUID -> V с линейным пробированием группами по 16 ячеек
+ * @tparam V Значение (перемещаемое и конструируемое по умолчанию)
+ * @details Ключи, значения и управляющие байты лежат в трёх плоских массивах. Управляющий байт ячейки -
+ * 7 старших бит хэша ключа или EMPTY. Поиск сравнивает 16 управляющих байт за одну SSE2-инструкцию
+ * и читает ключи только совпавших ячеек; встреченная в группе пустая ячейка завершает поиск.
+ * Первые GROUP_SIZE управляющих байт продублированы после конца массива, поэтому группа читается
+ * одной невыровненной загрузкой и у конца таблицы.
+ * Удаление не оставляет надгробий: следующие ячейки серии сдвигаются назад (backward shift), так что
+ * после любого количества появлений и исчезновений объектов длина пробирования не растёт.
+ * Ёмкость - степень двойки, заполнение не больше 7/8. Таблица не сжимается; её рассчитано резервировать
+ * один раз (reserve() или конструктор) под наибольшее ожидаемое число объектов. Рост при нехватке места
+ * считается в rehashes(), чтобы заниженный резерв был заметен. Не потокобезопасна.
+ */
+template <typename V>
+class GuidMap
+{
+  public:
+    static constexpr size_t GROUP_SIZE = 16; ///< Ячеек в группе пробирования
+
+    /**
+     * @brief Конструктор
+     * @param capacity Количество элементов, которое поместится без роста
+     */
+    explicit GuidMap(size_t capacity = 0) { reserve(capacity); }
+
+    /**
+     * @brief Количество элементов
+     */
+    size_t size() const { return m_size; }
+    bool   empty() const { return m_size == 0; }
+
+    /**
+     * @brief Количество ячеек
+     */
+    size_t capacity() const { return m_keys.size(); }
+
+    /**
+     * @brief Количество перестроений таблицы из-за нехватки места
+     */
+    uint64_t rehashes() const { return m_rehashes; }
+
+    /**
+     * @brief Гарантирует место для count элементов без роста
+     */
+    void reserve(size_t count)
+    {
+        size_t slots = std::bit_ceil(std::max(GROUP_SIZE, count + count / 7 + 1));
+        if (slots > capacity())
+        {
+            rehash(slots);
+        }
+    }
+
+    /**
+     * @brief Удаляет все элементы (ёмкость сохраняется)
+     */
+    void clear()
+    {
+        std::fill(m_control.begin(), m_control.end(), EMPTY);
+        m_size = 0;
+    }
+
+    /**
+     * @brief Значение по ключу
+     * @return nullptr если ключа нет; указатель действителен до следующего изменения таблицы
+     */
+    V* find(uint64_t key)
+    {
+        const size_t slot = locate(key);
+        return slot != NPOS ? &m_values[slot] : nullptr;
+    }
+
+    const V* find(uint64_t key) const
+    {
+        const size_t slot = locate(key);
+        return slot != NPOS ? &m_values[slot] : nullptr;
+    }
+
+    bool contains(uint64_t key) const { return locate(key) != NPOS; }
+
+    /**
+     * @brief Добавляет элемент, если ключа ещё нет
+     * @return Значение в таблице и true, если элемент добавлен (false - ключ уже был, значение не изменено)
+     */
+    std::pair<V*, bool> insert(uint64_t key, V value)
+    {
+        const size_t found = locate(key);
+        if (found != NPOS)
+        {
+            return {&m_values[found], false};
+        }
+        return {&m_values[place(key, std::move(value))], true};
+    }
+
+    /**
+     * @brief Добавляет элемент или заменяет значение существующего
+     */
+    void assign(uint64_t key, V value)
+    {
+        const size_t found = locate(key);
+        if (found != NPOS)
+        {
+            m_values[found] = std::move(value);
+            return;
+        }
+        place(key, std::move(value));
+    }
+
+    /**
+     * @brief Удаляет элемент
+     * @return false если ключа не было
+     */
+    bool erase(uint64_t key)
+    {
+        size_t hole = locate(key);
+        if (hole == NPOS)
+        {
+            return false;
+        }
+
+        // Элемент серии переносится в дыру, если дыра лежит между его домашней ячейкой и им самим
+        const size_t mask = capacity() - 1;
+        for (size_t next = (hole + 1) & mask; m_control[next] != EMPTY; next = (next + 1) & mask)
+        {
+            const size_t home = homeOf(hash(m_keys[next]));
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                m_keys[hole]   = m_keys[next];
+                m_values[hole] = std::move(m_values[next]);
+                setControl(hole, m_control[next]);
+                hole = next;
+            }
+        }
+        setControl(hole, EMPTY);
+        m_size--;
+        return true;
+    }
+
+    /**
+     * @brief Вызывает f(key, value) для каждого элемента (порядок не определён)
+     */
+    template <typename F>
+    void forEach(F&& f) const
+    {
+        for (size_t slot = 0; slot < capacity(); slot++)
+        {
+            if (m_control[slot] != EMPTY)
+            {
+                f(m_keys[slot], m_values[slot]);
+            }
+        }
+    }
+
+  private:
+    static constexpr uint8_t EMPTY = 0x80;     ///< Управляющий байт свободной ячейки
+    static constexpr size_t  NPOS  = SIZE_MAX; ///< Ключ не найден
+
+    /**
+     * @brief Хэш GUID: младшие биты GUID (счётчик) перемешиваются по всему слову
+     */
+    static uint64_t hash(uint64_t key) { return key * 0x9E3779B97F4A7C15ull; }
+
+    /**
+     * @brief Управляющий байт: 7 старших бит хэша
+     */
+    static uint8_t tagOf(uint64_t hash) { return static_cast<uint8_t>(hash >> 57); }
+
+    /**
+     * @brief Домашняя ячейка: следующие за тегом биты хэша
+     */
+    size_t homeOf(uint64_t hash) const { return static_cast<size_t>((hash << 7) >> m_shift); }
+
+    /**
+     * @brief Биты группы, у которых управляющий байт равен value
+     */
+    uint32_t match(size_t slot, uint8_t value) const
+    {
+        const uint8_t* group = m_control.data() + slot;
+#ifdef MDBOT_GUIDMAP_X86
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(value)))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_SIZE; i++)
+        {
+            mask |= static_cast<uint32_t>(group[i] == value) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief Ячейка ключа или NPOS
+     */
+    size_t locate(uint64_t key) const
+    {
+        if (m_size == 0)
+        {
+            return NPOS;
+        }
+
+        const uint64_t h    = hash(key);
+        const uint8_t  tag  = tagOf(h);
+        const size_t   mask = capacity() - 1;
+        for (size_t slot = homeOf(h);; slot = (slot + GROUP_SIZE) & mask)
+        {
+            for (uint32_t found = match(slot, tag); found != 0; found &= found - 1)
+            {
+                const size_t candidate = (slot + std::countr_zero(found)) & mask;
+                if (m_keys[candidate] == key)
+                {
+                    return candidate;
+                }
+            }
+            // Серия без пустых ячеек не прерывается: пустая ячейка значит, что ключа нет
+            if (match(slot, EMPTY) != 0)
+            {
+                return NPOS;
+            }
+        }
+    }
+
+    /**
+     * @brief Кладёт отсутствующий ключ в первую свободную ячейку после домашней
+     */
+    size_t place(uint64_t key, V&& value)
+    {
+        if ((m_size + 1) * 8 > capacity() * 7)
+        {
+            rehash(std::max(GROUP_SIZE, capacity() * 2));
+            m_rehashes++;
+        }
+
+        const uint64_t h    = hash(key);
+        const size_t   mask = capacity() - 1;
+        size_t         slot = homeOf(h);
+        for (uint32_t empty = match(slot, EMPTY); empty == 0; empty = match(slot, EMPTY))
+        {
+            slot = (slot + GROUP_SIZE) & mask;
+        }
+        slot = (slot + std::countr_zero(match(slot, EMPTY))) & mask;
+
+        m_keys[slot]   = key;
+        m_values[slot] = std::move(value);
+        setControl(slot, tagOf(h));
+        m_size++;
+        return slot;
+    }
+
+    /**
+     * @brief Записывает управляющий байт и его копию за концом массива
+     */
+    void setControl(size_t slot, uint8_t value)
+    {
+        m_control[slot] = value;
+        if (slot < GROUP_SIZE)
+        {
+            m_control[capacity() + slot] = value;
+        }
+    }
+
+    /**
+     * @brief Переносит элементы в таблицу из slots ячеек
+     */
+    void rehash(size_t slots)
+    {
+        std::vector<uint64_t> keys    = std::move(m_keys);
+        std::vector<V>        values  = std::move(m_values);
+        std::vector<uint8_t>  control = std::move(m_control);
+
+        m_keys.assign(slots, 0);
+        m_values.assign(slots, V{});
+        m_control.assign(slots + GROUP_SIZE, EMPTY);
+        m_shift = 64 - std::countr_zero(slots);
+        m_size  = 0;
+
+        for (size_t slot = 0; slot < keys.size(); slot++)
+        {
+            if (control[slot] != EMPTY)
+            {
+                place(keys[slot], std::move(values[slot]));
+            }
+        }
+    }
+
+    std::vector<uint64_t> m_keys;        ///< Ключи
+    std::vector<V>        m_values;      ///< Значения
+    std::vector<uint8_t>  m_control;     ///< Управляющие байты (+ копия первой группы)
+    size_t                m_size{0};     ///< Количество элементов
+    uint32_t              m_shift{64};   ///< 64 - log2(ёмкость)
+    uint64_t              m_rehashes{0}; ///< Перестроения из-за нехватки места
+};
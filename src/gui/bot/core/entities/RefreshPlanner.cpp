@@ -0,0 +1,289 @@
+#include "RefreshPlanner.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include "core/memory/MemoryManager.hpp"
+
+
+namespace
+{
+    bool isUnit(ObjectType type)
+    {
+        return type == ObjectType::Unit || type == ObjectType::Player;
+    }
+} // namespace
+
+
+RefreshPlanner::RefreshPlanner(const RefreshPolicy& policy) : m_policy(policy) {}
+
+bool RefreshPlanner::tick(MemoryManager& memory, ObjectWalker& walker, EntityTable& table, SpatialGrid& grid)
+{
+    m_stats = RefreshPlannerStats{m_stats.ticks + 1, m_stats.walks};
+    m_error.clear();
+
+    size_t fresh = table.size();
+    if (m_walkPending || ++m_sinceWalk >= std::max(1u, m_policy.walkInterval))
+    {
+        if (!walk(memory, walker, table, grid, fresh))
+        {
+            return false;
+        }
+    }
+
+    const size_t count = table.size();
+    markHot(table, grid, walker.localGuid());
+
+    auto plan = [this](EntityIndex index, RefreshTier tier)
+    {
+        Pending& pending = m_pending.emplace_back();
+        pending.index    = index;
+        pending.tier     = tier;
+    };
+
+    // Запрошенные сущности читаются целиком; это чтение покрывает и горячие поля
+    m_pending.clear();
+    m_planned.assign(count, 0);
+    for (EntityHandle handle : m_demand)
+    {
+        const EntityIndex index = table.resolve(handle);
+        if (index != INVALID_ENTITY && !m_planned[index])
+        {
+            m_planned[index] = 1;
+            plan(index, RefreshTier::Cold);
+        }
+    }
+    m_demand.clear();
+
+    // Строки, дописанные обходом этого тика, уже прочитаны целиком
+    const uint32_t warmInterval = std::max(1u, m_policy.warmInterval);
+    const auto     types        = table.types();
+    for (size_t i = 0; i < count; i++)
+    {
+        const EntityIndex index = static_cast<EntityIndex>(i);
+        if (m_planned[i] || !isUnit(types[i]))
+        {
+            continue;
+        }
+        if (m_hot[i])
+        {
+            plan(index, RefreshTier::Hot);
+        }
+        else if (i < fresh && (m_stats.ticks + table.handle(index).slot) % warmInterval == 0)
+        {
+            plan(index, RefreshTier::Warm);
+        }
+    }
+
+    // Адреса буферов берутся после того, как план перестал расти
+    m_reads.clear();
+    for (Pending& pending : m_pending)
+    {
+        queue(table, pending);
+    }
+    if (!m_reads.empty())
+    {
+        const BatchReadStats batch = memory.ReadBatch(m_reads);
+        m_stats.reads += batch.mergedReads;
+        m_stats.bytes  = batch.bytesRead;
+    }
+
+    m_stale.clear();
+    for (const Pending& pending : m_pending)
+    {
+        if (!apply(table, pending))
+        {
+            m_stale.push_back(pending.index);
+            continue;
+        }
+        switch (pending.tier)
+        {
+            case RefreshTier::Hot:
+                m_stats.hot++;
+                break;
+            case RefreshTier::Warm:
+                m_stats.warm++;
+                break;
+            case RefreshTier::Cold:
+                m_stats.requested++;
+                break;
+        }
+    }
+
+    // Исчезнувшие - с конца: swap-remove переносит на место удалённой строки последнюю, а она уже проверена.
+    // Обходчик перечитает объект по этому адресу целиком, если он ещё в списке
+    std::sort(m_stale.begin(), m_stale.end(), std::greater<>());
+    for (EntityIndex index : m_stale)
+    {
+        walker.invalidate(table.addresses()[index]);
+        table.remove(index);
+    }
+    if (!m_stale.empty())
+    {
+        m_stats.stale = m_stale.size();
+        m_walkPending = true;
+    }
+
+    grid.update(table);
+    return true;
+}
+
+void RefreshPlanner::request(EntityHandle handle)
+{
+    m_demand.push_back(handle);
+}
+
+void RefreshPlanner::reset()
+{
+    m_walkPending = true;
+    m_demand.clear();
+}
+
+bool RefreshPlanner::walk(MemoryManager& memory,
+                          ObjectWalker&  walker,
+                          EntityTable&   table,
+                          SpatialGrid&   grid,
+                          size_t&        fresh)
+{
+    m_sinceWalk   = 0;
+    m_walkPending = false;
+    m_stats.walks++;
+
+    const bool walked = walker.walk(memory, WalkDetail::Headers);
+    m_stats.reads += walker.stats().reads;
+    m_error        = walker.error();
+    if (!walked)
+    {
+        // Персонаж не в мире: список проверяется каждый тик, пока он не появится
+        table.clear();
+        grid.clear();
+        m_demand.clear();
+        m_walkPending = true;
+        return false;
+    }
+
+    // После смены зоны почти все сущности новые - сетку дешевле построить заново
+    const EntitySyncStats sync = table.sync(walker.objects(), WalkDetail::Headers);
+    if (sync.spawned > table.size() / 2)
+    {
+        grid.rebuild(table);
+    }
+    else
+    {
+        grid.update(table);
+    }
+    fresh = table.size() - sync.spawned;
+    return true;
+}
+
+void RefreshPlanner::markHot(const EntityTable& table, const SpatialGrid& grid, uint64_t localGuid)
+{
+    m_hot.assign(table.size(), 0);
+
+    const EntityIndex local = table.find(localGuid);
+    if (local == INVALID_ENTITY)
+    {
+        return;
+    }
+    m_hot[local] = 1;
+
+    const EntityIndex target = table.find(table.targets()[local]);
+    if (target != INVALID_ENTITY)
+    {
+        m_hot[target] = 1;
+    }
+
+    // Цель тёплого существа обновляется раз в warmInterval тиков, поэтому напавший становится
+    // горячим с такой задержкой
+    SpatialFilter units;
+    units.types   = SpatialFilter::typeBit(ObjectType::Unit) | SpatialFilter::typeBit(ObjectType::Player);
+    units.exclude = local;
+    grid.radius(table, table.x()[local], table.y()[local], m_policy.hotRange, units, m_nearby);
+
+    const auto targets = table.targets();
+    for (EntityIndex index : m_nearby)
+    {
+        if (targets[index] == localGuid)
+        {
+            m_hot[index] = 1;
+        }
+    }
+}
+
+void RefreshPlanner::queue(const EntityTable& table, Pending& pending)
+{
+    const ObjectType type    = table.types()[pending.index];
+    const uint32_t   address = table.addresses()[pending.index];
+
+    // Дескрипторы читаются всегда: их начало содержит GUID, по которому распознаётся исчезнувший объект
+    uint32_t descriptorsEnd = ObjectDescriptorLayout::END;
+    if (isUnit(type))
+    {
+        descriptorsEnd = pending.tier == RefreshTier::Cold ? UnitDescriptorLayout::END : UnitHotDescriptorLayout::END;
+    }
+    pending.descriptorRequest = m_reads.size();
+    m_reads.push_back(ReadRequest{table.descriptors()[pending.index], descriptorsEnd, pending.descriptors.data()});
+
+    // Координаты игровых объектов не меняются - только при чтении целиком
+    uint32_t position = 0;
+    uint32_t size     = 0;
+    if (isUnit(type))
+    {
+        position = UnitPositionLayout::BEGIN;
+        size     = UnitPositionLayout::SIZE;
+    }
+    else if (type == ObjectType::GameObject && pending.tier == RefreshTier::Cold)
+    {
+        position = GameObjectPositionLayout::BEGIN;
+        size     = GameObjectPositionLayout::SIZE;
+    }
+    if (size != 0)
+    {
+        pending.positionRequest = m_reads.size();
+        m_reads.push_back(ReadRequest{address + position, size, pending.position.data()});
+    }
+}
+
+bool RefreshPlanner::apply(EntityTable& table, const Pending& pending) const
+{
+    if (!m_reads[pending.descriptorRequest].succeeded ||
+        (pending.positionRequest != SIZE_MAX && !m_reads[pending.positionRequest].succeeded))
+    {
+        return false;
+    }
+
+    // Дескрипторы начинаются с GUID: другой GUID - объект по этому адресу уже другой
+    ObjectSnapshot object = table.row(pending.index);
+    const uint64_t guid   = object.guid;
+    if (!object.isUnit())
+    {
+        ObjectDescriptorLayout::decode(pending.descriptors.data(), object);
+    }
+    else if (pending.tier == RefreshTier::Cold)
+    {
+        UnitDescriptorLayout::decode(pending.descriptors.data(), object);
+    }
+    else
+    {
+        UnitHotDescriptorLayout::decode(pending.descriptors.data(), object);
+    }
+    if (object.guid != guid)
+    {
+        return false;
+    }
+
+    if (pending.positionRequest != SIZE_MAX)
+    {
+        if (object.isUnit())
+        {
+            UnitPositionLayout::decode(pending.position.data(), object);
+        }
+        else
+        {
+            GameObjectPositionLayout::decode(pending.position.data(), object);
+        }
+    }
+
+    table.update(pending.index, object);
+    return true;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file RefreshPlanner.hpp
+ * @brief Поуровневое обновление сущностей: горячие поля каждый тик, остальное реже или по запросу
+ * @details Пример (вместо полного обхода списка объектов каждый тик):
+ * @code
+ * RefreshPlanner planner;
+ * if (!planner.tick(memory, walker, entities, grid))
+ * {
+ *     // персонаж не в мире: таблица и сетка очищены
+ * }
+ * planner.request(entities.handle(index)); // уровень, фракция и т.п. - в следующем тике
+ * @endcode
+ */
+#pragma once
+#include <array>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EntityTable.hpp"
+#include "SpatialGrid.hpp"
+#include "core/memory/ReadBatch.hpp"
+
+class MemoryManager;
+
+
+/**
+ * @brief Уровень обновления сущности
+ */
+enum class RefreshTier : uint8_t
+{
+    Hot,  ///< Каждый тик: координаты, здоровье, цель
+    Warm, ///< Те же поля раз в RefreshPolicy::warmInterval тиков
+    Cold  ///< Только при появлении и по запросу (всё остальное и объекты без подвижных полей)
+};
+
+/**
+ * @brief Параметры RefreshPlanner
+ */
+struct RefreshPolicy
+{
+    float    hotRange{40.0f};  ///< Радиус, в котором существа, выбравшие целью игрока, становятся горячими
+    uint32_t warmInterval{8};  ///< Тёплые сущности перечитываются раз в столько тиков
+    uint32_t walkInterval{16}; ///< Список объектов обходится раз в столько тиков
+};
+
+/**
+ * @brief Счётчики RefreshPlanner
+ * @details Все поля, кроме ticks и walks, описывают только последний вызов tick()
+ */
+struct RefreshPlannerStats
+{
+    uint64_t ticks{0};     ///< Вызовы tick()
+    uint64_t walks{0};     ///< Обходы списка объектов
+    size_t   hot{0};       ///< Перечитанные горячие сущности
+    size_t   warm{0};      ///< Перечитанные тёплые сущности
+    size_t   requested{0}; ///< Сущности, перечитанные целиком по request()
+    size_t   stale{0};     ///< Сущности, удалённые как исчезнувшие (чтение не удалось или сменился GUID)
+    size_t   reads{0};     ///< Фактические чтения памяти клиента (обход и пакет обновления)
+    size_t   bytes{0};     ///< Байты, прочитанные пакетом обновления
+};
+
+/**
+ * @class RefreshPlanner
+ * @brief Решает, какие сущности и какие их поля перечитывать в каждом тике
+ * @details Полный обход списка объектов перечитывает каждый тик каждое поле каждого объекта, хотя почти
+ * все объекты (предметы в сумках, игровые объекты, далёкие существа) между тиками не меняются. Планировщик
+ * разносит сущности по уровням:
+ * - горячие (сам игрок, его цель и существа в радиусе hotRange, выбравшие целью игрока) - координаты,
+ *   направление, цель и здоровье каждый тик;
+ * - тёплые (остальные существа и игроки) - те же поля раз в warmInterval тиков; тики разных сущностей
+ *   разнесены по номеру ячейки ручки, поэтому нагрузка ровная;
+ * - холодные поля (шаблон, уровень, фракция, максимум здоровья, флаги) и объекты без подвижных полей
+ *   читаются при появлении объекта и по request().
+ * Список объектов обходится раз в walkInterval тиков в режиме WalkDetail::Headers - только ради
+ * появления и исчезновения объектов. Исчезновение между обходами распознаётся при чтении: каждое чтение
+ * дескрипторов включает GUID, и если он сменился или чтение не удалось, сущность сразу удаляется из таблицы
+ * (ручки на неё устаревают), а следующий тик обходит список. Имени в таблице нет: имена игроков берутся
+ * из кэша имён, а не из объекта.
+ * Менеджер памяти, обходчик, таблица и сетка не хранятся, а передаются в tick(). Не потокобезопасен.
+ */
+class RefreshPlanner
+{
+  public:
+    /**
+     * @brief Конструктор
+     */
+    explicit RefreshPlanner(const RefreshPolicy& policy = RefreshPolicy{});
+
+    /**
+     * @brief Обновляет таблицу и сетку на один тик
+     * @return false если менеджер объектов недоступен (персонаж не в мире); таблица и сетка при этом пусты
+     */
+    bool tick(MemoryManager& memory, ObjectWalker& walker, EntityTable& table, SpatialGrid& grid);
+
+    /**
+     * @brief Перечитать сущность целиком (включая холодные поля) в следующем тике
+     * @details Устаревшая к тому времени ручка пропускается
+     */
+    void request(EntityHandle handle);
+
+    /**
+     * @brief Следующий тик обойдёт список объектов (например, после смены зоны)
+     */
+    void reset();
+
+    /**
+     * @brief Параметры
+     */
+    const RefreshPolicy& policy() const { return m_policy; }
+    void                 setPolicy(const RefreshPolicy& policy) { m_policy = policy; }
+
+    /**
+     * @brief Счётчики
+     */
+    const RefreshPlannerStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Описание последней ошибки (в том числе ошибки обхода)
+     */
+    const std::string& error() const { return m_error; }
+
+  private:
+    /**
+     * @brief Перечитываемая в этом тике сущность
+     */
+    struct Pending
+    {
+        EntityIndex index{INVALID_ENTITY};       ///< Строка таблицы
+        RefreshTier tier{RefreshTier::Warm};     ///< Уровень (Cold - чтение целиком по request())
+        size_t      descriptorRequest{SIZE_MAX}; ///< Запрос дескрипторов в m_reads
+        size_t      positionRequest{SIZE_MAX};   ///< Запрос координат в m_reads
+
+        std::array<uint8_t, UnitDescriptorLayout::SIZE> descriptors; ///< Начало дескрипторов
+        std::array<uint8_t, UnitPositionLayout::SIZE>   position;    ///< Координаты (и направление существа)
+    };
+
+    /**
+     * @brief Обходит список объектов и переносит его состав в таблицу и сетку
+     * @param fresh Первая строка, дописанная обходом (такие строки только что прочитаны целиком)
+     */
+    bool walk(MemoryManager& memory, ObjectWalker& walker, EntityTable& table, SpatialGrid& grid, size_t& fresh);
+
+    /**
+     * @brief Отмечает горячие сущности в m_hot
+     */
+    void markHot(const EntityTable& table, const SpatialGrid& grid, uint64_t localGuid);
+
+    /**
+     * @brief Добавляет в m_reads чтения сущности
+     */
+    void queue(const EntityTable& table, Pending& pending);
+
+    /**
+     * @brief Переносит прочитанные поля в таблицу
+     * @return false если сущность исчезла (чтение не удалось или сменился GUID)
+     */
+    bool apply(EntityTable& table, const Pending& pending) const;
+
+    RefreshPolicy             m_policy;            ///< Параметры
+    uint32_t                  m_sinceWalk{0};      ///< Тиков с последнего обхода
+    bool                      m_walkPending{true}; ///< Обойти список в следующем тике
+    std::vector<EntityHandle> m_demand;            ///< Ручки из request()
+    std::vector<uint8_t>      m_hot;               ///< Отметки горячих строк (переиспользуются)
+    std::vector<uint8_t>      m_planned;           ///< Строки, уже попавшие в план тика (переиспользуются)
+    std::vector<EntityIndex>  m_nearby;            ///< Результат запроса к сетке (переиспользуется)
+    std::vector<Pending>      m_pending;           ///< План тика
+    std::vector<ReadRequest>  m_reads;             ///< Запросы пакета обновления
+    std::vector<EntityIndex>  m_stale;             ///< Исчезнувшие строки
+    RefreshPlannerStats       m_stats;             ///< Счётчики
+    std::string               m_error;             ///< Последняя ошибка
+};
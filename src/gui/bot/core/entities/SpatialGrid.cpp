@@ -0,0 +1,387 @@
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+
+namespace
+{
+    constexpr float  MAX_CELL      = 1.0e6f; ///< Предел номера ячейки (защита от мусора в координатах)
+    constexpr size_t PARALLEL_STEP = 1024;   ///< Наименьшая часть работы одного потока в rebuild()
+
+    /**
+     * @brief Выполняет fn(begin, end) для частей диапазона [0, count) в пуле потоков
+     */
+    template <typename Fn>
+    void parallelChunks(size_t count, size_t chunkSize, unsigned threads, Fn&& fn)
+    {
+        const size_t chunks = (count + chunkSize - 1) / chunkSize;
+        threads             = static_cast<unsigned>(std::min<size_t>(threads, chunks));
+
+        std::atomic<size_t> nextChunk{0};
+        auto                worker = [&]()
+        {
+            for (size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++)
+            {
+                fn(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned i = 1; i < threads; i++)
+        {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+    }
+} // namespace
+
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 16.0f), m_inverse(1.0f / m_cellSize), m_buckets(BUCKET_COUNT)
+{
+}
+
+void SpatialGrid::update(const EntityTable& table)
+{
+    const size_t count = table.size();
+    m_stats.updates++;
+
+    // Таблица укоротилась (swap-remove): хвостовых строк больше нет
+    for (size_t i = m_bucketOf.size(); i > count; i--)
+    {
+        if (m_bucketOf[i - 1] != NO_BUCKET)
+        {
+            unlink(static_cast<EntityIndex>(i - 1));
+        }
+    }
+    m_bucketOf.resize(count, NO_BUCKET);
+    m_slotOf.resize(count, 0);
+
+    // Строка могла сменить ячейку или сущность (на её место перенесена другая) - в обоих случаях
+    // важна только новая корзина строки
+    for (size_t i = 0; i < count; i++)
+    {
+        const EntityIndex index  = static_cast<EntityIndex>(i);
+        const uint16_t    bucket = bucketFor(table, index);
+        if (bucket == m_bucketOf[i])
+        {
+            continue;
+        }
+
+        if (m_bucketOf[i] != NO_BUCKET)
+        {
+            unlink(index);
+        }
+        if (bucket != NO_BUCKET)
+        {
+            link(index, bucket);
+        }
+        m_stats.moves++;
+    }
+}
+
+void SpatialGrid::rebuild(const EntityTable& table, unsigned threads)
+{
+    const size_t count = table.size();
+    m_stats.rebuilds++;
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, (count + PARALLEL_STEP - 1) / PARALLEL_STEP));
+    threads = std::max(1u, threads);
+
+    for (auto& bucket : m_buckets)
+    {
+        bucket.clear();
+    }
+    m_bucketOf.resize(count);
+    m_slotOf.resize(count);
+
+    // Корзины строк считаются частями таблицы, затем каждый поток заполняет свой диапазон корзин:
+    // потоки не пишут в общие корзины, порядок строк в корзине совпадает с порядком таблицы
+    parallelChunks(count,
+                   PARALLEL_STEP,
+                   threads,
+                   [&](size_t begin, size_t end)
+                   {
+                       for (size_t i = begin; i < end; i++)
+                       {
+                           m_bucketOf[i] = bucketFor(table, static_cast<EntityIndex>(i));
+                       }
+                   });
+
+    parallelChunks(BUCKET_COUNT,
+                   (BUCKET_COUNT + threads - 1) / threads,
+                   threads,
+                   [&](size_t begin, size_t end)
+                   {
+                       for (size_t i = 0; i < count; i++)
+                       {
+                           const uint16_t bucket = m_bucketOf[i];
+                           if (bucket >= begin && bucket < end)
+                           {
+                               m_slotOf[i] = static_cast<uint32_t>(m_buckets[bucket].size());
+                               m_buckets[bucket].push_back(static_cast<EntityIndex>(i));
+                           }
+                       }
+                   });
+
+    m_stats.indexed = static_cast<size_t>(
+        std::count_if(m_bucketOf.begin(), m_bucketOf.end(), [](uint16_t bucket) { return bucket != NO_BUCKET; }));
+}
+
+void SpatialGrid::clear()
+{
+    for (auto& bucket : m_buckets)
+    {
+        bucket.clear();
+    }
+    m_bucketOf.clear();
+    m_slotOf.clear();
+    m_stats.indexed = 0;
+}
+
+template <typename Visit>
+void SpatialGrid::forEachInRange(const EntityTable&   table,
+                                 float                x,
+                                 float                y,
+                                 float                range,
+                                 const SpatialFilter& filter,
+                                 Visit&&              visit) const
+{
+    if (!(range >= 0.0f))
+    {
+        return;
+    }
+
+    const auto  xs           = table.x();
+    const auto  ys           = table.y();
+    const auto  types        = table.types();
+    const auto  flags        = table.flags();
+    const float rangeSquared = range * range;
+
+    auto visitBucket = [&](const std::vector<EntityIndex>& bucket)
+    {
+        for (EntityIndex index : bucket)
+        {
+            const float dx       = xs[index] - x;
+            const float dy       = ys[index] - y;
+            const float distance = dx * dx + dy * dy;
+            if (distance <= rangeSquared && filter.accepts(index, types[index], flags[index]))
+            {
+                visit(index, dx, dy, distance);
+            }
+        }
+    };
+
+    const int32_t x0 = cellOf(x - range);
+    const int32_t x1 = cellOf(x + range);
+    const int32_t y0 = cellOf(y - range);
+    const int32_t y1 = cellOf(y + range);
+    if (int64_t{x1} - x0 >= static_cast<int64_t>(GRID_SIZE) || int64_t{y1} - y0 >= static_cast<int64_t>(GRID_SIZE))
+    {
+        // Диапазон шире сетки - каждая корзина просматривается один раз
+        for (const auto& bucket : m_buckets)
+        {
+            visitBucket(bucket);
+        }
+        return;
+    }
+
+    for (int32_t cy = y0; cy <= y1; cy++)
+    {
+        for (int32_t cx = x0; cx <= x1; cx++)
+        {
+            visitBucket(m_buckets[bucketOf(cx, cy)]);
+        }
+    }
+}
+
+void SpatialGrid::radius(const EntityTable&        table,
+                         float                     x,
+                         float                     y,
+                         float                     range,
+                         const SpatialFilter&      filter,
+                         std::vector<EntityIndex>& result) const
+{
+    result.clear();
+    forEachInRange(
+        table, x, y, range, filter, [&](EntityIndex index, float, float, float) { result.push_back(index); });
+}
+
+void SpatialGrid::cone(const EntityTable&        table,
+                       float                     x,
+                       float                     y,
+                       float                     facing,
+                       float                     halfAngle,
+                       float                     range,
+                       const SpatialFilter&      filter,
+                       std::vector<EntityIndex>& result) const
+{
+    result.clear();
+
+    // Угол между осью сектора и направлением на сущность не больше halfAngle:
+    // (dx, dy) * (cos, sin) >= |d| * cos(halfAngle); сравнение без корня
+    const float dirX   = std::cos(facing);
+    const float dirY   = std::sin(facing);
+    const float cosine = std::cos(std::clamp(halfAngle, 0.0f, 3.14159265f));
+
+    forEachInRange(table,
+                   x,
+                   y,
+                   range,
+                   filter,
+                   [&](EntityIndex index, float dx, float dy, float distanceSquared)
+                   {
+                       const float projection = dx * dirX + dy * dirY;
+                       const float bound      = cosine * cosine * distanceSquared;
+                       const bool  inside     = cosine >= 0.0f ? projection >= 0.0f && projection * projection >= bound
+                                                               : projection >= 0.0f || projection * projection <= bound;
+                       if (inside || distanceSquared == 0.0f)
+                       {
+                           result.push_back(index);
+                       }
+                   });
+}
+
+void SpatialGrid::nearest(const EntityTable&        table,
+                          float                     x,
+                          float                     y,
+                          size_t                    k,
+                          float                     range,
+                          const SpatialFilter&      filter,
+                          std::vector<EntityIndex>& result) const
+{
+    result.clear();
+    m_candidates.clear();
+    if (k == 0 || !(range >= 0.0f))
+    {
+        return;
+    }
+
+    const auto  xs           = table.x();
+    const auto  ys           = table.y();
+    const auto  types        = table.types();
+    const auto  flags        = table.flags();
+    const float rangeSquared = range * range;
+    const auto  byDistance   = [](const auto& left, const auto& right) { return left.first < right.first; };
+
+    // Кандидаты - max-куча по расстоянию размером не больше k
+    auto consider = [&](EntityIndex index)
+    {
+        if (!filter.accepts(index, types[index], flags[index]))
+        {
+            return;
+        }
+        const float dx       = xs[index] - x;
+        const float dy       = ys[index] - y;
+        const float distance = dx * dx + dy * dy;
+        if (distance > rangeSquared || (m_candidates.size() == k && distance >= m_candidates.front().first))
+        {
+            return;
+        }
+        if (m_candidates.size() == k)
+        {
+            std::pop_heap(m_candidates.begin(), m_candidates.end(), byDistance);
+            m_candidates.pop_back();
+        }
+        m_candidates.emplace_back(distance, index);
+        std::push_heap(m_candidates.begin(), m_candidates.end(), byDistance);
+    };
+
+    const int32_t cx    = cellOf(x);
+    const int32_t cy    = cellOf(y);
+    const int32_t rings = static_cast<int32_t>(std::min(range * m_inverse + 1.0f, MAX_CELL));
+    if (rings >= static_cast<int32_t>(GRID_SIZE / 2))
+    {
+        // Кольца начали бы повторять корзины - проще перебрать все
+        for (const auto& bucket : m_buckets)
+        {
+            for (EntityIndex index : bucket)
+            {
+                consider(index);
+            }
+        }
+    }
+    else
+    {
+        for (int32_t ring = 0; ring <= rings; ring++)
+        {
+            // Любая точка кольца ring не ближе (ring - 1) ячеек от центра
+            const float bound = static_cast<float>(ring - 1) * m_cellSize;
+            if (ring > 1 && m_candidates.size() == k && bound * bound > m_candidates.front().first)
+            {
+                break;
+            }
+
+            for (int32_t dy = -ring; dy <= ring; dy++)
+            {
+                // Внутренние строки кольца - только крайние ячейки
+                const int32_t step = (dy == -ring || dy == ring) ? 1 : std::max(1, 2 * ring);
+                for (int32_t dx = -ring; dx <= ring; dx += step)
+                {
+                    for (EntityIndex index : m_buckets[bucketOf(cx + dx, cy + dy)])
+                    {
+                        consider(index);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort_heap(m_candidates.begin(), m_candidates.end(), byDistance);
+    result.reserve(m_candidates.size());
+    for (const auto& candidate : m_candidates)
+    {
+        result.push_back(candidate.second);
+    }
+}
+
+int32_t SpatialGrid::cellOf(float coordinate) const
+{
+    const float cell = std::floor(coordinate * m_inverse);
+    return std::isfinite(cell) ? static_cast<int32_t>(std::clamp(cell, -MAX_CELL, MAX_CELL)) : 0;
+}
+
+uint16_t SpatialGrid::bucketFor(const EntityTable& table, EntityIndex index) const
+{
+    switch (table.types()[index])
+    {
+        case ObjectType::Unit:
+        case ObjectType::Player:
+        case ObjectType::GameObject:
+            return bucketOf(cellOf(table.x()[index]), cellOf(table.y()[index]));
+        default:
+            return NO_BUCKET;
+    }
+}
+
+void SpatialGrid::link(EntityIndex index, uint16_t bucket)
+{
+    m_bucketOf[index] = bucket;
+    m_slotOf[index]   = static_cast<uint32_t>(m_buckets[bucket].size());
+    m_buckets[bucket].push_back(index);
+    m_stats.indexed++;
+}
+
+void SpatialGrid::unlink(EntityIndex index)
+{
+    auto&          bucket = m_buckets[m_bucketOf[index]];
+    const uint32_t slot   = m_slotOf[index];
+
+    bucket[slot]           = bucket.back();
+    m_slotOf[bucket[slot]] = slot;
+    bucket.pop_back();
+
+    m_bucketOf[index] = NO_BUCKET;
+    m_stats.indexed--;
+}
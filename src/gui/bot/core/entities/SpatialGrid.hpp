@@ -0,0 +1,211 @@
+/**
+ * @file SpatialGrid.hpp
+ * @brief Пространственный индекс сущностей: равномерная сетка по координатам X/Y карты
+ * @details Пример (враждебные существа в 30 ярдах, ближайшие 5 игроков):
+ * @code
+ * grid.update(entities); // после каждого EntityTable::sync()
+ *
+ * SpatialFilter hostile;
+ * hostile.types         = SpatialFilter::typeBit(ObjectType::Unit);
+ * hostile.excludedFlags = UnitFlags::NOT_SELECTABLE;
+ * grid.radius(entities, x, y, 30.0f, hostile, result);
+ *
+ * SpatialFilter players;
+ * players.types = SpatialFilter::typeBit(ObjectType::Player);
+ * grid.nearest(entities, x, y, 5, 100.0f, players, result);
+ * @endcode
+ */
+#pragma once
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EntityTable.hpp"
+
+
+/**
+ * @brief Условия отбора сущностей в запросах SpatialGrid
+ */
+struct SpatialFilter
+{
+    static constexpr uint32_t ALL_TYPES = ~0u; ///< Любой тип
+
+    uint32_t    types{ALL_TYPES};        ///< Маска типов (typeBit())
+    uint32_t    requiredFlags{0};        ///< Флаги UNIT_FIELD_FLAGS, которые должны быть установлены
+    uint32_t    excludedFlags{0};        ///< Флаги, которые не должны быть установлены
+    EntityIndex exclude{INVALID_ENTITY}; ///< Сущность, которую не возвращать (обычно сам игрок)
+
+    /**
+     * @brief Бит типа в маске types
+     */
+    static constexpr uint32_t typeBit(ObjectType type) { return 1u << static_cast<uint32_t>(type); }
+
+    /**
+     * @brief Сущность проходит фильтр
+     */
+    bool accepts(EntityIndex index, ObjectType type, uint32_t flags) const
+    {
+        return index != exclude && (types & typeBit(type)) != 0 && (flags & requiredFlags) == requiredFlags &&
+               (flags & excludedFlags) == 0;
+    }
+};
+
+/**
+ * @brief Счётчики SpatialGrid
+ */
+struct SpatialGridStats
+{
+    size_t   indexed{0};  ///< Сущности в сетке
+    uint64_t updates{0};  ///< Вызовы update()
+    uint64_t moves{0};    ///< Переносы сущностей между ячейками в update()
+    uint64_t rebuilds{0}; ///< Вызовы rebuild()
+};
+
+/**
+ * @class SpatialGrid
+ * @brief Равномерная сетка по X/Y поверх EntityTable
+ * @details Сетка хранит только индексы строк EntityTable, координаты берутся из колонок таблицы.
+ * Ячейки сворачиваются в GRID_SIZE x GRID_SIZE корзин (ячейка (cx, cy) попадает в корзину
+ * (cx mod GRID_SIZE, cy mod GRID_SIZE)), поэтому ячейка находится индексированием массива, без хэширования.
+ * Клиент видит объекты на несколько сотен ярдов, что меньше GRID_SIZE ячеек, поэтому в пределах запроса
+ * разные ячейки не делят корзину; кандидаты в любом случае проверяются по точному расстоянию.
+ * В сетку попадают только существа, игроки и игровые объекты - у остальных объектов нет координат.
+ * Расстояния считаются в плоскости X/Y.
+ * Сетка следует за строками таблицы, а не за GUID: update() сравнивает ячейку каждой строки с прошлой
+ * и переносит только изменившиеся, поэтому swap-remove в таблице обрабатывается как перемещение строки.
+ * После каждого изменения таблицы и до запросов нужен update() или rebuild(). Не потокобезопасна,
+ * в том числе для одновременных запросов (запросы используют общий буфер).
+ */
+class SpatialGrid
+{
+  public:
+    static constexpr size_t GRID_SIZE    = 64;                    ///< Корзин по каждой оси
+    static constexpr size_t BUCKET_COUNT = GRID_SIZE * GRID_SIZE; ///< Всего корзин
+
+    /**
+     * @brief Конструктор
+     * @param cellSize Сторона ячейки в ярдах (порядка типичного радиуса запроса)
+     */
+    explicit SpatialGrid(float cellSize = 16.0f);
+
+    /**
+     * @brief Приводит сетку к текущему состоянию таблицы, перенося только сменившие ячейку строки
+     */
+    void update(const EntityTable& table);
+
+    /**
+     * @brief Строит сетку заново (после смены зоны, когда почти все сущности новые)
+     * @param threads Количество потоков (0 - по числу ядер); маленькие таблицы строятся меньшим числом потоков
+     */
+    void rebuild(const EntityTable& table, unsigned threads = 0);
+
+    /**
+     * @brief Удаляет все сущности
+     */
+    void clear();
+
+    /**
+     * @brief Сущности в радиусе
+     * @param result Индексы строк в порядке обхода ячеек (очищается)
+     */
+    void radius(const EntityTable&        table,
+                float                     x,
+                float                     y,
+                float                     range,
+                const SpatialFilter&      filter,
+                std::vector<EntityIndex>& result) const;
+
+    /**
+     * @brief Сущности в секторе
+     * @param facing Направление оси сектора (радианы, как поле facing)
+     * @param halfAngle Половина угла раствора сектора (радианы)
+     * @param result Индексы строк в порядке обхода ячеек (очищается)
+     */
+    void cone(const EntityTable&        table,
+              float                     x,
+              float                     y,
+              float                     facing,
+              float                     halfAngle,
+              float                     range,
+              const SpatialFilter&      filter,
+              std::vector<EntityIndex>& result) const;
+
+    /**
+     * @brief k ближайших сущностей не дальше range
+     * @param result Индексы строк по возрастанию расстояния (очищается)
+     * @details Ячейки обходятся кольцами от центра; обход заканчивается, как только следующее кольцо
+     * не может содержать сущность ближе k-й найденной
+     */
+    void nearest(const EntityTable&        table,
+                 float                     x,
+                 float                     y,
+                 size_t                    k,
+                 float                     range,
+                 const SpatialFilter&      filter,
+                 std::vector<EntityIndex>& result) const;
+
+    /**
+     * @brief Сторона ячейки в ярдах
+     */
+    float cellSize() const { return m_cellSize; }
+
+    /**
+     * @brief Счётчики
+     */
+    const SpatialGridStats& stats() const { return m_stats; }
+
+  private:
+    static constexpr uint16_t NO_BUCKET = UINT16_MAX; ///< Строка не в сетке
+
+    /**
+     * @brief Номер ячейки по одной оси
+     */
+    int32_t cellOf(float coordinate) const;
+
+    /**
+     * @brief Корзина ячейки
+     */
+    static uint16_t bucketOf(int32_t cx, int32_t cy)
+    {
+        return static_cast<uint16_t>((static_cast<uint32_t>(cx) & (GRID_SIZE - 1)) |
+                                     ((static_cast<uint32_t>(cy) & (GRID_SIZE - 1)) * GRID_SIZE));
+    }
+
+    /**
+     * @brief Корзина строки таблицы или NO_BUCKET, если у объекта нет координат
+     */
+    uint16_t bucketFor(const EntityTable& table, EntityIndex index) const;
+
+    /**
+     * @brief Добавляет строку в корзину
+     */
+    void link(EntityIndex index, uint16_t bucket);
+
+    /**
+     * @brief Убирает строку из её корзины
+     */
+    void unlink(EntityIndex index);
+
+    /**
+     * @brief Вызывает visit(index, dx, dy, distanceSquared) для сущностей в радиусе, прошедших фильтр
+     */
+    template <typename Visit>
+    void forEachInRange(const EntityTable&   table,
+                        float                x,
+                        float                y,
+                        float                range,
+                        const SpatialFilter& filter,
+                        Visit&&              visit) const;
+
+    float m_cellSize; ///< Сторона ячейки
+    float m_inverse;  ///< 1 / m_cellSize
+
+    std::vector<std::vector<EntityIndex>> m_buckets;  ///< Строки по корзинам
+    std::vector<uint16_t>                 m_bucketOf; ///< Корзина каждой строки таблицы
+    std::vector<uint32_t>                 m_slotOf;   ///< Позиция строки в её корзине
+    SpatialGridStats                      m_stats;    ///< Счётчики
+
+    mutable std::vector<std::pair<float, EntityIndex>> m_candidates; ///< Буфер nearest()
+};
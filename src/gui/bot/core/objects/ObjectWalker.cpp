@@ -0,0 +1,276 @@
+#include "ObjectWalker.hpp"
+
+#include "core/memory/MemoryManager.hpp"
+
+
+bool ObjectWalker::walk(MemoryManager& memory, WalkDetail detail)
+{
+    m_stats = ObjectWalkerStats{m_stats.walks + 1};
+    m_objects.clear();
+    m_error.clear();
+
+    uint32_t first = 0;
+    if (!readManager(memory, first))
+    {
+        m_slots.clear();
+        return false;
+    }
+
+    // 1. Объекты предыдущего обхода - одним пакетом по известным адресам
+    m_previous.swap(m_slots);
+    m_slots.clear();
+    m_known.clear();
+    if (!m_previous.empty())
+    {
+        m_requests.clear();
+        for (size_t i = 0; i < m_previous.size(); i++)
+        {
+            if (detail == WalkDetail::Headers)
+            {
+                queueHeader(m_previous[i]);
+            }
+            else
+            {
+                queue(m_previous[i], HEADER_BEGIN);
+            }
+            m_known.emplace(m_previous[i].address, i);
+        }
+        flush(memory);
+    }
+
+    // 2. Цепочка next. Объект из пакета принимается, когда на него указывает уже принятый объект,
+    // поэтому удаление или вставка в середине списка не сбрасывает остальную его часть.
+    // Объекты, которых не было в пакете, читаются последовательно, по заголовку на чтение.
+    uint32_t expected = first;
+    while (isObjectPointer(expected))
+    {
+        if (m_slots.size() >= MAX_OBJECTS)
+        {
+            m_error = "Object list is too long";
+            break;
+        }
+
+        auto known = m_known.find(expected);
+        if (known != m_known.end() && m_requests[m_previous[known->second].objectRequest].succeeded)
+        {
+            Slot& slot = m_slots.emplace_back(m_previous[known->second]);
+            m_known.erase(known);
+
+            // Тип, GUID или блок дескрипторов сменились - прочитанные части не соответствуют объекту.
+            // В режиме Headers остальные части не читались: годятся только полностью прочитанные раньше
+            const ObjectType type        = slot.type;
+            const uint32_t   descriptors = slot.descriptors;
+            const uint64_t   guid        = slot.guid;
+            const bool       read        = detail == WalkDetail::Headers ? slot.complete : succeeded(slot);
+            decodeHeader(slot);
+            slot.complete = read && slot.type == type && slot.descriptors == descriptors && slot.guid == guid;
+            m_stats.prefetched += slot.complete && detail == WalkDetail::Full ? 1 : 0;
+            m_stats.kept       += slot.complete && detail == WalkDetail::Headers ? 1 : 0;
+            expected            = slot.next;
+            continue;
+        }
+
+        Slot& slot    = m_slots.emplace_back();
+        slot.address  = expected;
+        slot.complete = false;
+        m_stats.chainReads++;
+        if (memory.TryReadMemory(expected + HEADER_BEGIN, slot.object.data(), HEADER_END - HEADER_BEGIN) !=
+            ReadError::None)
+        {
+            m_error = "Failed to read object header";
+            m_slots.pop_back();
+            break;
+        }
+        decodeHeader(slot);
+        expected = slot.next;
+    }
+    m_stats.reads += m_stats.chainReads;
+
+    // 3. Остальные части новых и изменившихся объектов - вторым пакетом
+    m_requests.clear();
+    for (Slot& slot : m_slots)
+    {
+        if (!slot.complete)
+        {
+            queue(slot, HEADER_END);
+        }
+    }
+    if (!m_requests.empty())
+    {
+        flush(memory);
+    }
+
+    m_objects.reserve(m_slots.size());
+    for (Slot& slot : m_slots)
+    {
+        if (!slot.complete)
+        {
+            slot.complete = succeeded(slot);
+        }
+        if (slot.complete)
+        {
+            m_objects.push_back(decode(slot));
+        }
+        else
+        {
+            m_stats.failed++;
+        }
+    }
+
+    m_stats.objects = m_objects.size();
+    if (m_stats.failed != 0 && m_error.empty())
+    {
+        m_error = "Failed to read " + std::to_string(m_stats.failed) + " objects";
+    }
+    return true;
+}
+
+void ObjectWalker::invalidate(uint32_t address)
+{
+    for (Slot& slot : m_slots)
+    {
+        if (slot.address == address)
+        {
+            slot.complete = false;
+        }
+    }
+}
+
+void ObjectWalker::reset()
+{
+    m_slots.clear();
+    m_previous.clear();
+    m_objects.clear();
+    m_localGuid = 0;
+}
+
+uint32_t ObjectWalker::objectEnd(ObjectType type)
+{
+    switch (type)
+    {
+        case ObjectType::Unit:
+        case ObjectType::Player:
+            return OBJECT_END;
+        case ObjectType::GameObject:
+            return GameObjectPositionLayout::END;
+        default:
+            return HEADER_END;
+    }
+}
+
+uint32_t ObjectWalker::descriptorsEnd(ObjectType type)
+{
+    switch (type)
+    {
+        case ObjectType::Unit:
+        case ObjectType::Player:
+            return DESCRIPTORS_END;
+        default:
+            return ObjectDescriptorLayout::END;
+    }
+}
+
+bool ObjectWalker::readManager(MemoryManager& memory, uint32_t& first)
+{
+    // Менеджер перечитывается каждый обход: он меняется при входе в мир и выходе из него
+    m_stats.reads += 3;
+
+    const auto connection = memory.TryRead<uint32_t>(ObjectOffsets::CLIENT_CONNECTION);
+    if (!connection || *connection == 0)
+    {
+        m_error = "Client connection is not available";
+        return false;
+    }
+
+    const auto manager = memory.TryRead<uint32_t>(*connection + ObjectOffsets::CURRENT_MANAGER);
+    if (!manager || *manager == 0)
+    {
+        m_error = "Object manager is not available";
+        return false;
+    }
+
+    ManagerData data;
+    if (!ManagerLayout::read(memory, *manager, data))
+    {
+        m_error = "Failed to read object manager";
+        return false;
+    }
+
+    first       = data.firstObject;
+    m_localGuid = data.localGuid;
+    return true;
+}
+
+void ObjectWalker::decodeHeader(Slot& slot)
+{
+    HeaderLayout::decode(slot.object.data(), slot);
+}
+
+void ObjectWalker::queue(Slot& slot, uint32_t begin)
+{
+    slot.objectRequest     = SIZE_MAX;
+    slot.descriptorRequest = SIZE_MAX;
+
+    const uint32_t end = objectEnd(slot.type);
+    if (end > begin)
+    {
+        slot.objectRequest = m_requests.size();
+        m_requests.push_back(
+            ReadRequest{slot.address + begin, end - begin, slot.object.data() + (begin - HEADER_BEGIN)});
+    }
+    if (slot.descriptors != 0)
+    {
+        slot.descriptorRequest = m_requests.size();
+        m_requests.push_back(ReadRequest{slot.descriptors, descriptorsEnd(slot.type), slot.descriptorData.data()});
+    }
+}
+
+void ObjectWalker::queueHeader(Slot& slot)
+{
+    slot.objectRequest     = m_requests.size();
+    slot.descriptorRequest = SIZE_MAX;
+    m_requests.push_back(ReadRequest{slot.address + HEADER_BEGIN, HEADER_END - HEADER_BEGIN, slot.object.data()});
+}
+
+void ObjectWalker::flush(MemoryManager& memory)
+{
+    const BatchReadStats batch = memory.ReadBatch(m_requests);
+    m_stats.batches++;
+    m_stats.reads += batch.mergedReads;
+    m_stats.bytes += batch.bytesRead;
+}
+
+bool ObjectWalker::succeeded(const Slot& slot) const
+{
+    if (slot.descriptorRequest == SIZE_MAX || !m_requests[slot.descriptorRequest].succeeded)
+    {
+        return false;
+    }
+    return slot.objectRequest == SIZE_MAX || m_requests[slot.objectRequest].succeeded;
+}
+
+ObjectSnapshot ObjectWalker::decode(const Slot& slot)
+{
+    ObjectSnapshot snapshot;
+    snapshot.type = slot.type;
+
+    if (snapshot.isUnit())
+    {
+        UnitDescriptorLayout::decode(slot.descriptorData.data(), snapshot);
+        UnitPositionLayout::decode(objectData(slot, UnitPositionLayout::BEGIN), snapshot);
+    }
+    else
+    {
+        ObjectDescriptorLayout::decode(slot.descriptorData.data(), snapshot);
+        if (snapshot.type == ObjectType::GameObject)
+        {
+            GameObjectPositionLayout::decode(objectData(slot, GameObjectPositionLayout::BEGIN), snapshot);
+        }
+    }
+
+    // GUID снимка - из заголовка: по нему объект сверялся с предыдущим обходом
+    snapshot.address     = slot.address;
+    snapshot.descriptors = slot.descriptors;
+    snapshot.guid        = slot.guid;
+    return snapshot;
+}
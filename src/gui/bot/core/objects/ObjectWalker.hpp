@@ -0,0 +1,369 @@
+/**
+ * @file ObjectWalker.hpp
+ * @brief Обход списка объектов менеджера объектов клиента 3.3.5a пакетными чтениями
+ * @details Пример (обновление снимка раз в тик):
+ * @code
+ * ObjectWalker walker;
+ * if (walker.walk(memory))
+ * {
+ *     for (const ObjectSnapshot& object : walker.objects()) { ... }
+ * }
+ * @endcode
+ */
+#pragma once
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/memory/ReadBatch.hpp"
+#include "core/memory/RemoteStruct.hpp"
+
+
+/**
+ * @brief Тип объекта (поле CGObject_C::m_objectType)
+ */
+enum class ObjectType : uint32_t
+{
+    Object,
+    Item,
+    Container,
+    Unit,
+    Player,
+    GameObject,
+    DynamicObject,
+    Corpse
+};
+
+/**
+ * @brief Смещения менеджера объектов и объектов клиента 3.3.5a (12340)
+ * @details Клиент 32-битный: все указатели в его памяти занимают 4 байта
+ */
+struct ObjectOffsets
+{
+    // Менеджер объектов: [[CLIENT_CONNECTION] + CURRENT_MANAGER]
+    static constexpr uint32_t CLIENT_CONNECTION = 0xC79CE0; ///< Статический указатель на ClientConnection
+    static constexpr uint32_t CURRENT_MANAGER   = 0x2ED0;   ///< Указатель на текущий менеджер объектов
+    static constexpr uint32_t FIRST_OBJECT      = 0xAC;     ///< Первый объект списка
+    static constexpr uint32_t LOCAL_GUID        = 0xC0;     ///< GUID персонажа игрока
+
+    // Объект (относительно его адреса)
+    static constexpr uint32_t DESCRIPTORS         = 0x08;  ///< Указатель на блок дескрипторов
+    static constexpr uint32_t TYPE                = 0x14;  ///< Тип объекта (ObjectType)
+    static constexpr uint32_t GUID                = 0x30;  ///< GUID
+    static constexpr uint32_t NEXT_OBJECT         = 0x3C;  ///< Следующий объект списка
+    static constexpr uint32_t GAMEOBJECT_POSITION = 0xE8;  ///< Координаты x, y, z игрового объекта
+    static constexpr uint32_t UNIT_POSITION       = 0x798; ///< Координаты x, y, z существа
+    static constexpr uint32_t UNIT_FACING         = 0x7A8; ///< Направление существа (радианы)
+
+    // Дескрипторы (относительно блока дескрипторов)
+    static constexpr uint32_t OBJECT_GUID = 0x00; ///< OBJECT_FIELD_GUID
+    static constexpr uint32_t ENTRY       = 0x0C; ///< OBJECT_FIELD_ENTRY
+    static constexpr uint32_t TARGET      = 0x48; ///< UNIT_FIELD_TARGET
+    static constexpr uint32_t HEALTH      = 0x60; ///< UNIT_FIELD_HEALTH
+    static constexpr uint32_t MAX_HEALTH  = 0x80; ///< UNIT_FIELD_MAXHEALTH
+    static constexpr uint32_t LEVEL       = 0xD8; ///< UNIT_FIELD_LEVEL
+    static constexpr uint32_t FACTION     = 0xDC; ///< UNIT_FIELD_FACTIONTEMPLATE
+    static constexpr uint32_t UNIT_FLAGS  = 0xEC; ///< UNIT_FIELD_FLAGS
+};
+
+/**
+ * @brief Флаги UNIT_FIELD_FLAGS клиента 3.3.5a
+ */
+struct UnitFlags
+{
+    static constexpr uint32_t NOT_SELECTABLE = 0x02000000; ///< UNIT_FLAG_NOT_SELECTABLE
+};
+
+/**
+ * @brief Что читает ObjectWalker::walk() у объектов, известных по предыдущему обходу
+ */
+enum class WalkDetail
+{
+    Full,   ///< Все части объекта
+    Headers ///< Только заголовок (состав списка); новые и изменившиеся объекты читаются целиком
+};
+
+/**
+ * @brief Снимок объекта, полученный за один обход
+ */
+struct ObjectSnapshot
+{
+    uint32_t   address{0};               ///< Адрес объекта в памяти клиента
+    uint32_t   descriptors{0};           ///< Адрес блока дескрипторов
+    uint64_t   guid{0};                  ///< GUID
+    ObjectType type{ObjectType::Object}; ///< Тип
+    uint32_t   entry{0};                 ///< Идентификатор шаблона (существа, объекта, предмета)
+    float      x{0.0f};                  ///< Координата X (существа и игровые объекты)
+    float      y{0.0f};                  ///< Координата Y
+    float      z{0.0f};                  ///< Координата Z
+    float      facing{0.0f};             ///< Направление (только существа)
+    uint64_t   target{0};                ///< GUID цели (только существа)
+    uint32_t   health{0};                ///< Текущее здоровье (только существа)
+    uint32_t   maxHealth{0};             ///< Максимальное здоровье (только существа)
+    uint32_t   level{0};                 ///< Уровень (только существа)
+    uint32_t   faction{0};               ///< Шаблон фракции (только существа)
+    uint32_t   flags{0};                 ///< UNIT_FIELD_FLAGS (только существа)
+
+    /**
+     * @brief Существо или игрок
+     */
+    bool isUnit() const { return type == ObjectType::Unit || type == ObjectType::Player; }
+};
+
+/**
+ * @brief Дескрипторы любого объекта (относительно блока дескрипторов)
+ */
+using ObjectDescriptorLayout = RemoteStruct<ObjectSnapshot,
+                                            RemoteField<&ObjectSnapshot::guid, ObjectOffsets::OBJECT_GUID>,
+                                            RemoteField<&ObjectSnapshot::entry, ObjectOffsets::ENTRY>>;
+
+/**
+ * @brief Часто меняющиеся дескрипторы существа: GUID, цель и здоровье
+ */
+using UnitHotDescriptorLayout = RemoteStruct<ObjectSnapshot,
+                                             RemoteField<&ObjectSnapshot::guid, ObjectOffsets::OBJECT_GUID>,
+                                             RemoteField<&ObjectSnapshot::entry, ObjectOffsets::ENTRY>,
+                                             RemoteField<&ObjectSnapshot::target, ObjectOffsets::TARGET>,
+                                             RemoteField<&ObjectSnapshot::health, ObjectOffsets::HEALTH>>;
+
+/**
+ * @brief Все читаемые дескрипторы существа
+ */
+using UnitDescriptorLayout = RemoteStruct<ObjectSnapshot,
+                                          RemoteField<&ObjectSnapshot::guid, ObjectOffsets::OBJECT_GUID>,
+                                          RemoteField<&ObjectSnapshot::entry, ObjectOffsets::ENTRY>,
+                                          RemoteField<&ObjectSnapshot::target, ObjectOffsets::TARGET>,
+                                          RemoteField<&ObjectSnapshot::health, ObjectOffsets::HEALTH>,
+                                          RemoteField<&ObjectSnapshot::maxHealth, ObjectOffsets::MAX_HEALTH>,
+                                          RemoteField<&ObjectSnapshot::level, ObjectOffsets::LEVEL>,
+                                          RemoteField<&ObjectSnapshot::faction, ObjectOffsets::FACTION>,
+                                          RemoteField<&ObjectSnapshot::flags, ObjectOffsets::UNIT_FLAGS>>;
+
+/**
+ * @brief Координаты и направление существа (относительно адреса объекта)
+ */
+using UnitPositionLayout = RemoteStruct<ObjectSnapshot,
+                                        RemoteField<&ObjectSnapshot::x, ObjectOffsets::UNIT_POSITION>,
+                                        RemoteField<&ObjectSnapshot::y, ObjectOffsets::UNIT_POSITION + 4>,
+                                        RemoteField<&ObjectSnapshot::z, ObjectOffsets::UNIT_POSITION + 8>,
+                                        RemoteField<&ObjectSnapshot::facing, ObjectOffsets::UNIT_FACING>>;
+
+/**
+ * @brief Координаты игрового объекта (относительно адреса объекта)
+ */
+using GameObjectPositionLayout = RemoteStruct<ObjectSnapshot,
+                                              RemoteField<&ObjectSnapshot::x, ObjectOffsets::GAMEOBJECT_POSITION>,
+                                              RemoteField<&ObjectSnapshot::y, ObjectOffsets::GAMEOBJECT_POSITION + 4>,
+                                              RemoteField<&ObjectSnapshot::z, ObjectOffsets::GAMEOBJECT_POSITION + 8>>;
+
+static_assert(ObjectDescriptorLayout::BEGIN == 0 && UnitHotDescriptorLayout::BEGIN == 0 &&
+                  UnitDescriptorLayout::BEGIN == 0,
+              "Descriptor layouts are read from the start of the descriptor block");
+
+/**
+ * @brief Счётчики последнего обхода ObjectWalker
+ * @details Все поля, кроме walks, описывают только последний вызов walk()
+ */
+struct ObjectWalkerStats
+{
+    uint64_t walks{0};      ///< Вызовы walk()
+    size_t   objects{0};    ///< Объекты в снимке
+    size_t   prefetched{0}; ///< Объекты, полностью прочитанные пакетом по адресам предыдущего обхода
+    size_t   kept{0};       ///< Объекты, у которых в режиме Headers прочитан только заголовок
+    size_t   chainReads{0}; ///< Последовательные чтения заголовков (новые объекты и разрывы списка)
+    size_t   batches{0};    ///< Вызовы ReadBatch
+    size_t   reads{0};      ///< Все фактические чтения памяти клиента (системные вызовы)
+    size_t   bytes{0};      ///< Байты, прочитанные пакетами (без последовательных чтений заголовков)
+    size_t   failed{0};     ///< Объекты, исключённые из снимка из-за неудачного чтения
+};
+
+/**
+ * @class ObjectWalker
+ * @brief Читает все объекты из связного списка менеджера объектов
+ * @details Список односвязный, поэтому следующий указатель становится известен только после чтения
+ * текущего объекта. Чтобы не платить за это последовательными чтениями каждый тик, обход идёт в три шага:
+ * 1. Объекты предыдущего обхода читаются одним пакетом: заголовок вместе с координатами (один
+ *    сплошной диапазон на объект) и блок дескрипторов.
+ * 2. Цепочка next проходится по прочитанным заголовкам: объект из пакета принимается, если на него
+ *    указывает уже принятый объект. Только объекты, которых не было в пакете, читаются последовательно,
+ *    по одному чтению заголовка на объект.
+ * 3. Остаток новых объектов (координаты и дескрипторы) читается вторым пакетом.
+ * В установившемся режиме (список не изменился) обход стоит трёх чтений менеджера и одного пакета, но пакет -
+ * это около двух чтений на объект (заголовок с координатами и дескрипторы), если объекты не лежат рядом и
+ * чтения не объединяются: 803 чтения на 400 объектов в mdbot_bench entity-refresh. RefreshPlanner на той же
+ * сцене обходится примерно 88 чтениями за тик.
+ * В режиме WalkDetail::Headers пакет шага 1 читает только заголовки: объект с тем же GUID, типом и
+ * блоком дескрипторов сохраняет части, прочитанные раньше, и его поля в снимке могут быть устаревшими.
+ * Так список обходится ради состава (появление и исчезновение объектов), а поля обновляет вызывающий код.
+ * Менеджер памяти не хранится, он передаётся в walk(). Не потокобезопасен.
+ */
+class ObjectWalker
+{
+  public:
+    static constexpr size_t MAX_OBJECTS = 0x4000; ///< Предел длины списка (защита от зацикливания)
+
+    /**
+     * @brief Обходит список объектов
+     * @param memory Менеджер памяти процесса клиента
+     * @param detail Что читать у объектов предыдущего обхода
+     * @return false если менеджер объектов недоступен (персонаж не в мире); снимок при этом пуст
+     * @details Объекты, которые не удалось прочитать, пропускаются; обход обрывается, только если не
+     * прочитался заголовок (дальше списка не видно). Описание проблемы - в error().
+     */
+    bool walk(MemoryManager& memory, WalkDetail detail = WalkDetail::Full);
+
+    /**
+     * @brief Объекты последнего обхода в порядке списка
+     */
+    const std::vector<ObjectSnapshot>& objects() const { return m_objects; }
+
+    /**
+     * @brief GUID персонажа игрока, прочитанный последним обходом
+     */
+    uint64_t localGuid() const { return m_localGuid; }
+
+    /**
+     * @brief Забывает адреса предыдущего обхода (например, после смены мира)
+     */
+    void reset();
+
+    /**
+     * @brief Следующий обход прочитает объект по адресу целиком, даже в режиме Headers
+     * @details Для объекта, данные которого вызывающий код признал недостоверными
+     */
+    void invalidate(uint32_t address);
+
+    /**
+     * @brief Счётчики
+     */
+    const ObjectWalkerStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Описание последней ошибки
+     */
+    const std::string& error() const { return m_error; }
+
+  private:
+    static constexpr uint32_t HEADER_BEGIN    = ObjectOffsets::DESCRIPTORS;     ///< Начало читаемой части объекта
+    static constexpr uint32_t HEADER_END      = ObjectOffsets::NEXT_OBJECT + 4; ///< Конец заголовка
+    static constexpr uint32_t OBJECT_END      = UnitPositionLayout::END;        ///< Конец читаемой части существа
+    static constexpr uint32_t DESCRIPTORS_END = UnitDescriptorLayout::END;      ///< Конец дескрипторов существа
+
+    /**
+     * @brief Начало списка объектов в менеджере
+     */
+    struct ManagerData
+    {
+        uint32_t firstObject{0}; ///< Первый объект списка
+        uint64_t localGuid{0};   ///< GUID персонажа игрока
+    };
+
+    /**
+     * @brief Первый объект и GUID игрока - одним чтением (относительно адреса менеджера)
+     */
+    using ManagerLayout = RemoteStruct<ManagerData,
+                                       RemoteField<&ManagerData::firstObject, ObjectOffsets::FIRST_OBJECT>,
+                                       RemoteField<&ManagerData::localGuid, ObjectOffsets::LOCAL_GUID>>;
+
+    /**
+     * @brief Прочитанный объект; слоты переиспользуются между обходами
+     */
+    struct Slot
+    {
+        uint32_t   address{0};                  ///< Адрес объекта
+        uint32_t   descriptors{0};              ///< Адрес блока дескрипторов
+        uint64_t   guid{0};                     ///< GUID
+        ObjectType type{ObjectType::Object};    ///< Тип
+        uint32_t   next{0};                     ///< Следующий объект
+        bool       complete{false};             ///< Все части объекта прочитаны
+        size_t     objectRequest{SIZE_MAX};     ///< Запрос части объекта в m_requests
+        size_t     descriptorRequest{SIZE_MAX}; ///< Запрос дескрипторов в m_requests
+
+        std::array<uint8_t, OBJECT_END - HEADER_BEGIN> object;         ///< [HEADER_BEGIN, objectEnd(type))
+        std::array<uint8_t, DESCRIPTORS_END>           descriptorData; ///< [0, descriptorsEnd(type))
+    };
+
+    /**
+     * @brief Заголовок объекта (относительно адреса объекта), совпадает с [HEADER_BEGIN, HEADER_END)
+     */
+    using HeaderLayout = RemoteStruct<Slot,
+                                      RemoteField<&Slot::descriptors, ObjectOffsets::DESCRIPTORS>,
+                                      RemoteField<&Slot::type, ObjectOffsets::TYPE>,
+                                      RemoteField<&Slot::guid, ObjectOffsets::GUID>,
+                                      RemoteField<&Slot::next, ObjectOffsets::NEXT_OBJECT>>;
+
+    static_assert(HeaderLayout::BEGIN == HEADER_BEGIN && HeaderLayout::END == HEADER_END,
+                  "HeaderLayout must cover the object header exactly");
+
+    /**
+     * @brief Конец читаемой части объекта данного типа
+     */
+    static uint32_t objectEnd(ObjectType type);
+
+    /**
+     * @brief Конец читаемой части дескрипторов объекта данного типа
+     */
+    static uint32_t descriptorsEnd(ObjectType type);
+
+    /**
+     * @brief Указатель продолжает список (конец списка - ноль или нечётное значение)
+     */
+    static bool isObjectPointer(uint32_t address) { return address != 0 && (address & 1) == 0; }
+
+    /**
+     * @brief Читает первый объект и GUID игрока
+     */
+    bool readManager(MemoryManager& memory, uint32_t& first);
+
+    /**
+     * @brief Данные slot.object, начиная со смещения относительно адреса объекта
+     */
+    static const uint8_t* objectData(const Slot& slot, uint32_t offset)
+    {
+        return slot.object.data() + (offset - HEADER_BEGIN);
+    }
+
+    /**
+     * @brief Разбирает заголовок объекта из slot.object
+     */
+    static void decodeHeader(Slot& slot);
+
+    /**
+     * @brief Добавляет в m_requests чтение [begin, objectEnd) объекта и дескрипторов
+     * @param begin Смещение в объекте, с которого читать (HEADER_BEGIN или HEADER_END)
+     */
+    void queue(Slot& slot, uint32_t begin);
+
+    /**
+     * @brief Добавляет в m_requests чтение только заголовка объекта
+     */
+    void queueHeader(Slot& slot);
+
+    /**
+     * @brief Выполняет m_requests одним пакетом
+     */
+    void flush(MemoryManager& memory);
+
+    /**
+     * @brief Запросы слота выполнены
+     */
+    bool succeeded(const Slot& slot) const;
+
+    /**
+     * @brief Заполняет снимок из прочитанного слота
+     */
+    static ObjectSnapshot decode(const Slot& slot);
+
+    std::vector<Slot>                    m_slots;        ///< Объекты последнего обхода (план следующего пакета)
+    std::vector<Slot>                    m_previous;     ///< Объекты предыдущего обхода во время walk()
+    std::unordered_map<uint32_t, size_t> m_known;        ///< Адрес -> индекс в m_previous, ещё не принятые
+    std::vector<ReadRequest>             m_requests;     ///< Запросы текущего пакета
+    std::vector<ObjectSnapshot>          m_objects;      ///< Снимок
+    uint64_t                             m_localGuid{0}; ///< GUID персонажа игрока
+    ObjectWalkerStats                    m_stats;        ///< Счётчики
+    std::string                          m_error;        ///< Последняя ошибка
+};
@@ -5,7 +5,13 @@
 #include <QMessageBox>
 #include <QVBoxLayout>
 
+#include <array>
+#include <string_view>
+
+#include <cstring>
+
 #include "core/memory/MemoryManager.hpp"
+#include "gui/bot/core/objects/ObjectWalker.hpp"
 #include "gui/log/LogManager.hpp"
 
 #include <psapi.h>
@@ -15,6 +21,9 @@
 // Адрес смещения имени персонажа от базы run.exe
 constexpr uintptr_t PLAYER_NAME_OFFSET = 0x879D18;
 
+// Длина буфера имени персонажа в клиенте
+constexpr size_t PLAYER_NAME_LENGTH = 12;
+
 ProcessListDialog::ProcessListDialog(QWidget* parent) : QDialog(parent), selectedProcessId(0)
 {
     setWindowTitle("Выбор процесса WoW");
@@ -22,6 +31,13 @@ ProcessListDialog::ProcessListDialog(QWidget* parent) : QDialog(parent), selecte
     refreshProcessList();
 }
 
+ProcessListDialog::~ProcessListDialog()
+{
+    // Потоки чтения дочитывают очередь и возобновляют корутины: номер обновления уже не совпадёт
+    refreshGeneration++;
+    processReaders.clear();
+}
+
 void ProcessListDialog::setupUi()
 {
     // Создаем основной вертикальный layout
@@ -77,6 +93,11 @@ void ProcessListDialog::findWoWProcesses()
     PROCESSENTRY32W pe32;
     pe32.dwSize = sizeof(pe32);
 
+    // Чтения, запущенные прошлым обновлением, больше не подписывают строки
+    refreshGeneration++;
+
+    std::unordered_map<DWORD, ProcessReader> activeReaders;
+
     // Перебираем все процессы
     if (Process32FirstW(snapshot, &pe32))
     {
@@ -87,73 +108,180 @@ void ProcessListDialog::findWoWProcesses()
             // Проверяем, является ли процесс run.exe
             if (processName.toLower() == "run.exe")
             {
-                QString characterName;
-                bool    readSuccess = false;
-                QString errorMessage;
+                const DWORD processId = pe32.th32ProcessID;
+                QString     errorMessage;
+
+                // Процесс, открытый при прошлом обновлении, используется повторно
+                ProcessReader reader;
+                auto          existing = processReaders.find(processId);
+                if (existing != processReaders.end())
+                {
+                    reader = std::move(existing->second);
+                    processReaders.erase(existing);
+                }
 
                 try
                 {
-                    MemoryManager memory(pe32.th32ProcessID);
-                    // Проверяем, что базовый адрес получен успешно
-                    if (memory.GetModuleBaseAddress() != 0)
+                    if (!reader.reader)
                     {
-                        // Проверяем валидность адреса перед чтением
-                        uintptr_t nameAddress = memory.ResolveAddress(PLAYER_NAME_OFFSET);
-                        if (memory.IsValidAddress(nameAddress))
+                        auto memory = std::make_unique<MemoryManager>(processId);
+
+                        // Проверяем, что базовый адрес получен успешно
+                        if (memory->GetModuleBaseAddress() != 0)
                         {
-                            std::string name = memory.ReadString(
-                                PLAYER_NAME_OFFSET, 12, true); // используем true для относительного адреса
-                            if (MemoryManager::IsValidCharacterName(name))
-                            {
-                                characterName = QString::fromStdString(name);
-                                readSuccess   = true;
-                            }
-                            else
-                            {
-                                errorMessage = "Invalid character name format";
-                            }
+                            // Дальше память процесса читает только поток очереди: MemoryManager не потокобезопасен
+                            reader.nameAddress = memory->ResolveAddress(PLAYER_NAME_OFFSET);
+                            reader.reader      = std::make_unique<AsyncReader>(std::move(memory));
+                            reader.reader->setWakeup(
+                                [this, processId]
+                                {
+                                    // Корутины возобновляются в потоке GUI; после удаления диалога вызов отбрасывается
+                                    QMetaObject::invokeMethod(
+                                        this, [this, processId] { dispatchReads(processId); }, Qt::QueuedConnection);
+                                });
                         }
                         else
                         {
-                            errorMessage = "Invalid memory address";
+                            errorMessage = "Failed to get module base address";
                         }
                     }
-                    else
-                    {
-                        errorMessage = "Failed to get module base address";
-                    }
                 }
                 catch (const std::exception& e)
                 {
                     errorMessage = QString("Error: %1").arg(e.what());
-                    qDebug() << "Error reading process" << pe32.th32ProcessID << ":" << e.what();
+                    qDebug() << "Error reading process" << processId << ":" << e.what();
                 }
 
-                // Формируем текст для отображения
-                QString itemText;
-                if (readSuccess)
-                {
-                    itemText = QString("run.exe - %1 (PID: %2)").arg(characterName).arg(pe32.th32ProcessID);
-                }
-                else
-                {
-                    itemText = QString("run.exe (PID: %1) - %2").arg(pe32.th32ProcessID).arg(errorMessage);
-                }
+                // Имя подставит корутина чтения, когда оно будет прочитано
+                const QString itemText = errorMessage.isEmpty()
+                                             ? QString("run.exe (PID: %1) - reading...").arg(processId)
+                                             : QString("run.exe (PID: %1) - %2").arg(processId).arg(errorMessage);
 
                 auto* item = new QListWidgetItem(itemText);
-                item->setData(Qt::UserRole, QVariant(static_cast<quint32>(pe32.th32ProcessID)));
+                item->setData(Qt::UserRole, QVariant(static_cast<quint32>(processId)));
                 item->setToolTip(errorMessage); // Добавляем подсказку с ошибкой
                 processListWidget->addItem(item);
+
+                if (reader.reader)
+                {
+                    AsyncReader&    queue       = *reader.reader;
+                    const uintptr_t nameAddress = reader.nameAddress;
+                    activeReaders.emplace(processId, std::move(reader));
+                    readCharacterName(processId, queue, nameAddress, refreshGeneration);
+                }
             }
         } while (Process32NextW(snapshot, &pe32));
     }
 
+    // Завершившиеся процессы закрываются вместе с оставшимися записями
+    processReaders = std::move(activeReaders);
+
     CloseHandle(snapshot);
 
     // Обновляем статус кнопки
     acceptButton->setEnabled(processListWidget->count() > 0);
 }
 
+AsyncTask ProcessListDialog::readCharacterName(DWORD       processId,
+                                               AsyncReader& reader,
+                                               uintptr_t   nameAddress,
+                                               uint64_t    generation)
+{
+    using NameBuffer = std::array<char, PLAYER_NAME_LENGTH>;
+
+    // После каждого co_await: если список обновлён или диалог закрывается, строки и очереди чтения
+    // может уже не быть. Слово проверки имени - GUID персонажа [[ClientConnection] + менеджер] + LOCAL_GUID:
+    // он меняется при входе другим персонажем, и только тогда имя читается заново. Вне мира GUID нет,
+    // и имя читается при каждом обновлении
+    uint64_t                   guid       = 0;
+    const ReadResult<uint32_t> connection = co_await reader.readAsync<uint32_t>(ObjectOffsets::CLIENT_CONNECTION);
+    if (generation != refreshGeneration)
+    {
+        co_return;
+    }
+    if (connection && *connection != 0)
+    {
+        const ReadResult<uint32_t> manager =
+            co_await reader.readAsync<uint32_t>(*connection + ObjectOffsets::CURRENT_MANAGER);
+        if (generation != refreshGeneration)
+        {
+            co_return;
+        }
+        if (manager && *manager != 0)
+        {
+            const ReadResult<uint64_t> localGuid =
+                co_await reader.readAsync<uint64_t>(*manager + ObjectOffsets::LOCAL_GUID);
+            if (generation != refreshGeneration)
+            {
+                co_return;
+            }
+            guid = localGuid.value(); // 0 при ошибке чтения
+        }
+    }
+
+    StringId id = guid != 0 ? processReaders.at(processId).strings.cached(nameAddress, PLAYER_NAME_LENGTH, guid)
+                            : INVALID_STRING;
+    bool     readFailed = false;
+    if (id == INVALID_STRING)
+    {
+        const ReadResult<NameBuffer> raw = co_await reader.readAsync<NameBuffer>(nameAddress);
+        if (generation != refreshGeneration)
+        {
+            co_return;
+        }
+
+        StringCache&           strings = processReaders.at(processId).strings;
+        const NameBuffer&      buffer  = raw.value();
+        const std::string_view bytes(buffer.data(), strnlen(buffer.data(), buffer.size()));
+        readFailed = !raw;
+        if (!readFailed)
+        {
+            id = guid != 0 ? strings.store(nameAddress, PLAYER_NAME_LENGTH, guid, bytes) : strings.intern(bytes);
+        }
+    }
+
+    QListWidgetItem* item = findItem(processId);
+    if (!item)
+    {
+        co_return;
+    }
+
+    const std::string_view name = processReaders.at(processId).strings.view(id);
+    if (!readFailed && MemoryManager::IsValidCharacterName(name))
+    {
+        const QString characterName = QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size()));
+        item->setText(QString("run.exe - %1 (PID: %2)").arg(characterName).arg(processId));
+        item->setToolTip(QString());
+        co_return;
+    }
+
+    const QString errorMessage = readFailed ? "Invalid memory address" : "Invalid character name format";
+    item->setText(QString("run.exe (PID: %1) - %2").arg(processId).arg(errorMessage));
+    item->setToolTip(errorMessage);
+}
+
+void ProcessListDialog::dispatchReads(DWORD processId)
+{
+    auto existing = processReaders.find(processId);
+    if (existing != processReaders.end() && existing->second.reader)
+    {
+        existing->second.reader->dispatch();
+    }
+}
+
+QListWidgetItem* ProcessListDialog::findItem(DWORD processId) const
+{
+    for (int row = 0; row < processListWidget->count(); row++)
+    {
+        QListWidgetItem* item = processListWidget->item(row);
+        if (item->data(Qt::UserRole).toUInt() == processId)
+        {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
 bool ProcessListDialog::isWoWProcess(DWORD processId, const QString& windowTitle)
 {
     HANDLE processHandle = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, processId);
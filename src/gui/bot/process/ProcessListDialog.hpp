@@ -7,7 +7,12 @@
 #include <QHBoxLayout>
 #include <windows.h>
 #include <tlhelp32.h>
+#include <memory>
+#include <unordered_map>
 #include <vector>
+#include "core/memory/AsyncReader.hpp"
+#include "core/memory/MemoryManager.hpp"
+#include "core/memory/StringCache.hpp"
 
 /**
  * @struct ProcessInfo
@@ -18,6 +23,20 @@ struct ProcessInfo {
     QString windowTitle;   ///< Заголовок окна процесса
 };
 
+/**
+ * @struct ProcessReader
+ * @brief Открытый процесс WoW, его очередь асинхронных чтений и кэш строк его памяти
+ * @details Сохраняется между обновлениями списка: процесс не открывается заново,
+ * имя персонажа перечитывается только при смене GUID персонажа, а одинаковые имена
+ * интернируются в одну строку. Память процесса читает
+ * только поток AsyncReader, поэтому зависший клиент не блокирует диалог
+ */
+struct ProcessReader {
+    uintptr_t nameAddress{0};            ///< Адрес имени персонажа
+    std::unique_ptr<AsyncReader> reader; ///< Чтения процесса (со своим менеджером памяти и потоком)
+    StringCache strings;                 ///< Кэш строк процесса
+};
+
 /**
  * @class ProcessListDialog
  * @brief Диалог для выбора процесса WoW из списка запущенных процессов
@@ -32,7 +51,13 @@ public:
      * @param parent Родительский виджет (nullptr по умолчанию)
      */
     explicit ProcessListDialog(QWidget *parent = nullptr);
-    ~ProcessListDialog() = default;
+
+    /**
+     * @brief Деструктор
+     * @details Останавливает потоки чтения, пока диалог ещё цел: ожидающие корутины
+     * возобновляются и завершаются, не трогая список
+     */
+    ~ProcessListDialog() override;
 
     /**
      * @brief Получить ID выбранного процесса
@@ -80,6 +105,28 @@ private:
      */
     static bool isWoWProcess(DWORD processId, const QString& windowTitle);
 
+    /**
+     * @brief Читает имя персонажа процесса и подписывает его строку списка
+     * @param processId ID процесса
+     * @param reader Очередь чтений процесса
+     * @param nameAddress Адрес имени персонажа
+     * @param generation Номер обновления списка, в котором запущено чтение
+     * @details Корутина: запускается из findWoWProcesses() и возобновляется в потоке GUI из dispatchReads().
+     * Если список успел обновиться (или диалог закрывается), результат отбрасывается
+     */
+    AsyncTask readCharacterName(DWORD processId, AsyncReader& reader, uintptr_t nameAddress, uint64_t generation);
+
+    /**
+     * @brief Возобновляет корутины процесса, чьи чтения выполнены
+     */
+    void dispatchReads(DWORD processId);
+
+    /**
+     * @brief Строка списка процесса
+     * @return nullptr если строки нет
+     */
+    QListWidgetItem* findItem(DWORD processId) const;
+
     /** 
      * @brief Список процессов
      * @details Виджет для отображения списка найденных процессов WoW
@@ -109,4 +156,17 @@ private:
      * @details Хранит идентификатор процесса, выбранного пользователем из списка
      */
     DWORD selectedProcessId;
+
+    /**
+     * @brief Открытые процессы WoW по ID
+     * @details Процессы, пропавшие из списка системы, удаляются при обновлении
+     */
+    std::unordered_map<DWORD, ProcessReader> processReaders;
+
+    /**
+     * @brief Номер обновления списка
+     * @details Растёт при каждом обновлении и при закрытии диалога; корутина, запущенная
+     * с другим номером, не обращается ни к списку, ни к своей очереди чтений
+     */
+    uint64_t refreshGeneration{0};
 };
\ No newline at end of file
@@ -30,7 +30,19 @@ BotTabWidget::BotTabWidget(DWORD processId, QWidget* parent)
                 m_characterTab->onContextUpdated();
             }
         });
+
+        connect(m_botCore, &BotCore::watchesChanged, this, [this](const std::vector<WatchId>& changes) {
+            if (m_characterTab) {
+                m_characterTab->onWatchesChanged(*m_botCore, changes);
+            }
+        });
         
+        connect(m_botCore, &BotCore::targetChanged, this, [this]() {
+            if (m_characterTab) {
+                m_characterTab->onTargetChanged(*m_botCore);
+            }
+        });
+
         connect(m_botCore, &BotCore::stateChanged, this, [this](bool enabled) {
             emit botStateChanged(enabled);
             LogManager::instance().info(
@@ -111,4 +123,8 @@ void BotTabWidget::createModuleTabs()
     // Questing Tab
     m_questingTab = new QWidget(this);
     m_moduleTabs->addTab(m_questingTab, "Questing");
+
+    // Scanner Tab
+    m_scannerTab = new ScannerWidget(m_botCore->getProcessId(), this);
+    m_moduleTabs->addTab(m_scannerTab, "Scanner");
 }
\ No newline at end of file
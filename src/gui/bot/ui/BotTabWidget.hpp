@@ -3,6 +3,7 @@
 #include <QTabWidget>
 #include "gui/bot/core/BotCore.hpp"
 #include "gui/bot/ui/modules/character/CharacterWidget.hpp"
+#include "gui/bot/ui/modules/scanner/ScannerWidget.hpp"
 
 /**
  * @brief Виджет главного окна бота, содержащий вкладки с различными модулями
@@ -11,6 +12,7 @@
  * - Combat - настройки боя
  * - Grind - настройки фарма
  * - Questing - настройки квестинга
+ * - Scanner - поиск значений в памяти клиента
  * 
  * Каждый модуль размещается на отдельной вкладке и управляется через BotCore
  */
@@ -57,6 +59,7 @@ private:
      * - Combat - для настройки боевой системы
      * - Grind - для настройки фарма
      * - Questing - для настройки квестинга
+     * - Scanner - для поиска адресов полей по значению
      */
     void createModuleTabs();
 
@@ -69,4 +72,5 @@ private:
     QWidget* m_combatTab{nullptr};            ///< Вкладка настроек боя
     QWidget* m_grindTab{nullptr};             ///< Вкладка настроек фарма
     QWidget* m_questingTab{nullptr};          ///< Вкладка настроек квестинга
+    ScannerWidget* m_scannerTab{nullptr};     ///< Вкладка поиска значений
 };
\ No newline at end of file
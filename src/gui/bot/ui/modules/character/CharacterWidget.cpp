@@ -2,6 +2,7 @@
 #include "gui/bot/core/BotCore.hpp"
 #include "gui/log/LogManager.hpp"
 #include <QVBoxLayout>
+#include <algorithm>
 
 CharacterWidget::CharacterWidget(QWidget* parent)
     : QWidget(parent)
@@ -9,6 +10,7 @@ CharacterWidget::CharacterWidget(QWidget* parent)
     , m_healthLabel(new QLabel("Health: 0/0", this))
     , m_manaLabel(new QLabel("Mana: 0/0", this))
     , m_eaxLabel(new QLabel("EAX: 0x00000000", this))
+    , m_targetLabel(new QLabel("Target: none", this))
 {
     LogManager::instance().debug("Creating CharacterWidget", "UI");
     setupUi();
@@ -20,6 +22,7 @@ void CharacterWidget::setupUi() {
     layout->addWidget(m_healthLabel);
     layout->addWidget(m_manaLabel);
     layout->addWidget(m_eaxLabel);
+    layout->addWidget(m_targetLabel);
     setLayout(layout);
     LogManager::instance().debug("CharacterWidget UI setup complete", "UI");
 }
@@ -34,6 +37,42 @@ void CharacterWidget::onContextUpdated() {
     }
 }
 
+void CharacterWidget::onWatchesChanged(const BotCore& core, const std::vector<WatchId>& changes) {
+    const auto changed = [&](CharacterField field) {
+        return std::find(changes.begin(), changes.end(), core.characterWatch(field)) != changes.end();
+    };
+
+    const auto& character = core.context().character;
+    if (changed(CharacterField::Level)) {
+        m_levelLabel->setText(QString("Level: %1").arg(character.level));
+    }
+    if (changed(CharacterField::CurrentHealth) || changed(CharacterField::MaxHealth)) {
+        m_healthLabel->setText(QString("Health: %1/%2")
+            .arg(character.currentHealth)
+            .arg(character.maxHealth));
+    }
+    if (changed(CharacterField::CurrentMana) || changed(CharacterField::MaxMana)) {
+        m_manaLabel->setText(QString("Mana: %1/%2")
+            .arg(character.currentMana)
+            .arg(character.maxMana));
+    }
+}
+
+void CharacterWidget::onTargetChanged(const BotCore& core) {
+    const EntityTable& entities = core.entities();
+    const EntityIndex index = entities.resolve(core.target());
+    if (index == INVALID_ENTITY) {
+        m_targetLabel->setText("Target: none");
+        return;
+    }
+
+    m_targetLabel->setText(QString("Target: entry %1, level %2, HP %3/%4")
+        .arg(entities.entries()[index])
+        .arg(entities.level()[index])
+        .arg(entities.health()[index])
+        .arg(entities.maxHealth()[index]));
+}
+
 void CharacterWidget::updateLabels() {
     try {
         const BotContext& context = qobject_cast<BotCore*>(parent()->parent())->context();
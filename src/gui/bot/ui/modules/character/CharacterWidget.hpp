@@ -10,6 +10,7 @@
  * - Текущее здоровье и максимальное здоровье
  * - Текущая мана и максимальная мана
  * - Значение регистра EAX (для отладки)
+ * - Цель бота
  */
 class CharacterWidget : public QWidget {
     Q_OBJECT
@@ -26,6 +27,20 @@ public:
      */
     void onContextUpdated();
 
+    /**
+     * @brief Слот обновления при изменении наблюдаемых полей
+     * @param core Ядро бота, испустившее сигнал
+     * @param changes Идентификаторы изменившихся полей
+     * @details Обновляет только метки, поля которых изменились
+     */
+    void onWatchesChanged(const BotCore& core, const std::vector<WatchId>& changes);
+
+    /**
+     * @brief Слот обновления при смене цели бота
+     * @param core Ядро бота, испустившее сигнал
+     */
+    void onTargetChanged(const BotCore& core);
+
 private:
     /**
      * @brief Инициализация UI компонентов
@@ -43,4 +58,5 @@ private:
     QLabel* m_healthLabel;   ///< Метка для отображения здоровья
     QLabel* m_manaLabel;     ///< Метка для отображения маны
     QLabel* m_eaxLabel;      ///< Метка для отображения значения EAX
+    QLabel* m_targetLabel;   ///< Метка для отображения цели бота
 };
\ No newline at end of file
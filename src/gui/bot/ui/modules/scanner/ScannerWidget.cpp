@@ -0,0 +1,204 @@
+#include "ScannerWidget.hpp"
+#include "gui/log/LogManager.hpp"
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QVBoxLayout>
+
+ScannerWidget::ScannerWidget(DWORD processId, QWidget* parent)
+    : QWidget(parent)
+    , m_processId(processId)
+{
+    LogManager::instance().debug("Creating ScannerWidget", "UI");
+    setupUi();
+}
+
+ScannerWidget::~ScannerWidget()
+{
+    if (m_worker) {
+        m_worker->wait();
+        delete m_worker;
+    }
+}
+
+void ScannerWidget::setupUi() {
+    m_typeBox = new QComboBox(this);
+    m_typeBox->addItem("UInt32", static_cast<int>(ScanValueType::UInt32));
+    m_typeBox->addItem("UInt16", static_cast<int>(ScanValueType::UInt16));
+    m_typeBox->addItem("UInt8", static_cast<int>(ScanValueType::UInt8));
+    m_typeBox->addItem("Float", static_cast<int>(ScanValueType::Float));
+    m_typeBox->addItem("Double", static_cast<int>(ScanValueType::Double));
+
+    m_filterBox = new QComboBox(this);
+    m_filterBox->addItem("Exact", static_cast<int>(ScanFilter::Exact));
+    m_filterBox->addItem("Range", static_cast<int>(ScanFilter::Range));
+    m_filterBox->addItem("Unknown", static_cast<int>(ScanFilter::Unknown));
+    m_filterBox->addItem("Changed", static_cast<int>(ScanFilter::Changed));
+    m_filterBox->addItem("Unchanged", static_cast<int>(ScanFilter::Unchanged));
+    m_filterBox->addItem("Increased", static_cast<int>(ScanFilter::Increased));
+    m_filterBox->addItem("Decreased", static_cast<int>(ScanFilter::Decreased));
+
+    m_valueEdit = new QLineEdit(this);
+    m_valueEdit->setPlaceholderText("Value");
+    m_upperEdit = new QLineEdit(this);
+    m_upperEdit->setPlaceholderText("Upper bound");
+    m_upperEdit->setEnabled(false);
+
+    connect(m_filterBox, &QComboBox::currentIndexChanged, this, [this]() {
+        const auto filter = static_cast<ScanFilter>(m_filterBox->currentData().toInt());
+        m_valueEdit->setEnabled(filter == ScanFilter::Exact || filter == ScanFilter::Range);
+        m_upperEdit->setEnabled(filter == ScanFilter::Range);
+    });
+
+    m_firstButton = new QPushButton("First Scan", this);
+    m_nextButton = new QPushButton("Next Scan", this);
+    m_resetButton = new QPushButton("Reset", this);
+    m_nextButton->setEnabled(false);
+    connect(m_firstButton, &QPushButton::clicked, this, [this]() { startScan(true); });
+    connect(m_nextButton, &QPushButton::clicked, this, [this]() { startScan(false); });
+    connect(m_resetButton, &QPushButton::clicked, this, &ScannerWidget::resetScan);
+
+    m_statusLabel = new QLabel("No scan", this);
+
+    m_resultsTable = new QTableWidget(0, 2, this);
+    m_resultsTable->setHorizontalHeaderLabels({"Address", "Value"});
+    m_resultsTable->horizontalHeader()->setStretchLastSection(true);
+    m_resultsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_resultsTable->verticalHeader()->setVisible(false);
+
+    auto queryLayout = new QHBoxLayout();
+    queryLayout->addWidget(m_typeBox);
+    queryLayout->addWidget(m_filterBox);
+    queryLayout->addWidget(m_valueEdit);
+    queryLayout->addWidget(m_upperEdit);
+
+    auto buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(m_firstButton);
+    buttonLayout->addWidget(m_nextButton);
+    buttonLayout->addWidget(m_resetButton);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addLayout(queryLayout);
+    layout->addLayout(buttonLayout);
+    layout->addWidget(m_statusLabel);
+    layout->addWidget(m_resultsTable);
+    setLayout(layout);
+}
+
+bool ScannerWidget::readQuery(ValueScanQuery& query) const {
+    query.filter = static_cast<ScanFilter>(m_filterBox->currentData().toInt());
+    if (query.filter != ScanFilter::Exact && query.filter != ScanFilter::Range) {
+        return true;
+    }
+
+    bool valueOk = false;
+    query.value = m_valueEdit->text().toDouble(&valueOk);
+    if (!valueOk) {
+        return false;
+    }
+
+    if (query.filter == ScanFilter::Range) {
+        bool upperOk = false;
+        query.upper = m_upperEdit->text().toDouble(&upperOk);
+        return upperOk;
+    }
+
+    // Точное совпадение без допуска; приближённое значение ищется условием Range
+    query.epsilon = 0;
+    return true;
+}
+
+void ScannerWidget::startScan(bool first) {
+    if (m_worker) {
+        return;
+    }
+
+    if (!m_memory) {
+        try {
+            m_memory = std::make_unique<MemoryManager>(m_processId);
+        } catch (const std::exception& e) {
+            m_statusLabel->setText(QString("Scan failed: %1").arg(e.what()));
+            LogManager::instance().warning(QString("Scanner memory manager: %1").arg(e.what()), "Scanner");
+            return;
+        }
+    }
+
+    ValueScanQuery query;
+    if (!readQuery(query)) {
+        m_statusLabel->setText("Invalid value");
+        return;
+    }
+
+    ValueScanOptions options;
+    options.type = static_cast<ScanValueType>(m_typeBox->currentData().toInt());
+
+    setBusy(true);
+    m_statusLabel->setText("Scanning...");
+    LogManager::instance().debug(QString("Starting %1 scan").arg(first ? "first" : "next"), "Scanner");
+
+    m_worker = QThread::create([this, first, options, query]() {
+        m_scanSucceeded = first ? m_scanner.firstScan(*m_memory, options, query)
+                                : m_scanner.nextScan(*m_memory, query);
+    });
+    connect(m_worker, &QThread::finished, this, &ScannerWidget::onScanFinished);
+    m_worker->start();
+}
+
+void ScannerWidget::onScanFinished() {
+    m_worker->deleteLater();
+    m_worker = nullptr;
+    setBusy(false);
+
+    if (!m_scanSucceeded) {
+        m_statusLabel->setText(QString("Scan failed: %1").arg(QString::fromStdString(m_scanner.error())));
+        LogManager::instance().warning(QString::fromStdString(m_scanner.error()), "Scanner");
+        return;
+    }
+
+    const ValueScanStats& stats = m_scanner.stats();
+    QString status = QString("Scan %1: %2 results in %3 ms, %4 MiB read, %5 KiB stored")
+        .arg(stats.scans)
+        .arg(stats.candidates)
+        .arg(stats.milliseconds, 0, 'f', 1)
+        .arg(stats.bytesRead / (1024 * 1024))
+        .arg(stats.storageBytes / 1024);
+    if (stats.failedShards > 0) {
+        // Кандидаты нечитаемых шардов отброшены: результат может быть неполным
+        status += QString(", %1 shards unreadable").arg(stats.failedShards);
+        LogManager::instance().warning(QString("Value scan %1: %2 shards could not be read")
+            .arg(stats.scans)
+            .arg(stats.failedShards), "Scanner");
+    }
+    m_statusLabel->setText(status);
+
+    const auto results = m_scanner.results(0, MAX_ROWS);
+    const bool isInteger = m_scanner.options().type != ScanValueType::Float &&
+                           m_scanner.options().type != ScanValueType::Double;
+    m_resultsTable->setRowCount(static_cast<int>(results.size()));
+    for (int row = 0; row < static_cast<int>(results.size()); row++) {
+        const ValueScanResult& result = results[row];
+        m_resultsTable->setItem(row, 0, new QTableWidgetItem(QString("0x%1").arg(result.address, 8, 16, QChar('0'))));
+        m_resultsTable->setItem(row, 1, new QTableWidgetItem(isInteger ? QString::number(static_cast<qulonglong>(result.value))
+                                                                       : QString::number(result.value)));
+    }
+
+    LogManager::instance().info(QString("Value scan %1 left %2 results").arg(stats.scans).arg(stats.candidates), "Scanner");
+}
+
+void ScannerWidget::resetScan() {
+    if (m_worker) {
+        return;
+    }
+    m_scanner.reset();
+    m_resultsTable->setRowCount(0);
+    m_statusLabel->setText("No scan");
+    m_nextButton->setEnabled(false);
+    m_typeBox->setEnabled(true);
+}
+
+void ScannerWidget::setBusy(bool busy) {
+    m_firstButton->setEnabled(!busy);
+    m_resetButton->setEnabled(!busy);
+    m_nextButton->setEnabled(!busy && m_scanner.hasScan());
+    // Тип значения фиксирован до сброса: следующие поиски сравнивают с сохранёнными значениями
+    m_typeBox->setEnabled(!busy && !m_scanner.hasScan());
+}
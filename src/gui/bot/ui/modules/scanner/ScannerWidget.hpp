@@ -0,0 +1,90 @@
+#pragma once
+#include <QWidget>
+#include <QComboBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QThread>
+#include <memory>
+#include "core/memory/MemoryManager.hpp"
+#include "core/memory/ValueScanner.hpp"
+
+/**
+ * @brief Виджет поиска значений в памяти клиента
+ * @details Позволяет найти адрес поля (здоровье, мана, уровень) после обновления клиента:
+ * - Первый поиск по точному значению, диапазону или неизвестному значению
+ * - Следующие поиски с условиями изменилось/не изменилось/увеличилось/уменьшилось
+ * - Таблица найденных адресов (первые MAX_ROWS) и статистика поиска
+ * Поиск выполняется в отдельном потоке, интерфейс остаётся отзывчивым.
+ */
+class ScannerWidget : public QWidget {
+    Q_OBJECT
+public:
+    static constexpr int MAX_ROWS = 1000; ///< Максимум строк в таблице результатов
+
+    /**
+     * @brief Конструктор виджета
+     * @param processId ID процесса WoW
+     * @param parent Родительский виджет
+     * @details Поиск работает со своим менеджером памяти (создаётся при первом поиске): MemoryManager
+     * не потокобезопасен, а менеджер BotCore в это время читает память в тике бота
+     */
+    explicit ScannerWidget(DWORD processId, QWidget* parent = nullptr);
+
+    /**
+     * @brief Деструктор
+     * @details Дожидается завершения поиска, если он выполняется, и удаляет его поток
+     */
+    ~ScannerWidget();
+
+private:
+    /**
+     * @brief Инициализация UI компонентов
+     */
+    void setupUi();
+
+    /**
+     * @brief Запускает поиск в отдельном потоке
+     * @param first true - первый поиск, false - следующий
+     */
+    void startScan(bool first);
+
+    /**
+     * @brief Обрабатывает завершение поиска: выводит результаты и статистику
+     */
+    void onScanFinished();
+
+    /**
+     * @brief Сбрасывает результаты поиска
+     */
+    void resetScan();
+
+    /**
+     * @brief Собирает условие поиска из полей ввода
+     * @param query Условие
+     * @return false если значение не задано или задано неверно
+     */
+    bool readQuery(ValueScanQuery& query) const;
+
+    /**
+     * @brief Блокирует кнопки на время поиска
+     */
+    void setBusy(bool busy);
+
+    DWORD m_processId{0};                      ///< ID процесса WoW
+    std::unique_ptr<MemoryManager> m_memory;   ///< Менеджер памяти потока поиска
+    ValueScanner m_scanner;                    ///< Движок поиска
+    QThread* m_worker{nullptr};                ///< Поток текущего поиска
+    bool m_scanSucceeded{false};               ///< Результат последнего поиска
+
+    QComboBox* m_typeBox{nullptr};             ///< Тип значения
+    QComboBox* m_filterBox{nullptr};           ///< Условие
+    QLineEdit* m_valueEdit{nullptr};           ///< Значение / нижняя граница
+    QLineEdit* m_upperEdit{nullptr};           ///< Верхняя граница диапазона
+    QPushButton* m_firstButton{nullptr};       ///< Кнопка первого поиска
+    QPushButton* m_nextButton{nullptr};        ///< Кнопка следующего поиска
+    QPushButton* m_resetButton{nullptr};       ///< Кнопка сброса
+    QLabel* m_statusLabel{nullptr};            ///< Статистика последнего поиска
+    QTableWidget* m_resultsTable{nullptr};     ///< Найденные адреса
+};
@@ -0,0 +1,1076 @@
+/**
+ * @file main.cpp
+ * @brief Нагрузочные замеры подсистемы памяти на синтетической модели процесса
+ * @details Примеры:
+ * @code
+ * mdbot_bench --list
+ * mdbot_bench --case read-cache --iterations 1000
+ * mdbot_bench
+ * @endcode
+ * "Процесс" собирается из буферов самой утилиты через InProcessBackend, поэтому замеры
+ * воспроизводимы без клиента и проходят через те же пути MemoryManager, что и живой процесс.
+ * Чтение из такого бэкенда - memcpy, а не системный вызов: где важна цена ReadProcessMemory,
+ * выводится число обращений к бэкенду.
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QTextStream>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <cstring>
+
+#include "core/memory/MemoryManager.hpp"
+#include "core/memory/PointerChain.hpp"
+#include "core/memory/PointerScanner.hpp"
+#include "core/memory/ValueScanner.hpp"
+#include "gui/bot/core/entities/EntityTable.hpp"
+#include "gui/bot/core/entities/GuidMap.hpp"
+#include "gui/bot/core/entities/RefreshPlanner.hpp"
+#include "gui/bot/core/entities/SpatialGrid.hpp"
+#include "gui/bot/core/objects/ObjectWalker.hpp"
+
+
+namespace
+{
+    QTextStream& out()
+    {
+        static QTextStream stream(stdout);
+        return stream;
+    }
+
+    /**
+     * @brief Параметры замеров из командной строки
+     */
+    struct BenchOptions
+    {
+        size_t   size{0};       ///< Объём синтетической памяти в байтах (0 - значение по умолчанию замера)
+        uint32_t iterations{0}; ///< Количество повторов или тиков (0 - значение по умолчанию замера)
+        unsigned threads{0};    ///< Количество потоков (0 - по числу ядер)
+    };
+
+    /**
+     * @brief Замер
+     */
+    struct BenchCase
+    {
+        const char* name;                          ///< Имя для --case
+        const char* description;                   ///< Описание для --list
+        void (*run)(const BenchOptions& options); ///< Тело замера
+    };
+
+    /**
+     * @class SyntheticTarget
+     * @brief Модель процесса: менеджер памяти поверх InProcessBackend и буферы его регионов
+     */
+    class SyntheticTarget
+    {
+      public:
+        /**
+         * @brief Менеджер памяти модели
+         */
+        MemoryManager& memory() { return m_memory; }
+
+        /**
+         * @brief Выделяет регион для чтения и записи
+         * @details Адрес региона совпадает с адресом буфера утилиты, поэтому его можно заполнять напрямую
+         */
+        uint8_t* allocate(size_t size)
+        {
+            return static_cast<uint8_t*>(m_memory.AllocateMemory(nullptr, size, PAGE_READWRITE));
+        }
+
+        /**
+         * @brief Создаёт регион по заданному адресу модели (статические адреса 32-битного клиента)
+         * @return Буфер региона (заполнен нулями)
+         */
+        uint8_t* map(uintptr_t address, size_t size, DWORD type = MEM_PRIVATE)
+        {
+            uint8_t* data = m_buffers.emplace_back(std::make_unique<uint8_t[]>(size)).get();
+            std::get<InProcessBackend>(m_memory.GetBackend()).addRegionAt(address, data, size, PAGE_READWRITE, type);
+            m_memory.InvalidateRegionMap();
+            return data;
+        }
+
+        /**
+         * @brief Регистрирует модуль по адресу модели
+         */
+        void addModule(const std::wstring& name, uintptr_t base, size_t size)
+        {
+            std::get<InProcessBackend>(m_memory.GetBackend()).addModuleAt(name, base, size);
+            m_memory.RefreshModules();
+        }
+
+      private:
+        std::vector<std::unique_ptr<uint8_t[]>> m_buffers; ///< Буферы map() (уничтожаются после менеджера)
+        MemoryManager                           m_memory{MemoryBackend(InProcessBackend{})}; ///< Менеджер памяти
+    };
+
+    /**
+     * @brief Значение параметра или значение по умолчанию замера
+     */
+    template <typename T>
+    T valueOr(T value, T fallback)
+    {
+        return value != 0 ? value : fallback;
+    }
+
+    /**
+     * @brief Заполняет буфер псевдослучайными байтами (xorshift64, воспроизводимо по seed)
+     */
+    void fillRandom(uint8_t* data, size_t size, uint64_t seed)
+    {
+        uint64_t state = seed | 1;
+        for (size_t i = 0; i < size; i += sizeof(state))
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            std::memcpy(data + i, &state, std::min(sizeof(state), size - i));
+        }
+    }
+
+    /**
+     * @brief Пропускная способность в GB/s
+     */
+    QString throughput(uint64_t bytes, qint64 nanoseconds)
+    {
+        const double seconds = static_cast<double>(std::max<qint64>(nanoseconds, 1)) / 1e9;
+        return QString::number(static_cast<double>(bytes) / seconds / 1e9, 'f', 2) + " GB/s";
+    }
+
+    /**
+     * @brief Длительность в миллисекундах с двумя знаками
+     */
+    QString milliseconds(qint64 nanoseconds)
+    {
+        return QString::number(static_cast<double>(nanoseconds) / 1e6, 'f', 2) + " ms";
+    }
+
+    /**
+     * @brief Кэш чтения: пять полей каждого из 100 существ за тик, без кэша и с кэшем
+     * @details Существа лежат подряд с шагом 0x800, как в куче клиента. Без кэша каждое поле -
+     * отдельное обращение к бэкенду; с кэшем - загрузки страниц плюс чтения в обход кэша.
+     */
+    void benchReadCache(const BenchOptions& options)
+    {
+        constexpr size_t   UNITS       = 100;
+        constexpr size_t   UNIT_STRIDE = 0x800;
+        constexpr uint32_t FIELDS[]    = {0x30, 0x798, 0x79C, 0x7A0, 0x7A8}; // GUID, x, y, z, направление
+
+        const uint32_t ticks = valueOr<uint32_t>(options.iterations, 1000);
+
+        SyntheticTarget target;
+        MemoryManager&  memory = target.memory();
+        uint8_t*        units  = target.allocate(UNITS * UNIT_STRIDE);
+        for (size_t i = 0; i < UNITS * UNIT_STRIDE; i += 4)
+        {
+            const uint32_t value = static_cast<uint32_t>(i);
+            std::memcpy(units + i, &value, sizeof(value));
+        }
+
+        out() << "read-cache: " << UNITS << " units x " << std::size(FIELDS) << " fields, " << ticks << " ticks"
+              << Qt::endl;
+
+        for (const bool cached : {false, true})
+        {
+            memory.EnableReadCache(cached);
+            memory.ResetReadCacheStats();
+
+            uint64_t      reads = 0;
+            uint32_t      sink  = 0;
+            QElapsedTimer timer;
+            timer.start();
+            for (uint32_t tick = 0; tick < ticks; tick++)
+            {
+                memory.BeginTick();
+                for (size_t unit = 0; unit < UNITS; unit++)
+                {
+                    const uintptr_t address = reinterpret_cast<uintptr_t>(units) + unit * UNIT_STRIDE;
+                    for (const uint32_t field : FIELDS)
+                    {
+                        sink ^= memory.Read<uint32_t>(address + field);
+                        reads++;
+                    }
+                }
+            }
+            const qint64 elapsed = timer.nsecsElapsed();
+
+            const PageCache::Stats& stats   = memory.GetReadCacheStats();
+            const uint64_t          backend = cached ? stats.pageFetches + stats.bypasses : reads;
+            out() << (cached ? "  cached:   " : "  uncached: ") << backend / ticks << " backend reads per tick ("
+                  << reads / ticks << " Read calls, " << stats.hits / ticks << " hits), "
+                  << milliseconds(elapsed / ticks) << " per tick [" << (sink & 1) << "]" << Qt::endl;
+        }
+    }
+
+    /**
+     * @brief Поиск сигнатуры в 16 MiB образе на каждом доступном уровне SIMD
+     * @details Образ заполнен случайными байтами, сигнатура с wildcard лежит в последнем мегабайте.
+     * "kernel" - PatternScanner::find по буферу, "FindPattern" - полный путь MemoryManager с обходом
+     * регионов и чтением блоками по 1 MiB.
+     */
+    void benchPatternScan(const BenchOptions& options)
+    {
+        const size_t   size       = valueOr<size_t>(options.size, size_t{16} << 20);
+        const uint32_t iterations = valueOr<uint32_t>(options.iterations, 20);
+
+        static constexpr char PATTERN[] = "\x55\x8B\xEC\x83\xEC\x00\x53\x56\x8B\xF1\xE8";
+        static constexpr char MASK[]    = "xxxxx?xxxxx";
+        const BytePattern     pattern(PATTERN, MASK);
+
+        SyntheticTarget target;
+        MemoryManager&  memory = target.memory();
+        uint8_t*        image  = target.allocate(size);
+        fillRandom(image, size, 0x5CA9);
+        const size_t planted = size - (size >> 4);
+        std::memcpy(image + planted, PATTERN, pattern.size());
+
+        out() << "pattern-scan: " << (size >> 20) << " MiB image, " << pattern.size() << "-byte pattern, "
+              << iterations << " iterations" << Qt::endl;
+
+        const PatternScanner::SimdLevel detected = PatternScanner::simdLevel();
+        const PatternScanner::SimdLevel levels[] = {
+            PatternScanner::SimdLevel::Scalar, PatternScanner::SimdLevel::SSE2, PatternScanner::SimdLevel::AVX2};
+        const char* names[] = {"scalar", "SSE2", "AVX2"};
+        for (size_t i = 0; i < std::size(levels) && levels[i] <= detected; i++)
+        {
+            PatternScanner::setSimdLevel(levels[i]);
+
+            QElapsedTimer timer;
+            timer.start();
+            size_t found = 0;
+            for (uint32_t iteration = 0; iteration < iterations; iteration++)
+            {
+                found = PatternScanner::find(image, size, pattern);
+            }
+            const qint64 kernel = timer.nsecsElapsed();
+
+            timer.start();
+            uintptr_t address = 0;
+            for (uint32_t iteration = 0; iteration < iterations; iteration++)
+            {
+                address = memory.FindPattern(PATTERN, MASK);
+            }
+            const qint64 full = timer.nsecsElapsed();
+
+            const bool correct = found == planted && address == reinterpret_cast<uintptr_t>(image) + planted;
+            out() << "  " << names[i] << ": kernel " << throughput(uint64_t{planted} * iterations, kernel)
+                  << ", FindPattern " << throughput(uint64_t{planted} * iterations, full)
+                  << (correct ? "" : " (WRONG RESULT)") << Qt::endl;
+        }
+        PatternScanner::setSimdLevel(detected);
+    }
+
+    /**
+     * @brief Масштабирование параллельного поиска сигнатуры по числу потоков
+     * @details Куча 256 MiB из 64 отдельных регионов, сигнатуры в ней нет, поэтому каждый прогон
+     * читает всю память (findAll). Потоки удваиваются от 1 до --threads (по умолчанию - по числу ядер).
+     */
+    void benchParallelScan(const BenchOptions& options)
+    {
+        constexpr size_t REGIONS = 64;
+
+        const size_t   size       = valueOr<size_t>(options.size, size_t{256} << 20);
+        const uint32_t iterations = valueOr<uint32_t>(options.iterations, 5);
+        const unsigned cores      = std::max(1u, std::thread::hardware_concurrency());
+        const unsigned maxThreads = valueOr<unsigned>(options.threads, cores);
+        const size_t   regionSize = (size / REGIONS + 0xFFF) & ~size_t{0xFFF};
+
+        SyntheticTarget target;
+        MemoryManager&  memory = target.memory();
+        for (size_t i = 0; i < REGIONS; i++)
+        {
+            fillRandom(target.allocate(regionSize), regionSize, 0x9A11E1 + i);
+        }
+        const BytePattern pattern("\x8B\x0D\x00\x00\x00\x00\x85\xC9\x74\x00\x8B\x01", "xx????xxx?xx");
+
+        out() << "parallel-scan: " << (regionSize * REGIONS >> 20) << " MiB in " << REGIONS << " regions, "
+              << iterations << " iterations, " << cores << " cores" << Qt::endl;
+
+        qint64 single = 0;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            ParallelScanOptions scanOptions;
+            scanOptions.threads = threads;
+            scanOptions.findAll = true;
+
+            QElapsedTimer timer;
+            timer.start();
+            size_t matches = 0;
+            for (uint32_t iteration = 0; iteration < iterations; iteration++)
+            {
+                matches += memory.FindPatternParallel(pattern, scanOptions).size();
+            }
+            const qint64 elapsed = timer.nsecsElapsed() / iterations;
+            single               = threads == 1 ? elapsed : single;
+
+            out() << "  " << threads << " threads: " << milliseconds(elapsed) << ", "
+                  << throughput(regionSize * REGIONS, elapsed) << ", speedup "
+                  << QString::number(static_cast<double>(single) / static_cast<double>(elapsed), 'f', 2) << "x, "
+                  << matches / iterations << " matches" << Qt::endl;
+        }
+    }
+
+    /**
+     * @brief Чтения на одно разрешение PointerChain при разных сроках жизни звеньев
+     * @details Цепочка ClientConnection -> менеджер объектов -> первый объект -> GUID по статическим
+     * адресам клиента 3.3.5a (три читаемых звена). В каждом тике цепочка разрешается четыре раза,
+     * как её разрешали бы несколько потребителей.
+     */
+    void benchPointerChain(const BenchOptions& options)
+    {
+        using FirstObjectGuid = PointerChain<0xC79CE0, 0x2ED0, 0xAC, 0x30>;
+
+        constexpr uintptr_t CONNECTION        = 0x10000000;
+        constexpr uintptr_t MANAGER           = 0x11000000;
+        constexpr uintptr_t OBJECT            = 0x12000000;
+        constexpr uint32_t  RESOLVES_PER_TICK = 4;
+
+        const uint32_t ticks = valueOr<uint32_t>(options.iterations, 1000);
+
+        SyntheticTarget target;
+        MemoryManager&  memory  = target.memory();
+        const auto      pointer = [](uint8_t* data, size_t offset, uintptr_t value)
+        { std::memcpy(data + offset, &value, sizeof(value)); };
+        pointer(target.map(0xC79000, 0x1000, MEM_IMAGE), 0xCE0, CONNECTION);
+        pointer(target.map(CONNECTION, 0x3000), 0x2ED0, MANAGER);
+        pointer(target.map(MANAGER, 0x1000), 0xAC, OBJECT);
+        target.map(OBJECT, 0x1000);
+
+        out() << "pointer-chain: " << FirstObjectGuid::LINK_COUNT << " links, " << RESOLVES_PER_TICK
+              << " resolutions per tick, " << ticks << " ticks" << Qt::endl;
+
+        struct Setup
+        {
+            const char* name;   ///< Название
+            uint64_t    prefix; ///< Срок жизни звеньев 0..n-2
+            uint64_t    last;   ///< Срок жизни последнего звена
+        };
+        const Setup setups[] = {
+            {"no caching", 0, 0},
+            {"one tick", 1, 1},
+            {"pinned prefix, last link uncached", FirstObjectGuid::FOREVER, 0},
+            {"pinned prefix, last link per tick", FirstObjectGuid::FOREVER, 1},
+        };
+        for (const Setup& setup : setups)
+        {
+            FirstObjectGuid chain;
+            for (size_t link = 0; link < FirstObjectGuid::LINK_COUNT; link++)
+            {
+                chain.setLinkLifetime(link, link + 1 < FirstObjectGuid::LINK_COUNT ? setup.prefix : setup.last);
+            }
+
+            uintptr_t address = 0;
+            for (uint32_t tick = 0; tick < ticks; tick++)
+            {
+                memory.BeginTick();
+                for (uint32_t resolve = 0; resolve < RESOLVES_PER_TICK; resolve++)
+                {
+                    chain.resolve(memory, address);
+                }
+            }
+
+            const auto& stats = chain.stats();
+            out() << "  " << setup.name << ": " << QString::number(stats.readsPerResolution(), 'f', 2)
+                  << " reads per resolution (" << stats.failures << " failures"
+                  << (address == OBJECT + 0x30 ? "" : ", WRONG ADDRESS") << ")" << Qt::endl;
+        }
+    }
+
+    /**
+     * @brief Read<T> с исключением против TryRead<T> при 10% неудачных чтений
+     * @details Каждое десятое чтение идёт по адресу вне регионов модели (существо исчезло между
+     * тиками). Кэш чтения выключен, чтобы отказы доходили до бэкенда.
+     */
+    void benchTryRead(const BenchOptions& options)
+    {
+        constexpr size_t    REGION_SIZE = 0x100000;
+        constexpr uintptr_t UNMAPPED    = 0x20000000;
+
+        const uint32_t reads = valueOr<uint32_t>(options.iterations, 1000000);
+
+        SyntheticTarget target;
+        MemoryManager&  memory = target.memory();
+        uint8_t*        region = target.allocate(REGION_SIZE);
+        fillRandom(region, REGION_SIZE, 0x7E57);
+
+        std::vector<uintptr_t> addresses(reads);
+        uint64_t               state = 0x1234567;
+        for (uint32_t i = 0; i < reads; i++)
+        {
+            state             = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const auto offset = static_cast<uintptr_t>((state >> 33) % (REGION_SIZE / 4)) * 4;
+            addresses[i]      = (i % 10 == 9 ? UNMAPPED : reinterpret_cast<uintptr_t>(region)) + offset;
+        }
+
+        out() << "try-read: " << reads << " u32 reads, 10% failing" << Qt::endl;
+
+        uint32_t      sum      = 0;
+        uint32_t      failures = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (const uintptr_t address : addresses)
+        {
+            try
+            {
+                sum += memory.Read<uint32_t>(address);
+            }
+            catch (const std::system_error&)
+            {
+                failures++;
+            }
+        }
+        const qint64 throwing = timer.nsecsElapsed();
+        out() << "  Read<T> + catch: " << QString::number(static_cast<double>(throwing) / reads, 'f', 1)
+              << " ns per read, " << failures << " failures [" << (sum & 1) << "]" << Qt::endl;
+
+        memory.ResetReadFailureStats();
+        sum      = 0;
+        failures = 0;
+        timer.start();
+        for (const uintptr_t address : addresses)
+        {
+            const ReadResult<uint32_t> value = memory.TryRead<uint32_t>(address);
+            if (value)
+            {
+                sum += *value;
+            }
+            else
+            {
+                failures++;
+            }
+        }
+        const qint64 expected = timer.nsecsElapsed();
+        out() << "  TryRead<T>:      " << QString::number(static_cast<double>(expected) / reads, 'f', 1)
+              << " ns per read, " << failures << " failures (" << memory.GetReadFailureStats().total()
+              << " counted) [" << (sum & 1) << "]" << Qt::endl;
+        const double speedup = static_cast<double>(throwing) / static_cast<double>(expected);
+        out() << "  speedup " << QString::number(speedup, 'f', 1) << "x" << Qt::endl;
+    }
+
+    /**
+     * @brief Первый и следующий поиск значения u32 в 1 GiB
+     * @details Память - 16 регионов случайных байт. Для точного поиска значение вписано в 4096 адресов,
+     * перед следующим поиском половина из них меняется. Поиск неизвестного значения снимает всю память,
+     * затем меняется каждое тысячное значение и выполняется поиск Changed.
+     */
+    void benchValueScan(const BenchOptions& options)
+    {
+        constexpr size_t   REGIONS = 16;
+        constexpr size_t   PLANTED = 4096;
+        constexpr uint32_t VALUE   = 0x0BADF00D;
+
+        const size_t size       = valueOr<size_t>(options.size, size_t{1} << 30);
+        const size_t regionSize = (size / REGIONS + 0xFFF) & ~size_t{0xFFF};
+
+        SyntheticTarget       target;
+        MemoryManager&        memory = target.memory();
+        std::vector<uint8_t*> regions;
+        for (size_t i = 0; i < REGIONS; i++)
+        {
+            regions.push_back(target.allocate(regionSize));
+            fillRandom(regions.back(), regionSize, 0x5EED + i);
+        }
+
+        // i-е значение из n, равномерно по всей памяти
+        const auto slot = [&](size_t i, size_t n) -> uint32_t*
+        {
+            const size_t word = i * (REGIONS * regionSize / 4 / n);
+            return reinterpret_cast<uint32_t*>(regions[word / (regionSize / 4)]) + word % (regionSize / 4);
+        };
+
+        ValueScanOptions scanOptions;
+        scanOptions.type    = ScanValueType::UInt32;
+        scanOptions.threads = options.threads;
+
+        out() << "value-scan: " << (REGIONS * regionSize >> 20) << " MiB in " << REGIONS << " regions, "
+              << (options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency()))
+              << " threads" << Qt::endl;
+
+        const auto report = [](const char* name, const ValueScanner& scanner)
+        {
+            const ValueScanStats& stats = scanner.stats();
+            out() << "  " << name << QString::number(stats.milliseconds, 'f', 0) << " ms, " << stats.candidates
+                  << " candidates, " << (stats.bytesRead >> 20) << " MiB read, " << (stats.storageBytes >> 20)
+                  << " MiB stored" << Qt::endl;
+        };
+
+        ValueScanner scanner;
+        for (size_t i = 0; i < PLANTED; i++)
+        {
+            *slot(i, PLANTED) = VALUE;
+        }
+        scanner.firstScan(memory, scanOptions, {ScanFilter::Exact, VALUE});
+        report("exact first scan:   ", scanner);
+
+        for (size_t i = 0; i < PLANTED; i += 2)
+        {
+            *slot(i, PLANTED) = VALUE + 1;
+        }
+        scanner.nextScan(memory, {ScanFilter::Exact, VALUE});
+        report("exact next scan:    ", scanner);
+
+        scanner.firstScan(memory, scanOptions, {ScanFilter::Unknown});
+        report("unknown first scan: ", scanner);
+
+        const size_t changed = REGIONS * regionSize / 4 / 1000;
+        for (size_t i = 0; i < changed; i++)
+        {
+            *slot(i, changed) += 1;
+        }
+        scanner.nextScan(memory, {ScanFilter::Changed});
+        report("changed next scan:  ", scanner);
+    }
+
+    /**
+     * @brief Построение индекса указателей и поиск цепочек глубины 3 и 4 в 1 GiB 32-битной памяти
+     * @details Куча из 16 регионов начиная с 0x10000000: каждое десятое слово - указатель на случайный
+     * адрес кучи, остальные - малые числа. В образе run.exe (0x400000, 16 MiB) каждое сотое слово -
+     * указатель в кучу, плюс вписана цепочка run.exe+0x879CE0 -> 0x1D8 -> 0xAC -> 0x30 до цели
+     * (смещения в пределах maxOffset по умолчанию).
+     */
+    void benchPointerScan(const BenchOptions& options)
+    {
+        constexpr size_t    REGIONS    = 16;
+        constexpr uintptr_t HEAP       = 0x10000000;
+        constexpr uintptr_t IMAGE      = 0x400000;
+        constexpr size_t    IMAGE_SIZE = 0x1000000;
+
+        const size_t size       = valueOr<size_t>(options.size, size_t{1} << 30);
+        const size_t regionSize = (size / REGIONS + 0xFFF) & ~size_t{0xFFF};
+        const size_t heapSize   = regionSize * REGIONS;
+
+        SyntheticTarget target;
+        MemoryManager&  memory = target.memory();
+        uint64_t        state  = 0xC0FFEE;
+        const auto      next   = [&state]()
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<uint32_t>(state >> 32);
+        };
+        const auto heapPointer = [&]() { return static_cast<uint32_t>(HEAP + (next() % (heapSize / 4)) * 4); };
+
+        std::vector<uint32_t*> regions;
+        for (size_t i = 0; i < REGIONS; i++)
+        {
+            auto* words = reinterpret_cast<uint32_t*>(target.map(HEAP + i * regionSize, regionSize));
+            for (size_t word = 0; word < regionSize / 4; word++)
+            {
+                words[word] = word % 10 == 0 ? heapPointer() : next() & 0xFFFF;
+            }
+            regions.push_back(words);
+        }
+        auto* image = reinterpret_cast<uint32_t*>(target.map(IMAGE, IMAGE_SIZE, MEM_IMAGE));
+        for (size_t word = 0; word < IMAGE_SIZE / 4; word += 100)
+        {
+            image[word] = heapPointer();
+        }
+        target.addModule(L"run.exe", IMAGE, IMAGE_SIZE);
+
+        // Цепочка до цели: узлы в разных регионах, поверх случайных данных
+        const auto heapWord = [&](uintptr_t address) -> uint32_t&
+        { return regions[(address - HEAP) / regionSize][(address - HEAP) % regionSize / 4]; };
+        const uintptr_t connection = HEAP + 3 * regionSize + 0x1230;
+        const uintptr_t manager    = HEAP + 9 * regionSize + 0x4560;
+        const uintptr_t object     = HEAP + 14 * regionSize + 0x7890;
+        image[0x879CE0 / 4]          = static_cast<uint32_t>(connection);
+        heapWord(connection + 0x1D8) = static_cast<uint32_t>(manager);
+        heapWord(manager + 0xAC)     = static_cast<uint32_t>(object);
+
+        PointerIndexOptions indexOptions;
+        indexOptions.threads = options.threads;
+
+        PointerScanner scanner;
+        scanner.buildIndex(memory, indexOptions);
+        const PointerScanStats& stats = scanner.stats();
+        out() << "pointer-scan: " << (heapSize >> 20) << " MiB heap, "
+              << (options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency()))
+              << " threads" << Qt::endl;
+        out() << "  index: " << stats.pointers << " pointers, " << (stats.indexBytes >> 20) << " MiB, "
+              << QString::number(stats.indexMilliseconds, 'f', 0) << " ms" << Qt::endl;
+
+        for (const size_t depth : {size_t{3}, size_t{4}})
+        {
+            PointerSearchOptions searchOptions;
+            searchOptions.maxDepth = depth;
+            searchOptions.modules  = {L"run.exe"};
+            searchOptions.threads  = options.threads;
+
+            const std::vector<PointerPath> paths = scanner.findPaths(object + 0x30, searchOptions);
+            const auto planted = [](const PointerPath& path)
+            { return path.base == IMAGE + 0x879CE0 && path.offsets == std::vector<uint32_t>{0x1D8, 0xAC, 0x30}; };
+            const bool found = std::any_of(paths.begin(), paths.end(), planted);
+            out() << "  depth " << depth << ": " << QString::number(stats.searchMilliseconds, 'f', 0) << " ms, "
+                  << stats.nodes << " nodes, " << stats.paths << " paths" << (stats.truncated ? " (truncated)" : "")
+                  << (found ? "" : ", PLANTED PATH MISSING") << Qt::endl;
+        }
+    }
+
+    /**
+     * @brief Проход по 2000 сущностей: столбцы EntityTable против вектора ObjectSnapshot
+     * @details Запрос - живые существа в радиусе 40 ярдов от игрока (тип, x, y, здоровье). Вектор снимков -
+     * прежнее хранение (структура на объект), таблица читает только нужные столбцы. Условие в обоих
+     * проходах записано без ветвлений, чтобы компилятор мог векторизовать любой из них.
+     */
+    void benchEntityScan(const BenchOptions& options)
+    {
+        constexpr size_t ENTITIES = 2000;
+        constexpr float  RANGE    = 40.0f;
+
+        const uint32_t iterations = valueOr<uint32_t>(options.iterations, 20000);
+
+        std::vector<ObjectSnapshot> snapshots(ENTITIES);
+        uint64_t                    state = 0xE7717;
+        const auto                  next  = [&state]()
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<uint32_t>(state >> 32);
+        };
+        for (size_t i = 0; i < ENTITIES; i++)
+        {
+            ObjectSnapshot& object = snapshots[i];
+            object.guid            = 0xF130000000000000ULL | i;
+            object.address         = static_cast<uint32_t>(0x10000000 + i * 0x1000);
+            object.type            = next() % 4 == 0 ? ObjectType::Item : ObjectType::Unit;
+            object.x               = static_cast<float>(next() % 40000) / 100.0f;
+            object.y               = static_cast<float>(next() % 40000) / 100.0f;
+            object.health          = next() % 8 == 0 ? 0 : 1 + next() % 10000;
+        }
+
+        EntityTable table;
+        table.append(snapshots);
+
+        const float originX = 200.0f;
+        const float originY = 200.0f;
+
+        out() << "entity-scan: " << ENTITIES << " entities (" << sizeof(ObjectSnapshot) << "-byte snapshots), "
+              << iterations << " scans" << Qt::endl;
+
+        QElapsedTimer timer;
+        timer.start();
+        size_t aosFound = 0;
+        for (uint32_t iteration = 0; iteration < iterations; iteration++)
+        {
+            for (const ObjectSnapshot& object : snapshots)
+            {
+                const float dx = object.x - originX;
+                const float dy = object.y - originY;
+                const bool  alive = (object.type == ObjectType::Unit) & (object.health > 0);
+                aosFound += alive & (dx * dx + dy * dy <= RANGE * RANGE);
+            }
+        }
+        const qint64 aos = timer.nsecsElapsed();
+
+        const std::span<const ObjectType> types  = table.types();
+        const std::span<const float>      x      = table.x();
+        const std::span<const float>      y      = table.y();
+        const std::span<const uint32_t>   health = table.health();
+        timer.start();
+        size_t soaFound = 0;
+        for (uint32_t iteration = 0; iteration < iterations; iteration++)
+        {
+            for (size_t i = 0; i < table.size(); i++)
+            {
+                const float dx = x[i] - originX;
+                const float dy = y[i] - originY;
+                const bool  alive = (types[i] == ObjectType::Unit) & (health[i] > 0);
+                soaFound += alive & (dx * dx + dy * dy <= RANGE * RANGE);
+            }
+        }
+        const qint64 soa = timer.nsecsElapsed();
+
+        const auto perScan = [&](qint64 elapsed)
+        { return QString::number(static_cast<double>(elapsed) / iterations / 1000.0, 'f', 2) + " us per scan"; };
+        out() << "  snapshot vector: " << perScan(aos) << ", " << aosFound / iterations << " matches" << Qt::endl;
+        out() << "  entity table:    " << perScan(soa) << ", " << soaFound / iterations << " matches" << Qt::endl;
+        out() << "  speedup " << QString::number(static_cast<double>(aos) / static_cast<double>(soa), 'f', 1) << "x"
+              << Qt::endl;
+    }
+
+    /**
+     * @brief Чтения за тик: полный обход списка объектов против RefreshPlanner
+     * @details Синтетический менеджер объектов клиента 3.3.5a по его статическим адресам: 400 объектов
+     * (игрок, 199 существ, 150 предметов, 50 игровых объектов) в перемешанном порядке. Игрок выбрал целью
+     * одно существо, 8 существ рядом выбрали целью игрока. Полный обход - ObjectWalker в режиме Full
+     * и EntityTable::sync каждый тик, как до RefreshPlanner.
+     */
+    void benchEntityRefresh(const BenchOptions& options)
+    {
+        constexpr uintptr_t CONNECTION        = 0x01000000;
+        constexpr uintptr_t MANAGER           = 0x01100000;
+        constexpr uintptr_t OBJECTS           = 0x02000000;
+        constexpr uintptr_t DESCRIPTORS       = 0x03000000;
+        constexpr uint32_t  OBJECT_STRIDE     = 0x2000;
+        constexpr uint32_t  DESCRIPTOR_STRIDE = 0x400;
+        constexpr size_t    UNITS             = 200; // Вместе с игроком
+        constexpr size_t    ITEMS             = 150;
+        constexpr size_t    GAME_OBJECTS      = 50;
+        constexpr size_t    COUNT             = UNITS + ITEMS + GAME_OBJECTS;
+        constexpr uint64_t  PLAYER_GUID       = 0x0000000000000001ULL;
+
+        const uint32_t ticks = valueOr<uint32_t>(options.iterations, 160);
+
+        SyntheticTarget target;
+        MemoryManager&  memory      = target.memory();
+        uint8_t*        staticPage  = target.map(0xC79000, 0x1000, MEM_IMAGE);
+        uint8_t*        connection  = target.map(CONNECTION, 0x3000);
+        uint8_t*        manager     = target.map(MANAGER, 0x1000);
+        uint8_t*        objects     = target.map(OBJECTS, COUNT * OBJECT_STRIDE);
+        uint8_t*        descriptors = target.map(DESCRIPTORS, COUNT * DESCRIPTOR_STRIDE);
+
+        const auto put = [](uint8_t* data, uint32_t offset, auto value)
+        { std::memcpy(data + offset, &value, sizeof(value)); };
+
+        // Порядок в списке: игрок первым, остальные типы перемешаны
+        std::vector<ObjectType> types;
+        types.push_back(ObjectType::Player);
+        types.insert(types.end(), UNITS - 1, ObjectType::Unit);
+        types.insert(types.end(), ITEMS, ObjectType::Item);
+        types.insert(types.end(), GAME_OBJECTS, ObjectType::GameObject);
+        uint64_t state = 0x0B1EC7;
+        for (size_t i = COUNT - 1; i > 1; i--)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            std::swap(types[i], types[1 + (state >> 33) % i]);
+        }
+
+        put(staticPage, 0xCE0, static_cast<uint32_t>(CONNECTION));
+        put(connection, ObjectOffsets::CURRENT_MANAGER, static_cast<uint32_t>(MANAGER));
+        put(manager, ObjectOffsets::FIRST_OBJECT, static_cast<uint32_t>(OBJECTS));
+        put(manager, ObjectOffsets::LOCAL_GUID, PLAYER_GUID);
+
+        size_t units = 0;
+        for (size_t i = 0; i < COUNT; i++)
+        {
+            uint8_t*       object     = objects + i * OBJECT_STRIDE;
+            uint8_t*       descriptor = descriptors + i * DESCRIPTOR_STRIDE;
+            const uint64_t guid       = PLAYER_GUID + i;
+            const bool     last       = i + 1 == COUNT;
+
+            put(object, ObjectOffsets::DESCRIPTORS, static_cast<uint32_t>(DESCRIPTORS + i * DESCRIPTOR_STRIDE));
+            put(object, ObjectOffsets::TYPE, static_cast<uint32_t>(types[i]));
+            put(object, ObjectOffsets::GUID, guid);
+            const uint32_t next = last ? 0u : static_cast<uint32_t>(OBJECTS + (i + 1) * OBJECT_STRIDE);
+            put(object, ObjectOffsets::NEXT_OBJECT, next);
+            put(descriptor, ObjectOffsets::OBJECT_GUID, guid);
+            put(descriptor, ObjectOffsets::ENTRY, static_cast<uint32_t>(1000 + i));
+
+            if (types[i] == ObjectType::GameObject)
+            {
+                put(object, ObjectOffsets::GAMEOBJECT_POSITION, 50.0f + static_cast<float>(i % 20) * 15.0f);
+            }
+            if (types[i] != ObjectType::Unit && types[i] != ObjectType::Player)
+            {
+                continue;
+            }
+
+            // Игрок в (100, 100); первые 8 существ рядом с ним и выбрали его целью, остальные разбросаны
+            const bool  player = types[i] == ObjectType::Player;
+            const bool  near   = units >= 1 && units <= 8;
+            const float nearX  = 100.0f + static_cast<float>(units) * 2.0f;
+            const float x      = player ? 100.0f : near ? nearX : 10.0f * static_cast<float>(units % 40);
+            const float y      = player || near ? 100.0f : 10.0f * static_cast<float>(units / 40) + 200.0f;
+            put(object, ObjectOffsets::UNIT_POSITION, x);
+            put(object, ObjectOffsets::UNIT_POSITION + 4, y);
+            put(descriptor, ObjectOffsets::TARGET, near ? PLAYER_GUID : uint64_t{0});
+            put(descriptor, ObjectOffsets::HEALTH, 5000u);
+            put(descriptor, ObjectOffsets::MAX_HEALTH, 5000u);
+            put(descriptor, ObjectOffsets::LEVEL, 80u);
+            units++;
+        }
+        // Цель игрока - первое существо после него в списке
+        const size_t firstUnit = static_cast<size_t>(
+            std::find(types.begin() + 1, types.end(), ObjectType::Unit) - types.begin());
+        put(descriptors, ObjectOffsets::TARGET, PLAYER_GUID + firstUnit);
+
+        out() << "entity-refresh: " << COUNT << " objects (" << UNITS << " units incl. player, " << ITEMS
+              << " items, " << GAME_OBJECTS << " game objects), " << ticks << " ticks" << Qt::endl;
+
+        {
+            ObjectWalker walker;
+            EntityTable  table;
+            size_t       reads = 0;
+            size_t       bytes = 0;
+            for (uint32_t tick = 0; tick < ticks; tick++)
+            {
+                memory.BeginTick();
+                walker.walk(memory, WalkDetail::Full);
+                table.sync(walker.objects());
+                // Первый обход читает список последовательно; в среднее идёт установившийся режим
+                reads += tick > 0 ? walker.stats().reads : 0;
+                bytes += tick > 0 ? walker.stats().bytes : 0;
+            }
+            out() << "  full walk:       " << reads / (ticks - 1) << " reads per tick, " << bytes / (ticks - 1)
+                  << " batch bytes per tick, " << table.size() << " entities" << Qt::endl;
+        }
+
+        {
+            ObjectWalker   walker;
+            EntityTable    table;
+            SpatialGrid    grid;
+            RefreshPlanner planner;
+            size_t         reads = 0;
+            size_t         bytes = 0;
+            size_t         hot   = 0;
+            for (uint32_t tick = 0; tick < ticks; tick++)
+            {
+                memory.BeginTick();
+                planner.tick(memory, walker, table, grid);
+                reads += tick > 0 ? planner.stats().reads : 0;
+                bytes += tick > 0 ? planner.stats().bytes : 0;
+                hot   += tick > 0 ? planner.stats().hot : 0;
+            }
+            out() << "  refresh planner: " << reads / (ticks - 1) << " reads per tick, " << bytes / (ticks - 1)
+                  << " batch bytes per tick, " << table.size() << " entities, " << hot / (ticks - 1)
+                  << " hot per tick, " << planner.stats().walks << " walks" << Qt::endl;
+        }
+    }
+
+    /**
+     * @brief Поиск, добавление и удаление GUID при смене объектов: GuidMap против QMap и std::unordered_map
+     * @details Модель мира: за симулированную секунду исчезает и появляется около 10% объектов, численность
+     * плавно меняется от 2000 до 4000 и обратно, каждый из 10 тиков секунды ищет все живые GUID в случайном
+     * порядке. GUID - как у существ клиента (тип в старших битах, растущий счётчик в младших). Одна и та же
+     * последовательность операций проигрывается для каждого контейнера; GuidMap и unordered_map резервируются
+     * один раз под 4096 элементов.
+     */
+    void benchGuidMap(const BenchOptions& options)
+    {
+        constexpr size_t   MIN_POPULATION   = 2000;
+        constexpr size_t   MAX_POPULATION   = 4000;
+        constexpr size_t   CAPACITY         = 4096;
+        constexpr uint32_t TICKS_PER_SECOND = 10;
+        constexpr uint32_t PERIOD           = 120; // Секунд на цикл 2000 -> 4000 -> 2000
+
+        const uint32_t seconds = valueOr<uint32_t>(options.iterations, 240);
+
+        // Расписание операций: по секундам - удаления, добавления, затем поиски
+        struct Second
+        {
+            size_t erases;
+            size_t inserts;
+            size_t lookups;
+        };
+        std::vector<Second>   schedule;
+        std::vector<uint64_t> initial, erases, inserts, lookups;
+
+        uint64_t   state   = 0x6A1D;
+        const auto next    = [&state]()
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<uint32_t>(state >> 32);
+        };
+        uint64_t   counter = 0;
+        const auto spawn   = [&]() { return 0xF130000000000000ULL | (uint64_t{next() % 40000} << 24) | ++counter; };
+
+        std::vector<uint64_t> live;
+        for (size_t i = 0; i < MIN_POPULATION; i++)
+        {
+            live.push_back(spawn());
+        }
+        initial = live;
+
+        for (uint32_t second = 0; second < seconds; second++)
+        {
+            const uint32_t phase  = second % PERIOD;
+            const uint32_t rising = phase < PERIOD / 2 ? phase : PERIOD - phase;
+            const size_t   wanted = MIN_POPULATION + (MAX_POPULATION - MIN_POPULATION) * rising / (PERIOD / 2);
+
+            Second step{};
+            step.erases = live.size() / 10;
+            for (size_t i = 0; i < step.erases; i++)
+            {
+                const size_t victim = next() % live.size();
+                erases.push_back(live[victim]);
+                live[victim] = live.back();
+                live.pop_back();
+            }
+            step.inserts = wanted - live.size();
+            for (size_t i = 0; i < step.inserts; i++)
+            {
+                live.push_back(spawn());
+                inserts.push_back(live.back());
+            }
+            step.lookups = live.size() * TICKS_PER_SECOND;
+            for (uint32_t tick = 0; tick < TICKS_PER_SECOND; tick++)
+            {
+                for (size_t i = 0; i < live.size(); i++)
+                {
+                    lookups.push_back(live[next() % live.size()]);
+                }
+            }
+            schedule.push_back(step);
+        }
+
+        out() << "guid-map: " << MIN_POPULATION << "-" << MAX_POPULATION << " GUIDs, ~10% spawn/despawn per second, "
+              << seconds << " seconds (" << lookups.size() << " lookups, " << inserts.size() << " inserts, "
+              << erases.size() << " erases)" << Qt::endl;
+
+        // Проигрывает расписание: map.find(guid) -> строка или INVALID_ENTITY, insert(guid, row), erase(guid)
+        const auto replay = [&](const char* name, auto& map, auto find, auto insert, auto erase)
+        {
+            EntityIndex row = 0;
+            for (const uint64_t guid : initial)
+            {
+                insert(map, guid, row++);
+            }
+
+            qint64        lookupTime = 0;
+            qint64        insertTime = 0;
+            qint64        eraseTime  = 0;
+            size_t        misses     = 0;
+            size_t        e          = 0;
+            size_t        n          = 0;
+            size_t        l          = 0;
+            QElapsedTimer timer;
+            for (const Second& step : schedule)
+            {
+                timer.start();
+                for (const size_t end = e + step.erases; e < end; e++)
+                {
+                    erase(map, erases[e]);
+                }
+                eraseTime += timer.nsecsElapsed();
+
+                timer.start();
+                for (const size_t end = n + step.inserts; n < end; n++)
+                {
+                    insert(map, inserts[n], row++);
+                }
+                insertTime += timer.nsecsElapsed();
+
+                timer.start();
+                for (const size_t end = l + step.lookups; l < end; l++)
+                {
+                    misses += find(map, lookups[l]) == INVALID_ENTITY;
+                }
+                lookupTime += timer.nsecsElapsed();
+            }
+
+            const auto perOp = [](qint64 elapsed, size_t count)
+            {
+                const double ops = static_cast<double>(std::max<size_t>(count, 1));
+                return QString::number(static_cast<double>(elapsed) / ops, 'f', 1);
+            };
+            out() << "  " << name << ": lookup " << perOp(lookupTime, lookups.size()) << " ns, insert "
+                  << perOp(insertTime, inserts.size()) << " ns, erase " << perOp(eraseTime, erases.size())
+                  << " ns per op" << (misses ? ", LOOKUP MISSES" : "");
+        };
+
+        {
+            GuidMap<EntityIndex> map(CAPACITY);
+            replay(
+                "GuidMap           ", map,
+                [](const GuidMap<EntityIndex>& m, uint64_t guid)
+                {
+                    const EntityIndex* found = m.find(guid);
+                    return found ? *found : INVALID_ENTITY;
+                },
+                [](GuidMap<EntityIndex>& m, uint64_t guid, EntityIndex row) { m.assign(guid, row); },
+                [](GuidMap<EntityIndex>& m, uint64_t guid) { m.erase(guid); });
+            out() << ", " << map.rehashes() << " rehashes, " << map.capacity() << " slots" << Qt::endl;
+        }
+
+        {
+            std::unordered_map<uint64_t, EntityIndex> map;
+            map.reserve(CAPACITY);
+            replay(
+                "std::unordered_map", map,
+                [](const std::unordered_map<uint64_t, EntityIndex>& m, uint64_t guid)
+                {
+                    const auto found = m.find(guid);
+                    return found != m.end() ? found->second : INVALID_ENTITY;
+                },
+                [](std::unordered_map<uint64_t, EntityIndex>& m, uint64_t guid, EntityIndex row) { m[guid] = row; },
+                [](std::unordered_map<uint64_t, EntityIndex>& m, uint64_t guid) { m.erase(guid); });
+            out() << Qt::endl;
+        }
+
+        {
+            QMap<uint64_t, EntityIndex> map;
+            replay(
+                "QMap              ", map,
+                [](const QMap<uint64_t, EntityIndex>& m, uint64_t guid) { return m.value(guid, INVALID_ENTITY); },
+                [](QMap<uint64_t, EntityIndex>& m, uint64_t guid, EntityIndex row) { m.insert(guid, row); },
+                [](QMap<uint64_t, EntityIndex>& m, uint64_t guid) { m.remove(guid); });
+            out() << Qt::endl;
+        }
+    }
+
+    const BenchCase CASES[] = {
+        {"read-cache", "Per-tick page cache: backend reads with and without the cache", benchReadCache},
+        {"pattern-scan", "Masked signature scan over a synthetic image per SIMD level", benchPatternScan},
+        {"parallel-scan", "Region-sharded pattern scan scaling by thread count", benchParallelScan},
+        {"pointer-chain", "PointerChain reads per resolution with and without cached links", benchPointerChain},
+        {"try-read", "Throwing Read<T> against TryRead<T> at a 10% failure rate", benchTryRead},
+        {"value-scan", "u32 exact/unknown first scans and next scans over 1 GiB", benchValueScan},
+        {"pointer-scan", "Pointer index build and depth 3/4 path search over 1 GiB", benchPointerScan},
+        {"entity-scan", "Radius query over 2000 entities: table columns against snapshot structs", benchEntityScan},
+        {"entity-refresh", "Per-tick reads of a full object walk against RefreshPlanner", benchEntityRefresh},
+        {"guid-map", "GUID lookup/insert/erase under churn: GuidMap against QMap and std::unordered_map", benchGuidMap},
+    };
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("mdbot_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs memory subsystem benchmarks against a synthetic in-process target");
+    parser.addHelpOption();
+
+    const QCommandLineOption caseOption("case", "Benchmark to run (repeatable, default - all).", "name");
+    const QCommandLineOption listOption("list", "List benchmarks.");
+    const QCommandLineOption sizeOption("size", "Synthetic memory size in MiB.", "mib");
+    const QCommandLineOption iterationsOption("iterations", "Iterations or ticks.", "count");
+    const QCommandLineOption threadsOption("threads", "Worker threads (0 - all cores).", "count");
+    parser.addOptions({caseOption, listOption, sizeOption, iterationsOption, threadsOption});
+    parser.process(app);
+
+    if (parser.isSet(listOption))
+    {
+        for (const BenchCase& bench : CASES)
+        {
+            out() << bench.name << " - " << bench.description << Qt::endl;
+        }
+        return 0;
+    }
+
+    BenchOptions options;
+    options.size       = static_cast<size_t>(parser.value(sizeOption).toULongLong()) << 20;
+    options.iterations = parser.value(iterationsOption).toUInt();
+    options.threads    = parser.value(threadsOption).toUInt();
+
+    const QStringList selected = parser.values(caseOption);
+    for (const QString& name : selected)
+    {
+        const auto matches = [&](const BenchCase& bench) { return name == bench.name; };
+        if (std::none_of(std::begin(CASES), std::end(CASES), matches))
+        {
+            out() << "Unknown benchmark: " << name << Qt::endl;
+            return 1;
+        }
+    }
+
+    for (const BenchCase& bench : CASES)
+    {
+        if (selected.isEmpty() || selected.contains(bench.name))
+        {
+            bench.run(options);
+        }
+    }
+    return 0;
+}
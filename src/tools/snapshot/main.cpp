@@ -0,0 +1,205 @@
+/**
+ * @file main.cpp
+ * @brief Утилита снятия снимков памяти клиента WoW
+ * @details Примеры:
+ * @code
+ * mdbot_snapshot --pid 1234 --output run.dump --module run.exe
+ * mdbot_snapshot --pid 1234 --output full.dump --compress
+ * mdbot_snapshot --info run.dump
+ * @endcode
+ * Снимок открывается MemoryManager через DumpFileBackend и читается теми же путями,
+ * что и живой процесс: поиск сигнатур, разбор структур, профилирование логики бота.
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+#include <algorithm>
+
+#include "core/memory/MemoryManager.hpp"
+#include "core/memory/snapshot/DumpWriter.hpp"
+
+
+namespace
+{
+    QTextStream& out()
+    {
+        static QTextStream stream(stdout);
+        return stream;
+    }
+
+    /**
+     * @brief Разбирает диапазон вида "0x400000-0x800000"
+     */
+    bool parseRange(const QString& text, uintptr_t& start, uintptr_t& end)
+    {
+        const QStringList parts = text.split('-');
+        if (parts.size() != 2)
+        {
+            return false;
+        }
+
+        bool startOk = false;
+        bool endOk   = false;
+        start        = static_cast<uintptr_t>(parts[0].toULongLong(&startOk, 0));
+        end          = static_cast<uintptr_t>(parts[1].toULongLong(&endOk, 0));
+        return startOk && endOk && start < end;
+    }
+
+    /**
+     * @brief Выводит содержимое снимка
+     */
+    int printInfo(const QString& filePath)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        DumpFileBackend backend(filePath.toStdString());
+        if (!backend.isOpen())
+        {
+            out() << "Cannot open snapshot: " << QString::fromStdString(backend.error()) << Qt::endl;
+            return 1;
+        }
+        const qint64 openTime = timer.elapsed();
+
+        MemoryManager memory{MemoryBackend(std::move(backend))};
+        out() << "Opened in " << openTime << " ms, process " << memory.GetProcessId() << Qt::endl;
+
+        for (const auto& module : memory.GetModules())
+        {
+            out() << "Module " << QString::fromStdWString(module.name) << " at 0x" << QString::number(module.base, 16)
+                  << " size 0x" << QString::number(module.size, 16) << Qt::endl;
+        }
+
+        uint64_t total = 0;
+        for (const auto& region : memory.EnumerateRegions())
+        {
+            total += region.size;
+            out() << "Region 0x" << QString::number(region.base, 16) << " size 0x" << QString::number(region.size, 16)
+                  << " protection 0x" << QString::number(region.protection, 16) << Qt::endl;
+        }
+        out() << "Total " << total << " bytes" << Qt::endl;
+        return 0;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("mdbot_snapshot");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Captures memory of a running client into a snapshot file");
+    parser.addHelpOption();
+
+    const QCommandLineOption pidOption("pid", "Process ID to capture.", "pid");
+    const QCommandLineOption outputOption("output", "Snapshot file to write.", "file");
+    const QCommandLineOption moduleOption("module", "Capture the image of a module (repeatable).", "name");
+    const QCommandLineOption rangeOption("range", "Capture an address range start-end (repeatable).", "range");
+    const QCommandLineOption compressOption("compress", "Compress blocks that shrink.");
+    const QCommandLineOption blockSizeOption("block-size", "Block size in bytes (multiple of 4096).", "bytes");
+    const QCommandLineOption infoOption("info", "Print the contents of a snapshot file.", "file");
+    parser.addOptions(
+        {pidOption, outputOption, moduleOption, rangeOption, compressOption, blockSizeOption, infoOption});
+    parser.process(app);
+
+    if (parser.isSet(infoOption))
+    {
+        return printInfo(parser.value(infoOption));
+    }
+
+    if (!parser.isSet(pidOption) || !parser.isSet(outputOption))
+    {
+        parser.showHelp(1);
+    }
+
+    try
+    {
+        MemoryManager memory(static_cast<DWORD>(parser.value(pidOption).toULong()));
+
+        // Без --module/--range снимается вся читаемая память процесса
+        std::vector<MemoryRegion> regions;
+        for (const QString& name : parser.values(moduleOption))
+        {
+            ModuleInfo module;
+            if (!memory.GetModuleInfo(name.toStdWString().c_str(), module))
+            {
+                out() << "Module not found: " << name << Qt::endl;
+                return 1;
+            }
+            const auto moduleRegions = memory.EnumerateRegions(module.base, module.base + module.size);
+            regions.insert(regions.end(), moduleRegions.begin(), moduleRegions.end());
+        }
+        for (const QString& text : parser.values(rangeOption))
+        {
+            uintptr_t start = 0;
+            uintptr_t end   = 0;
+            if (!parseRange(text, start, end))
+            {
+                out() << "Invalid range: " << text << Qt::endl;
+                return 1;
+            }
+            const auto rangeRegions = memory.EnumerateRegions(start, end);
+            regions.insert(regions.end(), rangeRegions.begin(), rangeRegions.end());
+        }
+        if (!parser.isSet(moduleOption) && !parser.isSet(rangeOption))
+        {
+            regions = memory.EnumerateRegions();
+        }
+
+        // Регионы могут пересекаться: EnumerateRegions возвращает регионы целиком, и они начинаются раньше
+        // запрошенного диапазона (модуль внутри диапазона, соседние --range). Файл дампа требует
+        // непересекающихся регионов, поэтому каждый регион обрезается по концу предыдущего
+        std::sort(regions.begin(),
+                  regions.end(),
+                  [](const MemoryRegion& left, const MemoryRegion& right) { return left.base < right.base; });
+
+        std::vector<MemoryRegion> disjoint;
+        disjoint.reserve(regions.size());
+        for (MemoryRegion region : regions)
+        {
+            if (!disjoint.empty() && region.base < disjoint.back().end())
+            {
+                const uintptr_t covered = disjoint.back().end();
+                if (region.end() <= covered)
+                {
+                    continue;
+                }
+                region.size = region.end() - covered;
+                region.base = covered;
+            }
+            disjoint.push_back(region);
+        }
+        regions = std::move(disjoint);
+
+        DumpOptions options;
+        options.compress = parser.isSet(compressOption);
+        if (parser.isSet(blockSizeOption))
+        {
+            options.blockSize = parser.value(blockSizeOption).toUInt();
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        DumpWriter writer(options);
+        if (!writer.capture(memory, regions, parser.value(outputOption)))
+        {
+            out() << "Capture failed: " << writer.error() << Qt::endl;
+            return 1;
+        }
+
+        const DumpStats& stats = writer.stats();
+        out() << "Captured " << stats.bytesCaptured << " bytes in " << stats.regions << " regions ("
+              << stats.blocks << " blocks, " << stats.compressedBlocks << " compressed, " << stats.unreadablePages
+              << " unreadable pages) into " << stats.fileSize << " bytes in " << timer.elapsed() << " ms"
+              << Qt::endl;
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        out() << "Error: " << e.what() << Qt::endl;
+        return 1;
+    }
+}